@@ -0,0 +1,124 @@
+"""
+Actor listing cost: full get_actors_in_level vs projected, paginated and streamed listings.
+
+Reports the game-thread time the server spent building each listing (its
+game_thread_ms), normalized per 10k actors, along with the response size and the
+client-observed wall time. Use --spawn to add throwaway actors first so the level
+is large enough to measure; they are deleted again at the end.
+
+Usage:
+    python bench_actor_listing.py [--spawn 10000] [--page-size 1000] [--repeat 3]
+"""
+
+import argparse
+import json
+import sys
+from typing import Any, Callable, Dict, List, Tuple
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+
+SPAWN_BATCH = 500
+SPAWN_PREFIX = "BenchListingActor_"
+
+
+def run_batch(conn: BenchConnection, commands: List[Dict[str, Any]]):
+    response = conn.command("batch", {"commands": commands, "continue_on_error": True})
+    if response.get("status") != "success":
+        raise RuntimeError(f"batch failed: {response}")
+
+
+def spawn_actors(conn: BenchConnection, count: int, actor_type: str = "Actor"):
+    for first in range(0, count, SPAWN_BATCH):
+        run_batch(conn, [
+            {"type": "create_actor", "params": {"type": actor_type, "name": f"{SPAWN_PREFIX}{i}", "location": [i * 10.0, 0.0, 0.0]}}
+            for i in range(first, min(first + SPAWN_BATCH, count))
+        ])
+
+
+def delete_actors(conn: BenchConnection, count: int):
+    for first in range(0, count, SPAWN_BATCH):
+        run_batch(conn, [
+            {"type": "delete_actor", "params": {"name": f"{SPAWN_PREFIX}{i}"}}
+            for i in range(first, min(first + SPAWN_BATCH, count))
+        ])
+
+
+def list_once(conn: BenchConnection, params: Dict[str, Any]) -> Tuple[int, float, int]:
+    """Single get_actors_in_level call, following next_cursor when paginating."""
+    actors = 0
+    game_thread_ms = 0.0
+    size = 0
+    params = dict(params)
+    while True:
+        response = conn.command("get_actors_in_level", params)
+        if response.get("status") != "success":
+            raise RuntimeError(f"get_actors_in_level failed: {response}")
+        result = response["result"]
+        actors += result["count"]
+        game_thread_ms += result.get("game_thread_ms", 0.0)
+        size += len(json.dumps(response))
+        if "next_cursor" not in result:
+            return actors, game_thread_ms, size
+        params["cursor"] = result["next_cursor"]
+
+
+def stream_once(conn: BenchConnection, params: Dict[str, Any]) -> Tuple[int, float, int]:
+    size = 0
+    final: Dict[str, Any] = {}
+    for response in conn.stream("stream_actors_in_level", params):
+        size += len(json.dumps(response))
+        final = response
+    if final.get("status") != "success":
+        raise RuntimeError(f"stream_actors_in_level failed: {final}")
+    return final["result"]["count"], final["result"]["game_thread_ms"], size
+
+
+def run_mode(name: str, repeat: int, fn: Callable[[], Tuple[int, float, int]]) -> bool:
+    walls: List[float] = []
+    game_thread: List[float] = []
+    actors = 0
+    size = 0
+    try:
+        for _ in range(repeat):
+            start = now_ms()
+            actors, gt_ms, size = fn()
+            walls.append(now_ms() - start)
+            game_thread.append(gt_ms)
+    except Exception as e:
+        print(f"{name:>10}: error: {e}")
+        return False
+
+    per_10k = percentile(game_thread, 50) * 10000.0 / actors if actors else 0.0
+    print(f"{name:>10}: actors={actors:7d}  game_thread={percentile(game_thread, 50):8.2f} ms  "
+          f"per_10k={per_10k:8.2f} ms  size={size / 1024.0:9.1f} KiB  wall={percentile(walls, 50):9.1f} ms")
+    return True
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--spawn", type=int, default=0, help="temporary actors to add before measuring")
+    parser.add_argument("--page-size", type=int, default=1000)
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    conn = BenchConnection(timeout=120.0)
+    ok = False
+    try:
+        if args.spawn:
+            spawn_actors(conn, args.spawn)
+
+        slim = {"fields": ["name", "class"]}
+        paged = {**slim, "limit": args.page_size}
+        ok = run_mode("full", args.repeat, lambda: list_once(conn, {}))
+        ok = run_mode("projected", args.repeat, lambda: list_once(conn, slim)) and ok
+        ok = run_mode("paged", args.repeat, lambda: list_once(conn, paged)) and ok
+        ok = run_mode("streamed", args.repeat, lambda: stream_once(conn, paged)) and ok
+    finally:
+        if args.spawn:
+            delete_actors(conn, args.spawn)
+        conn.close()
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
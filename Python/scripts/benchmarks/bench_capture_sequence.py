@@ -0,0 +1,107 @@
+"""
+Camera sweep capture: capture_sequence vs one request per frame.
+
+The per-frame baseline does what clients did before capture_sequence existed:
+set_time_of_day followed by take_screenshot, one round trip each, for every step
+of an Ultra Dynamic Sky time-of-day sweep. The sequence run sends the same sweep
+as a single capture_sequence request and reads each frame as it streams back.
+
+Usage:
+    python bench_capture_sequence.py [--frames 24] [--start 600] [--end 1800]
+                                     [--format jpeg] [--quality 85] [--settle-frames 2]
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+from typing import Any, Dict, List
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+
+
+def sweep(frames: int, start: float, end: float) -> List[float]:
+    if frames == 1:
+        return [start]
+    step = (end - start) / (frames - 1)
+    return [start + step * i for i in range(frames)]
+
+
+def run_per_frame(times: List[float], encoding: Dict[str, Any]) -> bool:
+    conn = BenchConnection()
+    samples: List[float] = []
+    try:
+        with tempfile.TemporaryDirectory() as out_dir:
+            start = now_ms()
+            for index, time_of_day in enumerate(times):
+                frame_start = now_ms()
+                response = conn.command("set_time_of_day", {"time_of_day": time_of_day})
+                if response.get("status") != "success":
+                    raise RuntimeError(f"set_time_of_day failed: {response}")
+                params = {"filepath": os.path.join(out_dir, f"frame_{index}.{encoding['format']}"), **encoding}
+                response = conn.command("take_screenshot", params)
+                if response.get("status") != "success":
+                    raise RuntimeError(f"take_screenshot failed: {response}")
+                samples.append(now_ms() - frame_start)
+            total = now_ms() - start
+    except Exception as e:
+        print(f"{'per-frame':>10}: error: {e}")
+        return False
+    finally:
+        conn.close()
+
+    print(f"{'per-frame':>10}: frames={len(samples):4d}  total={total:9.1f} ms  fps={len(samples) * 1000.0 / total:6.2f}  "
+          f"p50={percentile(samples, 50):8.2f} ms  p99={percentile(samples, 99):8.2f} ms")
+    return True
+
+
+def run_sequence(times: List[float], encoding: Dict[str, Any], settle_frames: int) -> bool:
+    conn = BenchConnection()
+    arrivals: List[float] = []
+    try:
+        params = {"frames": [{"time_of_day": t} for t in times], "settle_frames": settle_frames, **encoding}
+        start = now_ms()
+        final: Dict[str, Any] = {}
+        for response in conn.stream("capture_sequence", params):
+            if response.get("status") == "progress":
+                arrivals.append(now_ms() - start)
+            else:
+                final = response
+        total = now_ms() - start
+        if final.get("status") != "success":
+            raise RuntimeError(f"capture_sequence failed: {final}")
+    except Exception as e:
+        print(f"{'sequence':>10}: error: {e}")
+        return False
+    finally:
+        conn.close()
+
+    result = final["result"]
+    gaps = [b - a for a, b in zip([0.0] + arrivals, arrivals)]
+    print(f"{'sequence':>10}: frames={result['frames_captured']:4d}  total={total:9.1f} ms  fps={result['frames_per_second']:6.2f}  "
+          f"first_frame={arrivals[0] if arrivals else 0:8.2f} ms  p50_gap={percentile(gaps, 50):8.2f} ms")
+    return True
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--frames", type=int, default=24)
+    parser.add_argument("--start", type=float, default=600.0)
+    parser.add_argument("--end", type=float, default=1800.0)
+    parser.add_argument("--format", choices=["png", "jpeg", "webp"], default="jpeg")
+    parser.add_argument("--quality", type=int)
+    parser.add_argument("--settle-frames", type=int, default=2)
+    args = parser.parse_args()
+
+    encoding: Dict[str, Any] = {"format": args.format}
+    if args.quality is not None:
+        encoding["quality"] = args.quality
+
+    times = sweep(args.frames, args.start, args.end)
+    ok = run_per_frame(times, encoding)
+    ok = run_sequence(times, encoding, args.settle_frames) and ok
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,111 @@
+"""
+Keeping a client in sync with the sky: polling get_ultra_dynamic_sky vs a subscribe change feed.
+
+A driver connection sweeps Ultra Dynamic Sky's time of day with one animate_property
+request. While it runs, the poller asks for the sky state back to back, and the
+subscriber receives the per-frame notifications the server pushes. Both report how
+many messages and bytes it took, and how many distinct values they saw.
+
+Usage:
+    python bench_change_feed.py [--duration 5] [--min-interval 0]
+"""
+
+import argparse
+import json
+import socket
+import sys
+import time
+from typing import Any, Dict, Set
+
+from mcp_bench_client import BenchConnection
+
+SKY_CLASS = "Ultra_Dynamic_Sky_C"
+TIME_OF_DAY = "Time of Day"
+
+
+def start_sweep(duration: float) -> Dict[str, Any]:
+    conn = BenchConnection()
+    try:
+        response = conn.command("animate_property", {"property": "time_of_day", "from": 0, "to": 2400,
+                                                     "duration": duration, "easing": "linear"})
+    finally:
+        conn.close()
+    if response.get("status") != "success":
+        raise RuntimeError(f"animate_property failed: {response}")
+    return response["result"]
+
+
+def report(label: str, messages: int, size: int, values: Set[float], duration: float):
+    per_value = size / len(values) if values else 0.0
+    print(f"{label:>10}: messages={messages:6d} ({messages / duration:7.1f}/s)  bytes={size:9d}  "
+          f"distinct values={len(values):5d}  bytes/value={per_value:8.1f}")
+
+
+def run_poll(duration: float):
+    conn = BenchConnection()
+    messages, size, values = 0, 0, set()
+    try:
+        start_sweep(duration)
+        deadline = time.monotonic() + duration
+        while time.monotonic() < deadline:
+            response = conn.command("get_ultra_dynamic_sky")
+            messages += 1
+            size += len(json.dumps(response))
+            if response.get("status") == "success":
+                values.add(response["result"]["time_of_day"])
+    finally:
+        conn.close()
+    report("poll", messages, size, values, duration)
+
+
+def run_subscribe(duration: float, min_interval: float):
+    conn = BenchConnection()
+    messages, size, values = 0, 0, set()
+    try:
+        params = {"actor_class": SKY_CLASS, "properties": [TIME_OF_DAY], "transform": False, "min_interval": min_interval}
+        ack = next(conn.stream("subscribe", params, request_id=1))
+        if ack.get("status") != "success":
+            raise RuntimeError(f"subscribe failed: {ack}")
+        subscription_id = ack["result"]["subscription_id"]
+
+        start_sweep(duration)
+        deadline = time.monotonic() + duration
+        while time.monotonic() < deadline:
+            conn.sock.settimeout(max(0.01, deadline - time.monotonic()))
+            try:
+                notification = conn.recv_response()
+            except socket.timeout:
+                break
+            messages += 1
+            size += len(json.dumps(notification))
+            for change in notification.get("result", {}).get("changes", []):
+                if TIME_OF_DAY in change.get("properties", {}):
+                    values.add(change["properties"][TIME_OF_DAY])
+
+        # Notifications may still be in flight ahead of the unsubscribe reply
+        conn.sock.settimeout(30.0)
+        conn.send_raw(conn.encode({"type": "unsubscribe", "params": {"subscription_id": subscription_id}, "id": 2}))
+        while conn.recv_response().get("id") != 2:
+            pass
+    finally:
+        conn.close()
+    report("subscribe", messages, size, values, duration)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--duration", type=float, default=5.0, help="seconds each sweep runs")
+    parser.add_argument("--min-interval", type=float, default=0.0, help="subscription throttle in seconds")
+    args = parser.parse_args()
+
+    try:
+        run_poll(args.duration)
+        run_subscribe(args.duration, args.min_interval)
+    except Exception as e:
+        print(f"error: {e}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,87 @@
+"""
+Response compression: get_actors_in_level uncompressed vs LZ4 vs zlib.
+
+Each codec gets its own length-prefixed connection negotiated with set_framing.
+Reports the bytes that crossed the socket, the client-observed wall time and, from
+get_connection_stats, the server's compression ratio and the time it spent
+compressing, so the threshold can be tuned. Use --spawn to add throwaway actors
+first so the level is large enough to measure; they are deleted again at the end.
+
+Usage:
+    python bench_compression.py [--spawn 10000] [--threshold 16384] [--repeat 5]
+"""
+
+import argparse
+import sys
+from typing import Any, Dict
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+from bench_actor_listing import delete_actors, spawn_actors
+
+CODECS = ("none", "lz4", "zlib")
+
+
+def measure(codec: str, threshold: int, repeat: int) -> Dict[str, Any]:
+    conn = BenchConnection()
+    try:
+        response = conn.set_framing("length_prefixed", compression=codec, compression_threshold=threshold)
+        if response.get("status") != "success":
+            raise RuntimeError(f"set_framing failed: {response}")
+
+        wire, wall = [], []
+        payload_size = 0
+        for _ in range(repeat):
+            received = conn.bytes_received
+            start = now_ms()
+            conn.send_raw(conn.encode({"type": "get_actors_in_level", "params": {}}))
+            payload = conn.recv_payload()
+            wall.append(now_ms() - start)
+            wire.append(conn.bytes_received - received)
+            payload_size = len(payload)
+            if conn.loads(payload).get("status") != "success":
+                raise RuntimeError("get_actors_in_level failed")
+
+        stats = conn.command("get_connection_stats")
+        if stats.get("status") != "success":
+            raise RuntimeError(f"get_connection_stats failed: {stats}")
+        return {"payload": payload_size, "wire": wire, "wall": wall, "compression": stats["result"]["compression"]}
+    finally:
+        conn.close()
+
+
+def report(codec: str, result: Dict[str, Any]):
+    compression = result["compression"]
+    per_message_ms = compression["compress_ms"] / max(1, compression["messages_compressed"])
+    print(f"{codec:>5}: payload={result['payload']:10d}  wire p50={percentile(result['wire'], 50):10.0f}  "
+          f"wall_ms p50={percentile(result['wall'], 50):8.2f}  ratio={compression['ratio']:5.2f}  "
+          f"compress_ms/msg={per_message_ms:7.2f}  MB/s={compression['mb_per_s']:8.1f}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--spawn", type=int, default=0, help="throwaway actors to add before measuring")
+    parser.add_argument("--threshold", type=int, default=16384, help="smallest response compressed, in bytes")
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    conn = BenchConnection()
+    try:
+        if args.spawn:
+            spawn_actors(conn, args.spawn)
+
+        for codec in CODECS:
+            report(codec, measure(codec, args.threshold, args.repeat))
+    except Exception as e:
+        print(f"error: {e}")
+        return 1
+    finally:
+        try:
+            if args.spawn:
+                delete_actors(conn, args.spawn)
+        finally:
+            conn.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,126 @@
+"""
+Large response delivery: multi-byte UTF-8 listings under short socket writes.
+
+Spawns throwaway actors whose names mix Hangul, accented Latin and 4-byte emoji,
+lists them with get_actors_in_level in every framing mode and checks each name
+comes back intact, so a truncated or mis-sized frame shows up as a failure rather
+than a parse error later. With --slow-reader the client drains its socket in small
+sleeps, which fills the editor's send buffer and makes it resume short writes.
+Reports size, wall time and throughput per mode, plus the connection's send
+counters (writes, partial writes, waits on a full socket). The actors are deleted
+again at the end.
+
+Usage:
+    python bench_large_response.py [--spawn 5000] [--repeat 3] [--slow-reader 2]
+"""
+
+import argparse
+import sys
+import time
+from typing import Any, Dict, List
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+from bench_actor_listing import SPAWN_BATCH, run_batch
+
+MODES = ("json", "newline", "length_prefixed")
+NAME_PREFIX = "BenchUtf8_한글_Ünïcødé_🎬_"
+
+
+def spawn_named(conn: BenchConnection, count: int):
+    for first in range(0, count, SPAWN_BATCH):
+        run_batch(conn, [
+            {"type": "create_actor", "params": {"type": "Actor", "name": f"{NAME_PREFIX}{i}", "location": [i * 10.0, 0.0, 0.0]}}
+            for i in range(first, min(first + SPAWN_BATCH, count))
+        ])
+
+
+def delete_named(conn: BenchConnection, count: int):
+    for first in range(0, count, SPAWN_BATCH):
+        run_batch(conn, [
+            {"type": "delete_actor", "params": {"name": f"{NAME_PREFIX}{i}"}}
+            for i in range(first, min(first + SPAWN_BATCH, count))
+        ])
+
+
+def throttle(conn: BenchConnection, delay_ms: float):
+    """Make the connection read at most 4 KB per recv with a pause before each one."""
+    def recv_slowly():
+        time.sleep(delay_ms / 1000.0)
+        chunk = conn.sock.recv(4096)
+        if not chunk:
+            raise ConnectionError("Connection closed by Unreal")
+        conn.bytes_received += len(chunk)
+        conn._pending += chunk
+    conn._recv_more = recv_slowly
+
+
+def measure(mode: str, spawned: int, repeat: int, slow_reader: float) -> Dict[str, Any]:
+    conn = BenchConnection(timeout=120.0)
+    walls: List[float] = []
+    sizes: List[int] = []
+    try:
+        if mode != "json":
+            response = conn.set_framing(mode)
+            if response.get("status") != "success":
+                raise RuntimeError(f"set_framing failed: {response}")
+        if slow_reader > 0:
+            throttle(conn, slow_reader)
+
+        expected = {f"{NAME_PREFIX}{i}" for i in range(spawned)}
+        for _ in range(repeat):
+            received = conn.bytes_received
+            start = now_ms()
+            response = conn.command("get_actors_in_level", {})
+            walls.append(now_ms() - start)
+            sizes.append(conn.bytes_received - received)
+            if response.get("status") != "success":
+                raise RuntimeError(f"get_actors_in_level failed: {response}")
+
+            names = {actor.get("name") for actor in response["result"]["actors"]}
+            missing = expected - names
+            if missing:
+                raise RuntimeError(f"{mode}: {len(missing)} multi-byte names missing or mangled, e.g. {sorted(missing)[0]!r}")
+
+        stats = conn.command("get_connection_stats")
+        if stats.get("status") != "success":
+            raise RuntimeError(f"get_connection_stats failed: {stats}")
+        return {"wall_ms": walls, "bytes": sizes, "send": stats["result"].get("send", {})}
+    finally:
+        conn.close()
+
+
+def report(mode: str, result: Dict[str, Any]):
+    wall = percentile(result["wall_ms"], 50)
+    size = percentile(result["bytes"], 50)
+    send = result["send"]
+    print(f"{mode:>15}: bytes={size:10.0f}  wall_ms p50={wall:8.1f}  MB/s={size / (1024.0 * 1024.0) / max(wall / 1000.0, 1e-9):7.1f}  "
+          f"writes={send.get('writes', 0):6.0f}  partial={send.get('partial_writes', 0):6.0f}  "
+          f"waits={send.get('would_block_waits', 0):6.0f}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--spawn", type=int, default=5000, help="throwaway actors with multi-byte names")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--slow-reader", type=float, default=0.0, help="ms to pause before each 4 KB read")
+    args = parser.parse_args()
+
+    conn = BenchConnection()
+    try:
+        spawn_named(conn, args.spawn)
+        for mode in MODES:
+            report(mode, measure(mode, args.spawn, args.repeat, args.slow_reader))
+        print("all multi-byte names round-tripped intact")
+    except Exception as e:
+        print(f"error: {e}")
+        return 1
+    finally:
+        try:
+            delete_named(conn, args.spawn)
+        finally:
+            conn.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,102 @@
+"""
+Same-host transports: TCP loopback vs Unix domain socket vs Unix socket plus shared-memory ring.
+
+Each transport gets its own length-prefixed connection and fetches the same large
+response (get_actors_in_level by default, a scene dump) repeatedly. Reports the payload
+size, client-observed wall time and effective throughput. With the ring, payloads above
+its threshold are copied through shared memory and only a 16-byte descriptor crosses
+the socket. Use --spawn to add throwaway actors first; they are deleted again at the end.
+
+Unix domain sockets and the ring need Unreal on this machine (the socket is not
+available on Windows).
+
+Usage:
+    python bench_local_transport.py [--spawn 10000] [--repeat 10] [--ring-size 67108864]
+"""
+
+import argparse
+import os
+import sys
+from typing import Any, Dict, List
+
+from mcp_bench_client import UNREAL_UNIX_SOCKET, BenchConnection, now_ms, percentile
+from bench_actor_listing import delete_actors, spawn_actors
+
+
+def open_connection(transport: str, ring_size: int) -> BenchConnection:
+    conn = BenchConnection(unix_path=UNREAL_UNIX_SOCKET if transport != "tcp" else None)
+    response = conn.set_framing("length_prefixed")
+    if response.get("status") != "success":
+        raise RuntimeError(f"set_framing failed: {response}")
+    if transport == "unix+ring":
+        response = conn.open_shared_ring(ring_size)
+        if response.get("status") != "success":
+            raise RuntimeError(f"open_shared_ring failed: {response}")
+    return conn
+
+
+def measure(transport: str, command: str, repeat: int, ring_size: int) -> Dict[str, Any]:
+    conn = open_connection(transport, ring_size)
+    wall: List[float] = []
+    size = 0
+    try:
+        for _ in range(repeat):
+            start = now_ms()
+            conn.send_raw(conn.encode({"type": command, "params": {}}))
+            payload = conn.recv_payload()
+            wall.append(now_ms() - start)
+            size = len(payload)
+            if conn.loads(payload).get("status") != "success":
+                raise RuntimeError(f"{command} failed")
+
+        stats = conn.command("get_connection_stats")["result"]
+        return {"size": size, "wall": wall, "ring": stats.get("shared_ring")}
+    finally:
+        conn.close()
+
+
+def report(transport: str, result: Dict[str, Any]):
+    wall_p50 = percentile(result["wall"], 50)
+    throughput = result["size"] / (1024.0 * 1024.0) / max(wall_p50 / 1000.0, 1e-9)
+    line = (f"{transport:>10}: bytes={result['size']:10d}  wall_ms p50={wall_p50:8.2f}  "
+            f"p99={percentile(result['wall'], 99):8.2f}  MB/s={throughput:8.1f}")
+    if result["ring"]:
+        line += f"  ring writes={result['ring']['writes']} fallbacks={result['ring']['fallbacks']}"
+    print(line)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--spawn", type=int, default=0, help="throwaway actors to add before measuring")
+    parser.add_argument("--command", default="get_actors_in_level", help="parameterless command to fetch")
+    parser.add_argument("--repeat", type=int, default=10)
+    parser.add_argument("--ring-size", type=int, default=64 * 1024 * 1024)
+    args = parser.parse_args()
+
+    transports = ["tcp"]
+    if os.path.exists(UNREAL_UNIX_SOCKET):
+        transports += ["unix", "unix+ring"]
+    else:
+        print(f"{UNREAL_UNIX_SOCKET} not found; measuring TCP only")
+
+    conn = BenchConnection()
+    try:
+        if args.spawn:
+            spawn_actors(conn, args.spawn)
+
+        for transport in transports:
+            report(transport, measure(transport, args.command, args.repeat, args.ring_size))
+    except Exception as e:
+        print(f"error: {e}")
+        return 1
+    finally:
+        try:
+            if args.spawn:
+                delete_actors(conn, args.spawn)
+        finally:
+            conn.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
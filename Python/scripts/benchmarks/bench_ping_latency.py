@@ -0,0 +1,85 @@
+"""
+Round-trip latency benchmark for the UnrealMCP `ping` command.
+
+Opens N concurrent client connections (default: 1, 8 and 64), has every client
+send `ping` back to back, and reports p50/p99 round-trip time per concurrency level.
+
+Usage:
+    python bench_ping_latency.py [--clients 1 8 64] [--requests 200] [--reconnect]
+
+With --reconnect every request opens a fresh connection, which also measures
+accept latency (the path the MCP server uses today).
+"""
+
+import argparse
+import sys
+import threading
+from typing import List
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+
+
+def run_client(requests: int, reconnect: bool, samples: List[float], errors: List[str], lock: threading.Lock):
+    local: List[float] = []
+    conn = None
+    try:
+        for _ in range(requests):
+            start = now_ms()
+            if reconnect or conn is None:
+                if conn:
+                    conn.close()
+                conn = BenchConnection()
+            response = conn.command("ping")
+            local.append(now_ms() - start)
+            if response.get("status") != "success":
+                raise RuntimeError(f"Unexpected response: {response}")
+    except Exception as e:
+        with lock:
+            errors.append(str(e))
+    finally:
+        if conn:
+            conn.close()
+        with lock:
+            samples.extend(local)
+
+
+def run_level(clients: int, requests: int, reconnect: bool) -> bool:
+    samples: List[float] = []
+    errors: List[str] = []
+    lock = threading.Lock()
+    threads = [
+        threading.Thread(target=run_client, args=(requests, reconnect, samples, errors, lock))
+        for _ in range(clients)
+    ]
+
+    start = now_ms()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = now_ms() - start
+
+    throughput = len(samples) / (elapsed / 1000.0) if elapsed > 0 else 0.0
+    print(f"clients={clients:3d}  requests={len(samples):6d}  "
+          f"p50={percentile(samples, 50):8.2f} ms  p99={percentile(samples, 99):8.2f} ms  "
+          f"max={max(samples) if samples else 0.0:8.2f} ms  throughput={throughput:8.1f} req/s")
+    for error in errors[:5]:
+        print(f"  error: {error}")
+    return not errors
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--clients", type=int, nargs="+", default=[1, 8, 64])
+    parser.add_argument("--requests", type=int, default=200, help="requests per client")
+    parser.add_argument("--reconnect", action="store_true", help="open a new connection per request")
+    args = parser.parse_args()
+
+    ok = True
+    for clients in args.clients:
+        ok = run_level(clients, args.requests, args.reconnect) and ok
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,88 @@
+"""
+Command throughput with and without request pipelining.
+
+Sequential mode sends one command and waits for its response before sending the
+next (the original protocol). Pipelined mode tags each request with an `id` and
+keeps up to --window requests in flight on one connection, matching responses
+by id as they arrive.
+
+Usage:
+    python bench_pipeline_throughput.py [--command get_ultra_dynamic_sky] [--requests 500] [--window 32]
+"""
+
+import argparse
+import sys
+from typing import Dict
+
+from mcp_bench_client import BenchConnection, now_ms
+
+
+def run_sequential(command: str, requests: int) -> float:
+    conn = BenchConnection()
+    try:
+        start = now_ms()
+        for _ in range(requests):
+            conn.command(command)
+        return now_ms() - start
+    finally:
+        conn.close()
+
+
+def run_pipelined(command: str, requests: int, window: int) -> float:
+    conn = BenchConnection()
+    try:
+        outstanding: Dict[int, float] = {}
+        next_id = 0
+        completed = 0
+        out_of_order = 0
+        last_completed_id = -1
+
+        start = now_ms()
+        while completed < requests:
+            while next_id < requests and len(outstanding) < window:
+                conn.send_raw(conn.encode({"type": command, "params": {}, "id": next_id}))
+                outstanding[next_id] = now_ms()
+                next_id += 1
+
+            response = conn.recv_json()
+            response_id = response.get("id")
+            if response_id not in outstanding:
+                raise RuntimeError(f"Unexpected response id: {response}")
+            del outstanding[response_id]
+            if response_id < last_completed_id:
+                out_of_order += 1
+            last_completed_id = max(last_completed_id, response_id)
+            completed += 1
+        elapsed = now_ms() - start
+
+        if out_of_order:
+            print(f"  {out_of_order} responses completed out of order")
+        return elapsed
+    finally:
+        conn.close()
+
+
+def report(label: str, requests: int, elapsed_ms: float):
+    rate = requests / (elapsed_ms / 1000.0) if elapsed_ms > 0 else 0.0
+    print(f"{label:<22} {requests:6d} commands in {elapsed_ms:9.1f} ms  ->  {rate:9.1f} cmd/s")
+    return rate
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--command", default="get_ultra_dynamic_sky")
+    parser.add_argument("--requests", type=int, default=500)
+    parser.add_argument("--window", type=int, nargs="+", default=[4, 16, 64])
+    args = parser.parse_args()
+
+    print(f"command: {args.command}")
+    baseline = report("sequential", args.requests, run_sequential(args.command, args.requests))
+    for window in args.window:
+        rate = report(f"pipelined (window {window})", args.requests, run_pipelined(args.command, args.requests, window))
+        if baseline > 0:
+            print(f"  speedup: {rate / baseline:.2f}x")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,122 @@
+"""
+Scheduler priority lanes: interactive latency while another client floods heavy work.
+
+--clients connections each keep a batch command running (batch is a heavy command:
+each one runs --batch-size get_actors_in_level calls in a single game-thread task, and
+it counts as a mutation, so a connection only has one in flight). Another connection measures the round trip of a cheap interactive read, first
+on an idle editor and then under that load. Reports p50/p95 latency for both, how many
+of the flood's requests were answered "busy", and the scheduler's queue depth and wait
+metrics from get_connection_stats.
+
+Usage:
+    python bench_priority_lanes.py [--command get_character_actors] [--requests 200] [--clients 24] [--batch-size 20]
+"""
+
+import argparse
+import sys
+import threading
+from typing import Any, Dict, List
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+
+
+class Flood:
+    """Keeps heavy batches running from several connections until stopped."""
+
+    def __init__(self, clients: int, batch_size: int):
+        self.batch = {"commands": [{"type": "get_actors_in_level", "params": {}} for _ in range(batch_size)]}
+        self.completed = 0
+        self.busy = 0
+        self.errors: List[Exception] = []
+        self._lock = threading.Lock()
+        self._stop = threading.Event()
+        self._threads = [threading.Thread(target=self._run, daemon=True) for _ in range(clients)]
+
+    def start(self):
+        for thread in self._threads:
+            thread.start()
+
+    def stop(self):
+        self._stop.set()
+        for thread in self._threads:
+            thread.join()
+
+    def _run(self):
+        # batch may modify the level, so the server runs one at a time per connection
+        conn = BenchConnection(timeout=120.0)
+        try:
+            while not self._stop.is_set():
+                response = conn.command("batch", self.batch)
+                with self._lock:
+                    if response.get("status") == "busy":
+                        self.busy += 1
+                    else:
+                        self.completed += 1
+        except Exception as e:
+            with self._lock:
+                self.errors.append(e)
+        finally:
+            conn.close()
+
+
+def measure_latency(conn: BenchConnection, command: str, requests: int) -> List[float]:
+    samples = []
+    for _ in range(requests):
+        start = now_ms()
+        response = conn.command(command)
+        samples.append(now_ms() - start)
+        if response.get("status") not in ("success", "busy"):
+            raise RuntimeError(f"{command} failed: {response}")
+    return samples
+
+
+def report(label: str, samples: List[float]):
+    print(f"{label:>12}: p50={percentile(samples, 50):8.2f} ms  p95={percentile(samples, 95):8.2f} ms  max={max(samples):8.2f} ms")
+
+
+def report_scheduler(stats: Dict[str, Any]):
+    for lane, lane_stats in stats.get("scheduler", {}).items():
+        print(f"{lane:>12}: depth={lane_stats['depth']:4.0f}/{lane_stats['capacity']:<4.0f} max_depth={lane_stats['max_depth']:4.0f}  "
+              f"admitted={lane_stats['admitted']:6.0f}  rejected={lane_stats['rejected']:5.0f}  "
+              f"wait_ms p50={lane_stats['wait_ms_p50']:8.2f} p95={lane_stats['wait_ms_p95']:8.2f} max={lane_stats['wait_ms_max']:8.2f}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--command", default="get_character_actors", help="cheap read-only game-thread command to time")
+    parser.add_argument("--requests", type=int, default=200)
+    parser.add_argument("--clients", type=int, default=24, help="connections flooding the heavy lane")
+    parser.add_argument("--batch-size", type=int, default=20)
+    args = parser.parse_args()
+
+    conn = BenchConnection()
+    try:
+        idle = measure_latency(conn, args.command, args.requests)
+
+        flood = Flood(args.clients, args.batch_size)
+        flood.start()
+        try:
+            loaded = measure_latency(conn, args.command, args.requests)
+        finally:
+            flood.stop()
+        if flood.errors:
+            raise RuntimeError(f"flood connection failed: {flood.errors[0]}")
+
+        report("idle", idle)
+        report("under load", loaded)
+        print(f"flood: {flood.completed} batches completed, {flood.busy} answered busy")
+
+        stats = conn.command("get_connection_stats")
+        if stats.get("status") != "success":
+            raise RuntimeError(f"get_connection_stats failed: {stats}")
+        report_scheduler(stats["result"])
+    except Exception as e:
+        print(f"error: {e}")
+        return 1
+    finally:
+        conn.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
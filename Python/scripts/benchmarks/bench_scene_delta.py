@@ -0,0 +1,102 @@
+"""
+Level sync cost: relisting with get_actors_in_level vs asking get_scene_delta for changes.
+
+Each round moves a few actors, then brings a mirror of the level up to date twice:
+once by relisting everything and once with a delta since the last generation. Both
+report the response size, the game-thread time the server spent (game_thread_ms)
+and the client-observed wall time. Use --spawn to add throwaway actors first so the
+level is large enough to measure; they are deleted again at the end.
+
+Usage:
+    python bench_scene_delta.py [--spawn 10000] [--moves 10] [--rounds 5]
+"""
+
+import argparse
+import json
+import sys
+from typing import Any, Dict, List
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+from bench_actor_listing import SPAWN_PREFIX, delete_actors, run_batch, spawn_actors
+
+
+def timed(conn: BenchConnection, command: str, params: Dict[str, Any]):
+    start = now_ms()
+    response = conn.command(command, params)
+    elapsed = now_ms() - start
+    if response.get("status") != "success":
+        raise RuntimeError(f"{command} failed: {response}")
+    return response["result"], len(json.dumps(response)), elapsed
+
+
+def move_actors(conn: BenchConnection, spawned: int, moves: int, round_index: int):
+    run_batch(conn, [
+        {"type": "set_actor_transform",
+         "params": {"name": f"{SPAWN_PREFIX}{(round_index * moves + i) % spawned}", "location": [i * 10.0, 100.0 * (round_index + 1), 0.0]}}
+        for i in range(moves)
+    ])
+
+
+def report(label: str, sizes: List[int], server_ms: List[float], wall_ms: List[float], counts: List[int]):
+    print(f"{label:>8}: actors/round={sum(counts) / len(counts):8.1f}  bytes p50={percentile(sizes, 50):10.0f}  "
+          f"game_thread_ms p50={percentile(server_ms, 50):8.2f}  wall_ms p50={percentile(wall_ms, 50):8.2f}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--spawn", type=int, default=0, help="throwaway actors to add before measuring")
+    parser.add_argument("--moves", type=int, default=10, help="actors moved between syncs")
+    parser.add_argument("--rounds", type=int, default=5)
+    args = parser.parse_args()
+
+    if args.moves > 0 and args.spawn <= 0:
+        print("error: --moves needs --spawn to have actors to move")
+        return 1
+
+    conn = BenchConnection()
+    try:
+        if args.spawn:
+            spawn_actors(conn, args.spawn)
+
+        listing, _, _ = timed(conn, "get_actors_in_level", {})
+        generation = listing["generation"]
+        print(f"level: {listing['count']} actors, generation {generation}")
+
+        full = {"sizes": [], "server": [], "wall": [], "counts": []}
+        delta = {"sizes": [], "server": [], "wall": [], "counts": []}
+        for round_index in range(args.rounds):
+            move_actors(conn, args.spawn, args.moves, round_index)
+
+            result, size, wall = timed(conn, "get_actors_in_level", {})
+            full["sizes"].append(size)
+            full["server"].append(result.get("game_thread_ms", 0.0))
+            full["wall"].append(wall)
+            full["counts"].append(result["count"])
+
+            result, size, wall = timed(conn, "get_scene_delta", {"since_generation": generation})
+            if result["reset"]:
+                raise RuntimeError(f"generation {generation} was too old to diff against")
+            generation = result["generation"]
+            delta["sizes"].append(size)
+            delta["server"].append(result.get("game_thread_ms", 0.0))
+            delta["wall"].append(wall)
+            delta["counts"].append(result["count"])
+
+        report("full", full["sizes"], full["server"], full["wall"], full["counts"])
+        report("delta", delta["sizes"], delta["server"], delta["wall"], delta["counts"])
+        ratio = percentile(full["sizes"], 50) / max(1.0, percentile(delta["sizes"], 50))
+        print(f"delta responses are {ratio:.0f}x smaller")
+    except Exception as e:
+        print(f"error: {e}")
+        return 1
+    finally:
+        try:
+            if args.spawn:
+                delete_actors(conn, args.spawn)
+        finally:
+            conn.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,97 @@
+"""
+Screenshot delivery benchmark: file vs inline attachment vs shared memory.
+
+Runs `take_screenshot` repeatedly with each delivery mode and measures the time
+until the client holds the encoded image bytes (reading the file back for
+"file", mapping the region for "shared_memory").
+
+Usage:
+    python bench_screenshot_delivery.py [--shots 20] [--modes file inline shared_memory]
+                                        [--format png|jpeg|webp] [--quality N]
+"""
+
+import argparse
+import mmap
+import os
+import sys
+import tempfile
+from typing import Any, Dict, List
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+
+
+def read_shared_memory(name: str, size: int) -> bytes:
+    if os.name == "nt":
+        region = mmap.mmap(-1, size, tagname=name, access=mmap.ACCESS_READ)
+    else:
+        with open(f"/dev/shm/{name}", "rb") as handle:
+            region = mmap.mmap(handle.fileno(), size, access=mmap.ACCESS_READ)
+    try:
+        return region[:size]
+    finally:
+        region.close()
+
+
+def fetch_image(conn: BenchConnection, mode: str, shot: int, out_dir: str, encoding: Dict[str, Any]) -> bytes:
+    params: Dict[str, Any] = {"delivery": mode, **encoding}
+    if mode == "file":
+        params["filepath"] = os.path.join(out_dir, f"bench_{shot}.{encoding.get('format', 'png')}")
+
+    response = conn.command("take_screenshot", params)
+    if response.get("status") != "success":
+        raise RuntimeError(f"Unexpected response: {response}")
+    result = response["result"]
+
+    if mode == "inline":
+        return response["attachments"][0]["data"]
+    if mode == "shared_memory":
+        name = result["shared_memory_name"]
+        data = read_shared_memory(name, int(result["size_bytes"]))
+        conn.command("release_shared_memory", {"name": name})
+        return data
+    with open(result["path"], "rb") as handle:
+        return handle.read()
+
+
+def run_mode(mode: str, shots: int, encoding: Dict[str, Any]) -> bool:
+    samples: List[float] = []
+    sizes: List[int] = []
+    conn = BenchConnection()
+    try:
+        with tempfile.TemporaryDirectory() as out_dir:
+            for shot in range(shots):
+                start = now_ms()
+                data = fetch_image(conn, mode, shot, out_dir, encoding)
+                samples.append(now_ms() - start)
+                sizes.append(len(data))
+    except Exception as e:
+        print(f"{mode:>14}: error: {e}")
+        return False
+    finally:
+        conn.close()
+
+    print(f"{mode:>14}: shots={len(samples):4d}  p50={percentile(samples, 50):8.2f} ms  "
+          f"p99={percentile(samples, 99):8.2f} ms  avg_size={sum(sizes) / len(sizes) / 1024:8.1f} KiB")
+    return True
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--shots", type=int, default=20)
+    parser.add_argument("--modes", nargs="+", default=["file", "inline", "shared_memory"])
+    parser.add_argument("--format", choices=["png", "jpeg", "webp"], default="png")
+    parser.add_argument("--quality", type=int, help="PNG zlib level 0-9, JPEG/WebP quality 1-100")
+    args = parser.parse_args()
+
+    encoding: Dict[str, Any] = {"format": args.format}
+    if args.quality is not None:
+        encoding["quality"] = args.quality
+
+    ok = True
+    for mode in args.modes:
+        ok = run_mode(mode, args.shots, encoding) and ok
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,69 @@
+"""
+Spatial query cost: query_actors_in_radius (octree) vs get_actors_in_level with a bounds filter (full walk).
+
+Use --spawn to add throwaway static mesh actors in a line along +X, 10 cm apart. For
+those, a sphere and its enclosing box select the same actors, so the difference in the
+server's game_thread_ms is the cost of visiting actors outside the neighbourhood. The
+first octree query also pays for building the tree and is reported separately.
+
+Usage:
+    python bench_spatial_query.py [--spawn 10000] [--radius 500 5000] [--repeat 20]
+"""
+
+import argparse
+import sys
+from typing import Any, Dict, List
+
+from bench_actor_listing import delete_actors, spawn_actors
+from mcp_bench_client import BenchConnection, percentile
+
+
+def query(conn: BenchConnection, command: str, params: Dict[str, Any]) -> Dict[str, Any]:
+    response = conn.command(command, params)
+    if response.get("status") != "success":
+        raise RuntimeError(f"{command} failed: {response}")
+    return response["result"]
+
+
+def measure(conn: BenchConnection, command: str, params: Dict[str, Any], repeat: int) -> List[float]:
+    return [query(conn, command, params).get("game_thread_ms", 0.0) for _ in range(repeat)]
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--spawn", type=int, default=0, help="temporary actors to add before measuring")
+    parser.add_argument("--radius", type=float, nargs="+", default=[500.0, 5000.0])
+    parser.add_argument("--repeat", type=int, default=20)
+    args = parser.parse_args()
+
+    conn = BenchConnection(timeout=120.0)
+    ok = False
+    try:
+        if args.spawn:
+            # Plain actors have no root component, so they have no location to index
+            spawn_actors(conn, args.spawn, actor_type="StaticMeshActor")
+
+        center = [0.0, 0.0, 0.0]
+        first = query(conn, "query_actors_in_radius", {"location": center, "radius": 1.0, "fields": ["name"]})
+        print(f"first octree query (includes build): {first['game_thread_ms']:.2f} ms")
+
+        for radius in args.radius:
+            bounds = {"min": [-radius, -radius, -radius], "max": [radius, radius, radius]}
+            octree = measure(conn, "query_actors_in_radius", {"location": center, "radius": radius, "fields": ["name"]}, args.repeat)
+            walk = measure(conn, "get_actors_in_level", {"bounds": bounds, "fields": ["name"]}, args.repeat)
+            found = query(conn, "query_actors_in_radius", {"location": center, "radius": radius, "fields": ["name"]})["count"]
+            speedup = percentile(walk, 50) / percentile(octree, 50) if percentile(octree, 50) > 0 else 0.0
+            print(f"radius={radius:8.0f}  found={found:6d}  octree p50={percentile(octree, 50):7.3f} ms  "
+                  f"walk p50={percentile(walk, 50):7.3f} ms  speedup={speedup:6.1f}x")
+        ok = True
+    except Exception as e:
+        print(f"error: {e}")
+    finally:
+        if args.spawn:
+            delete_actors(conn, args.spawn)
+        conn.close()
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
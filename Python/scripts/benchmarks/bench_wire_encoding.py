@@ -0,0 +1,97 @@
+"""
+Wire encoding cost: get_actors_in_level as JSON vs CBOR.
+
+Lists the level over two length-prefixed connections, one negotiated to each
+encoding with set_framing, and reports the message size on the wire, the
+client-side CPU time to decode it and to encode the same data again, and the
+client-observed wall time, normalized per 10k actors. Use --spawn to add throwaway
+actors first so the level is large enough to measure; they are deleted again at
+the end.
+
+Usage:
+    python bench_wire_encoding.py [--spawn 10000] [--repeat 5]
+"""
+
+import argparse
+import sys
+import time
+from typing import Any, Dict, List
+
+from mcp_bench_client import BenchConnection, now_ms, percentile
+from bench_actor_listing import delete_actors, spawn_actors
+
+ENCODINGS = ("json", "cbor")
+
+
+def measure(encoding: str, repeat: int) -> Dict[str, List[float]]:
+    conn = BenchConnection()
+    samples = {"bytes": [], "decode_ms": [], "encode_ms": [], "wall_ms": [], "actors": []}
+    try:
+        response = conn.set_framing("length_prefixed", encoding)
+        if response.get("status") != "success":
+            raise RuntimeError(f"set_framing failed: {response}")
+
+        for _ in range(repeat):
+            start = now_ms()
+            conn.send_raw(conn.encode({"type": "get_actors_in_level", "params": {}}))
+            payload = conn.recv_payload()
+            wall = now_ms() - start
+
+            cpu = time.process_time()
+            response = conn.loads(payload)
+            decode_ms = (time.process_time() - cpu) * 1000.0
+            if response.get("status") != "success":
+                raise RuntimeError(f"get_actors_in_level failed: {response}")
+
+            cpu = time.process_time()
+            conn.dumps(response)
+            encode_ms = (time.process_time() - cpu) * 1000.0
+
+            samples["bytes"].append(len(payload))
+            samples["decode_ms"].append(decode_ms)
+            samples["encode_ms"].append(encode_ms)
+            samples["wall_ms"].append(wall)
+            samples["actors"].append(response["result"]["count"])
+    finally:
+        conn.close()
+    return samples
+
+
+def report(encoding: str, samples: Dict[str, List[float]]):
+    per_10k = 10000.0 / max(1, samples["actors"][0])
+    print(f"{encoding:>5}: actors={samples['actors'][0]:7d}  bytes={percentile(samples['bytes'], 50):10.0f}  "
+          f"per 10k actors: decode_ms p50={percentile(samples['decode_ms'], 50) * per_10k:8.2f}  "
+          f"encode_ms p50={percentile(samples['encode_ms'], 50) * per_10k:8.2f}  "
+          f"wall_ms p50={percentile(samples['wall_ms'], 50) * per_10k:8.2f}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--spawn", type=int, default=0, help="throwaway actors to add before measuring")
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    conn = BenchConnection()
+    try:
+        if args.spawn:
+            spawn_actors(conn, args.spawn)
+
+        results = {encoding: measure(encoding, args.repeat) for encoding in ENCODINGS}
+        for encoding in ENCODINGS:
+            report(encoding, results[encoding])
+        ratio = percentile(results["json"]["bytes"], 50) / max(1.0, percentile(results["cbor"]["bytes"], 50))
+        print(f"CBOR messages are {ratio:.2f}x smaller")
+    except Exception as e:
+        print(f"error: {e}")
+        return 1
+    finally:
+        try:
+            if args.spawn:
+                delete_actors(conn, args.spawn)
+        finally:
+            conn.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
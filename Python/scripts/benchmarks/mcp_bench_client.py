@@ -0,0 +1,474 @@
+"""
+Minimal blocking client for the UnrealMCP TCP server, shared by the benchmark scripts.
+
+Uses only the standard library so benchmarks can run outside the uv environment.
+"""
+
+import json
+import mmap
+import os
+import socket
+import stat
+import struct
+import sys
+import tempfile
+import time
+import zlib
+from typing import Any, Dict, List, Optional
+
+UNREAL_HOST = os.getenv("UNREAL_TCP_HOST", "127.0.0.1")
+UNREAL_PORT = int(os.getenv("UNREAL_TCP_PORT", "55557"))
+UNREAL_UNIX_SOCKET = os.getenv("UNREAL_MCP_UNIX_SOCKET") or os.path.join(
+    os.getenv("XDG_RUNTIME_DIR") or os.path.join(tempfile.gettempdir(), f"unreal-mcp-{os.getuid() if hasattr(os, 'getuid') else 0}"),
+    f"unreal-mcp-{UNREAL_PORT}.sock")
+
+
+def check_private_unix_socket(path: str):
+    """Raises unless path is this user's socket in a directory only this user can access."""
+    directory = os.lstat(os.path.dirname(os.path.abspath(path)))
+    sock = os.lstat(path)
+    uid = os.getuid()
+    if not (stat.S_ISDIR(directory.st_mode) and directory.st_uid == uid and directory.st_mode & 0o077 == 0
+            and stat.S_ISSOCK(sock.st_mode) and sock.st_uid == uid):
+        raise PermissionError(f"{path} or its directory is not private to this user")
+
+
+class BenchConnection:
+    """Persistent connection that sends one command and waits for its JSON response."""
+
+    def __init__(self, host: str = UNREAL_HOST, port: int = UNREAL_PORT, timeout: float = 30.0,
+                 unix_path: Optional[str] = None):
+        """Connects over TCP, or over the editor's Unix domain socket when unix_path is given."""
+        if unix_path:
+            check_private_unix_socket(unix_path)
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            self.sock.settimeout(timeout)
+            self.sock.connect(unix_path)
+        else:
+            self.sock = socket.create_connection((host, port), timeout=timeout)
+            self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self._pending = b""
+        self.framing = "json"
+        self.encoding = "json"
+        self.compression = "none"
+        self.bytes_received = 0
+        self.ring = None
+
+    def close(self):
+        try:
+            self.sock.close()
+        except OSError:
+            pass
+        if self.ring is not None:
+            self.ring.close()
+            self.ring = None
+
+    def open_shared_ring(self, size: int = 64 * 1024 * 1024, threshold: Optional[int] = None) -> Dict[str, Any]:
+        """Have payloads of at least threshold bytes delivered through a shared-memory ring.
+
+        Needs length_prefixed framing and Unreal on this machine.
+        """
+        params = {"size": size}
+        if threshold is not None:
+            params["threshold"] = threshold
+        response = self.command("open_shared_ring", params)
+        if response.get("status") == "success":
+            result = response["result"]
+            self.ring = SharedRing(result["name"], int(result["region_size"]), int(result["header_size"]), int(result["capacity"]))
+        return response
+
+    def close_shared_ring(self) -> Dict[str, Any]:
+        response = self.command("close_shared_ring")
+        if self.ring is not None:
+            self.ring.close()
+            self.ring = None
+        return response
+
+    def send_raw(self, payload: bytes):
+        self.sock.sendall(payload)
+
+    def set_framing(self, mode: str, encoding: Optional[str] = None, compression: Optional[str] = None,
+                    compression_threshold: Optional[int] = None) -> Dict[str, Any]:
+        """Negotiate 'json', 'newline' or 'length_prefixed' framing, optionally with 'cbor' encoding
+        and 'lz4' or 'zlib' compression of large responses.
+
+        The reply still uses the old settings. Leaving encoding or compression out turns them off.
+        """
+        params = {"mode": mode}
+        if encoding:
+            params["encoding"] = encoding
+        if compression:
+            params["compression"] = compression
+        if compression_threshold is not None:
+            params["compression_threshold"] = compression_threshold
+        response = self.command("set_framing", params)
+        if response.get("status") == "success":
+            self.framing = mode
+            self.encoding = encoding or "json"
+            self.compression = compression or "none"
+        return response
+
+    def dumps(self, message: Dict[str, Any]) -> bytes:
+        if self.encoding == "cbor":
+            return cbor_dumps(message)
+        return json.dumps(message).encode("utf-8")
+
+    def loads(self, payload: bytes) -> Dict[str, Any]:
+        if self.encoding == "cbor":
+            return cbor_loads(payload)
+        return json.loads(payload.decode("utf-8"))
+
+    def encode(self, message: Dict[str, Any]) -> bytes:
+        payload = self.dumps(message)
+        if self.framing == "newline":
+            return payload + b"\n"
+        if self.framing == "length_prefixed":
+            return struct.pack(">I", len(payload)) + payload
+        return payload
+
+    def _recv_more(self):
+        chunk = self.sock.recv(65536)
+        if not chunk:
+            raise ConnectionError("Connection closed by Unreal")
+        self.bytes_received += len(chunk)
+        self._pending += chunk
+
+    def recv_frame(self):
+        """Read one length-prefixed frame: (flags, body). Shared-ring descriptors are resolved to the payload."""
+        while len(self._pending) < 4:
+            self._recv_more()
+        (header,) = struct.unpack(">I", self._pending[:4])
+        length = header & ~FRAME_FLAGS
+        while len(self._pending) < 4 + length:
+            self._recv_more()
+        body, self._pending = self._pending[4:4 + length], self._pending[4 + length:]
+        if header & RING_FLAG:
+            if self.ring is None:
+                raise RuntimeError("Shared-ring frame without an open ring")
+            position, size = struct.unpack(">QQ", body)
+            return 0, self.ring.read(position, size)
+        return header & FRAME_FLAGS, body
+
+    def recv_payload(self) -> bytes:
+        """Read one length-prefixed message body, reassembling compressed blocks, without decoding it."""
+        flags, body = self.recv_frame()
+        if not flags & COMPRESSED_FLAG:
+            return body
+        blocks = [decompress_block(self.compression, body)]
+        while flags & MORE_FLAG:
+            flags, body = self.recv_frame()
+            blocks.append(decompress_block(self.compression, body))
+        return b"".join(blocks)
+
+    def recv_json(self) -> Dict[str, Any]:
+        """Read one complete response in the negotiated framing and encoding."""
+        if self.framing == "length_prefixed":
+            return self.loads(self.recv_payload())
+
+        while True:
+            end = json_document_end(self._pending)
+            if end >= 0:
+                payload, self._pending = self._pending[:end], self._pending[end:]
+                return json.loads(payload.decode("utf-8").lstrip("\x00 \t\r\n"))
+            self._recv_more()
+
+    def _recv_exact(self, size: int) -> bytes:
+        while len(self._pending) < size:
+            self._recv_more()
+        data, self._pending = self._pending[:size], self._pending[size:]
+        return data
+
+    def recv_attachments(self, response: Dict[str, Any]):
+        """Read the binary attachments a response announces into attachment['data']."""
+        for attachment in response.get("attachments", []):
+            if self.framing == "length_prefixed":
+                attachment["data"] = self.recv_frame()[1]
+            else:
+                attachment["data"] = self._recv_exact(int(attachment["size"]))
+
+    def recv_response(self) -> Dict[str, Any]:
+        response = self.recv_json()
+        self.recv_attachments(response)
+        return response
+
+    def command(self, command_type: str, params: Optional[Dict[str, Any]] = None) -> Dict[str, Any]:
+        self.send_raw(self.encode({"type": command_type, "params": params or {}}))
+        return self.recv_response()
+
+    def stream(self, command_type: str, params: Optional[Dict[str, Any]] = None, request_id: int = 0):
+        """Send a streaming command with an id and yield each "progress" response, then the final one."""
+        self.send_raw(self.encode({"type": command_type, "params": params or {}, "id": request_id}))
+        while True:
+            response = self.recv_response()
+            if response.get("id") != request_id:
+                raise RuntimeError(f"Unexpected response id: {response}")
+            yield response
+            if response.get("status") != "progress":
+                return
+
+
+def json_document_end(data: bytes) -> int:
+    """Offset just past the first complete JSON document in data, or -1.
+
+    Scans bytes rather than decoded text because binary attachments may follow.
+    """
+    depth = 0
+    in_string = False
+    escape = False
+    for index, byte in enumerate(data):
+        if depth == 0:
+            if byte in b"{[":
+                depth = 1
+            continue
+        if in_string:
+            if escape:
+                escape = False
+            elif byte == 0x5C:
+                escape = True
+            elif byte == 0x22:
+                in_string = False
+        elif byte == 0x22:
+            in_string = True
+        elif byte in b"{[":
+            depth += 1
+        elif byte in b"}]":
+            depth -= 1
+            if depth == 0:
+                return index + 1
+    return -1
+
+
+COMPRESSED_FLAG = 0x80000000
+MORE_FLAG = 0x40000000
+RING_FLAG = 0x20000000
+FRAME_FLAGS = COMPRESSED_FLAG | MORE_FLAG | RING_FLAG
+
+
+class SharedRing:
+    """Client side of a connection's shared-memory ring (see open_shared_ring)."""
+
+    TAIL_OFFSET = 128
+
+    def __init__(self, name: str, region_size: int, header_size: int, capacity: int):
+        if sys.platform == "win32":
+            self.region = mmap.mmap(-1, region_size, tagname=name)
+        else:
+            with open(f"/dev/shm/{name}", "r+b") as handle:
+                self.region = mmap.mmap(handle.fileno(), region_size)
+        self.header_size = header_size
+        self.capacity = capacity
+
+    def read(self, position: int, size: int) -> bytes:
+        """Copy a payload out, then release its space to the server."""
+        start = self.header_size + position % self.capacity
+        first = min(size, self.capacity - position % self.capacity)
+        data = self.region[start:start + first]
+        if first < size:
+            data += self.region[self.header_size:self.header_size + size - first]
+        struct.pack_into("<Q", self.region, self.TAIL_OFFSET, position + size)
+        return data
+
+    def close(self):
+        self.region.close()
+
+
+def decompress_block(codec: str, body: bytes) -> bytes:
+    """One compressed frame body: original size, then the block (stored as is if it didn't shrink)."""
+    (size,) = struct.unpack(">I", body[:4])
+    data = body[4:]
+    if len(data) == size:
+        return data
+    if codec == "zlib":
+        return zlib.decompress(data)
+    if codec == "lz4":
+        return lz4_block_decompress(data, size)
+    raise ValueError(f"Compressed frame on a connection without compression ({codec})")
+
+
+def lz4_block_decompress(data: bytes, size: int) -> bytes:
+    """Decode an LZ4 block (no frame header) of known decompressed size."""
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                extra = data[pos]
+                pos += 1
+                literals += extra
+                if extra != 255:
+                    break
+        out += data[pos:pos + literals]
+        pos += literals
+        if pos >= len(data):
+            break
+        offset = data[pos] | data[pos + 1] << 8
+        pos += 2
+        match = (token & 0x0F) + 4
+        if match == 19:
+            while True:
+                extra = data[pos]
+                pos += 1
+                match += extra
+                if extra != 255:
+                    break
+        start = len(out) - offset
+        if offset >= match:
+            out += out[start:start + match]
+        else:
+            for i in range(match):
+                out.append(out[start + i])
+    if len(out) != size:
+        raise ValueError(f"LZ4 block decoded to {len(out)} bytes, expected {size}")
+    return bytes(out)
+
+
+def cbor_dumps(value: Any) -> bytes:
+    """Encode JSON-shaped data as CBOR (RFC 8949), the way the server expects requests."""
+    out = bytearray()
+    _cbor_append(out, value)
+    return bytes(out)
+
+
+def _cbor_head(out: bytearray, major: int, argument: int):
+    if argument < 24:
+        out.append(major << 5 | argument)
+    elif argument < 0x100:
+        out += struct.pack(">BB", major << 5 | 24, argument)
+    elif argument < 0x10000:
+        out += struct.pack(">BH", major << 5 | 25, argument)
+    elif argument < 0x100000000:
+        out += struct.pack(">BI", major << 5 | 26, argument)
+    else:
+        out += struct.pack(">BQ", major << 5 | 27, argument)
+
+
+def _cbor_append(out: bytearray, value: Any):
+    if value is None:
+        out.append(0xF6)
+    elif value is True:
+        out.append(0xF5)
+    elif value is False:
+        out.append(0xF4)
+    elif isinstance(value, int):
+        if value >= 0:
+            _cbor_head(out, 0, value)
+        else:
+            _cbor_head(out, 1, -1 - value)
+    elif isinstance(value, float):
+        out += struct.pack(">Bd", 0xFB, value)
+    elif isinstance(value, str):
+        text = value.encode("utf-8")
+        _cbor_head(out, 3, len(text))
+        out += text
+    elif isinstance(value, (list, tuple)):
+        _cbor_head(out, 4, len(value))
+        for item in value:
+            _cbor_append(out, item)
+    elif isinstance(value, dict):
+        _cbor_head(out, 5, len(value))
+        for key, item in value.items():
+            _cbor_append(out, str(key))
+            _cbor_append(out, item)
+    else:
+        raise TypeError(f"Cannot encode {type(value).__name__} as CBOR")
+
+
+def cbor_loads(data: bytes) -> Any:
+    """Decode one CBOR item holding JSON-shaped data: what the server sends back."""
+    value, offset = _cbor_item(memoryview(data), 0)
+    if offset != len(data):
+        raise ValueError(f"{len(data) - offset} trailing bytes after CBOR item")
+    return value
+
+
+_CBOR_BREAK = object()
+
+
+def _cbor_item(data: memoryview, offset: int):
+    initial = data[offset]
+    offset += 1
+    major, info = initial >> 5, initial & 0x1F
+
+    if major == 7:
+        if info == 20:
+            return False, offset
+        if info == 21:
+            return True, offset
+        if info in (22, 23):
+            return None, offset
+        if info == 25:
+            return struct.unpack_from(">e", data, offset)[0], offset + 2
+        if info == 26:
+            return struct.unpack_from(">f", data, offset)[0], offset + 4
+        if info == 27:
+            return struct.unpack_from(">d", data, offset)[0], offset + 8
+        if info == 31:
+            return _CBOR_BREAK, offset
+        raise ValueError(f"Unsupported CBOR simple value {info}")
+
+    if info < 24:
+        argument = info
+    elif info == 24:
+        argument, offset = data[offset], offset + 1
+    elif info == 25:
+        argument, offset = struct.unpack_from(">H", data, offset)[0], offset + 2
+    elif info == 26:
+        argument, offset = struct.unpack_from(">I", data, offset)[0], offset + 4
+    elif info == 27:
+        argument, offset = struct.unpack_from(">Q", data, offset)[0], offset + 8
+    elif info == 31:
+        argument = None
+    else:
+        raise ValueError(f"Invalid CBOR additional info {info}")
+
+    if major == 0:
+        return argument, offset
+    if major == 1:
+        return -1 - argument, offset
+    if major in (2, 3):
+        if argument is None:
+            chunks = []
+            while True:
+                chunk, offset = _cbor_item(data, offset)
+                if chunk is _CBOR_BREAK:
+                    break
+                chunks.append(chunk)
+            return ("" if major == 3 else b"").join(chunks), offset
+        raw = bytes(data[offset:offset + argument])
+        return (raw.decode("utf-8") if major == 3 else raw), offset + argument
+    if major == 4:
+        items = []
+        while argument is None or len(items) < argument:
+            item, offset = _cbor_item(data, offset)
+            if item is _CBOR_BREAK:
+                break
+            items.append(item)
+        return items, offset
+    if major == 5:
+        result = {}
+        count = 0
+        while argument is None or count < argument:
+            key, offset = _cbor_item(data, offset)
+            if key is _CBOR_BREAK:
+                break
+            result[key], offset = _cbor_item(data, offset)
+            count += 1
+        return result, offset
+    # Tags carry no meaning for these payloads; return the tagged item
+    return _cbor_item(data, offset)
+
+
+def percentile(samples: List[float], pct: float) -> float:
+    """Nearest-rank percentile; samples need not be sorted."""
+    if not samples:
+        return 0.0
+    ordered = sorted(samples)
+    rank = max(0, min(len(ordered) - 1, int(round(pct / 100.0 * len(ordered) + 0.5)) - 1))
+    return ordered[rank]
+
+
+def now_ms() -> float:
+    return time.perf_counter() * 1000.0
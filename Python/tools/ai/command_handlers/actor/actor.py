@@ -19,11 +19,23 @@ class ActorCommandHandler(BaseCommandHandler):
     Purpose: General-purpose Unreal Engine actor manipulation for any actor type
     
     Supported Commands:
-    - get_actors_in_level: List all actors in current level (no parameters)
+    - get_actors_in_level: List actors in current level; optional fields/class/tag/bounds filters and limit/cursor paging; returns the scene generation
+    - get_scene_delta: Actors spawned, changed and deleted since since_generation (same fields/class/tag/bounds filters); reset=true means relist from 'spawned'
     - create_actor: Spawn new actor of specified type
     - delete_actor: Remove actor by name
     - set_actor_transform: Modify actor position/rotation/scale  
     - get_actor_properties: Retrieve actor property values
+    - select_visible_actors: Actors inside the current view frustum and not hidden; optional max_distance, rendered
+    - get_character_actors: Character actors; optional location/radius to restrict and sort by distance
+    - query_actors_in_radius: Actors whose bounds overlap a sphere (location, radius), nearest first
+    - query_actors_in_frustum: Actors inside a camera frustum; defaults to the current view, optional location/rotation/fov/aspect_ratio/max_distance
+    - raycast: First collision hit from start to end (or start + direction * distance); against="bounds" lists every actor crossed
+    - get_properties: Read many reflected properties of one actor (actor_name or actor_class, properties: [names])
+    - set_properties: Write many reflected properties of one actor (properties: {name: value}); the construction rerun is shared with every write to the actor in the same batch or frame
+    - animate_property: Sweep a numeric property to 'to' over 'duration' seconds on the server (property: time_of_day, color_temperature, latitude, longitude, or a reflected name with actor_name/actor_class); optional from, easing, wait, progress_interval
+    - stop_animation: Stop one animation (animation_id) or all of them
+    - subscribe: Push per-frame transform/property changes (actor_name, actor_names, actor_class or tag; properties, transform, min_interval); needs a request id, so pipelined clients only
+    - unsubscribe: End a subscription (subscription_id)
     
     Input Constraints:
     - name: Required non-empty string (actor identifier)
@@ -37,7 +49,9 @@ class ActorCommandHandler(BaseCommandHandler):
     """
     
     def get_supported_commands(self) -> List[str]:
-        return ["get_actors_in_level", "create_actor", "delete_actor", "set_actor_transform", "get_actor_properties"]
+        return ["get_actors_in_level", "get_scene_delta", "create_actor", "delete_actor", "set_actor_transform", "get_actor_properties",
+                "select_visible_actors", "get_character_actors", "query_actors_in_radius", "query_actors_in_frustum", "raycast",
+                "get_properties", "set_properties", "animate_property", "stop_animation", "subscribe", "unsubscribe"]
     
     def validate_command(self, command_type: str, params: Dict[str, Any]) -> ValidatedCommand:
         """Validate actor commands with basic parameter checks."""
@@ -60,7 +74,38 @@ class ActorCommandHandler(BaseCommandHandler):
             elif not isinstance(params["name"], str) or not params["name"].strip():
                 errors.append("name must be a non-empty string")
         
-        # get_actors_in_level requires no parameters
+        elif command_type == "query_actors_in_radius":
+            if "location" not in params:
+                errors.append("Missing required parameter: location")
+            if "radius" not in params:
+                errors.append("Missing required parameter: radius")
+            elif not isinstance(params["radius"], (int, float)) or params["radius"] < 0:
+                errors.append("radius must be a non-negative number")
+        
+        elif command_type == "raycast":
+            if "start" not in params:
+                errors.append("Missing required parameter: start")
+            if "end" not in params and "direction" not in params:
+                errors.append("Missing required parameter: end or direction")
+        
+        elif command_type in ["get_properties", "set_properties"]:
+            if "actor_name" not in params and "actor_class" not in params:
+                errors.append("Missing required parameter: actor_name or actor_class")
+            expected = list if command_type == "get_properties" else dict
+            if not isinstance(params.get("properties"), expected):
+                errors.append(f"properties must be a {'list of names' if expected is list else 'name to value object'}")
+        
+        elif command_type == "animate_property":
+            if not isinstance(params.get("property"), str) or not params["property"]:
+                errors.append("Missing required parameter: property")
+            if not isinstance(params.get("to"), (int, float)):
+                errors.append("to must be a number")
+            if not isinstance(params.get("duration"), (int, float)) or params["duration"] < 0:
+                errors.append("duration must be a non-negative number of seconds")
+            if params.get("easing", "linear") not in ["linear", "ease_in", "ease_out", "ease_in_out"]:
+                errors.append("easing must be one of linear, ease_in, ease_out, ease_in_out")
+        
+        # get_actors_in_level and the view queries' parameters are all optional and checked by the plugin
         
         return ValidatedCommand(
             type=command_type,
@@ -202,13 +202,10 @@ class NanoBananaImageEditHandler(BaseCommandHandler):
         if response and response.get("status") == "error":
             raise Exception(response.get("error", "Unknown screenshot error"))
         
-        # Wait for screenshot to be saved
-        time.sleep(1.0)
-        
-        # Find newest screenshot
-        screenshot_path = self._find_newest_screenshot()
+        # Unreal replies once the file is written, with its exact path
+        screenshot_path = ((response or {}).get("result") or {}).get("path")
         if not screenshot_path:
-            raise Exception("Screenshot was taken but file not found")
+            raise Exception("Screenshot was taken but no file path was reported")
         
         logger.info(f"Screenshot taken: {screenshot_path}")
         
@@ -385,37 +382,6 @@ Keep the image recognizable but with clear stylistic changes. Generate the trans
             logger.error(f"Failed to save Gemini generated image: {e}")
             raise Exception(f"Failed to save generated image: {str(e)}")
     
-    def _find_newest_screenshot(self) -> Optional[Path]:
-        """Find the newest screenshot file in the WindowsEditor directory."""
-        try:
-            project_path = os.getenv('UNREAL_PROJECT_PATH')
-            if not project_path:
-                logger.warning("UNREAL_PROJECT_PATH not set - cannot find screenshot files")
-                return None
-            
-            # Look in WindowsEditor subdirectory where Unreal saves high-res screenshots
-            screenshot_dir = Path(project_path) / "Saved" / "Screenshots" / "WindowsEditor"
-            
-            if not screenshot_dir.exists():
-                logger.warning(f"Screenshot directory not found: {screenshot_dir}")
-                return None
-            
-            # Find all PNG files
-            png_files = list(screenshot_dir.glob("*.png"))
-            
-            if not png_files:
-                logger.warning("No PNG files found in screenshot directory")
-                return None
-            
-            # Return the newest file by modification time
-            newest_file = max(png_files, key=lambda f: f.stat().st_mtime)
-            logger.info(f"Found newest screenshot: {newest_file.name}")
-            return newest_file
-            
-        except Exception as e:
-            logger.error(f"Error finding newest screenshot: {e}")
-            return None
-    
     def _resolve_image_path(self, image_path_param: str) -> Optional[str]:
         """Resolve image path - handles both full paths and filenames from session context."""
         # If it's already a full path and exists, use it
@@ -5,10 +5,8 @@ Handles Unreal Engine screenshot operations.
 """
 
 import logging
-import os
-import time
 from pathlib import Path
-from typing import Dict, Any, List, Optional
+from typing import Dict, Any, List
 from ..main import BaseCommandHandler
 from ...nlp_schema_validator import ValidatedCommand
 
@@ -26,7 +24,7 @@ class ScreenshotCommandHandler(BaseCommandHandler):
     - include_ui: Optional boolean, defaults to false
     
     Output:
-    - Returns success confirmation when command executes
+    - Returns the saved file's URL, path, dimensions and capture timings
     """
     
     def get_supported_commands(self) -> List[str]:
@@ -81,71 +79,21 @@ class ScreenshotCommandHandler(BaseCommandHandler):
         if response and response.get("status") == "error":
             raise Exception(response.get("error", f"Unknown Unreal {command_type} error"))
         
-        # Find newest screenshot file (with retry mechanism)
-        screenshot_file = self._find_newest_screenshot()
-        
-        if screenshot_file:
-            # Return success with direct file URL
-            filename = screenshot_file.name
-            return {
-                "success": True,
-                "message": f"Screenshot saved: {filename}",
-                "image_url": f"/api/screenshot-file/{filename}"
-            }
-        else:
-            # Return success but no file found (fallback)
-            return {
-                "success": True,
-                "message": "Screenshot command executed (file not immediately available)",
-                "image_url": None
-            }
+        # Unreal replies only after the image is written, with its exact path
+        result = (response or {}).get("result") or {}
+        screenshot_path = result.get("path")
+        if not screenshot_path:
+            raise Exception("Unreal did not report a screenshot path")
 
-    def _find_newest_screenshot(self) -> Optional[Path]:
-        """Find the newest screenshot file in the WindowsEditor directory with retry mechanism."""
-        try:
-            project_path = os.getenv('UNREAL_PROJECT_PATH')
-            if not project_path:
-                logger.warning("UNREAL_PROJECT_PATH not set - cannot find screenshot files")
-                return None
-            
-            # Look in WindowsEditor subdirectory where Unreal saves high-res screenshots
-            screenshot_dir = Path(project_path) / "Saved" / "Screenshots" / "WindowsEditor"
-            
-            if not screenshot_dir.exists():
-                logger.warning(f"Screenshot directory not found: {screenshot_dir}")
-                return None
-            
-            # Record current time to identify new files
-            start_time = time.time()
-            max_attempts = 10
-            wait_interval = 1.0
-            
-            for attempt in range(max_attempts):
-                # Find all PNG files
-                png_files = list(screenshot_dir.glob("*.png"))
-                
-                if png_files:
-                    # Look for files created after we started waiting
-                    recent_files = [f for f in png_files if f.stat().st_mtime >= start_time - 1]
-                    
-                    if recent_files:
-                        # Return the newest recent file
-                        newest_file = max(recent_files, key=lambda f: f.stat().st_mtime)
-                        logger.info(f"Found newest screenshot: {newest_file.name} (attempt {attempt + 1})")
-                        return newest_file
-                    elif attempt == 0:
-                        # On first attempt, also check if there are any existing files
-                        newest_file = max(png_files, key=lambda f: f.stat().st_mtime)
-                        logger.info(f"Found existing screenshot: {newest_file.name}")
-                        return newest_file
-                
-                if attempt < max_attempts - 1:
-                    logger.info(f"Screenshot not ready yet, waiting... (attempt {attempt + 1}/{max_attempts})")
-                    time.sleep(wait_interval)
-            
-            logger.warning(f"No screenshot found after {max_attempts} attempts ({max_attempts * wait_interval}s)")
-            return None
-            
-        except Exception as e:
-            logger.error(f"Error finding newest screenshot: {e}")
-            return None
\ No newline at end of file
+        filename = Path(screenshot_path).name
+        logger.info(f"Screenshot saved: {screenshot_path} ({result.get('width')}x{result.get('height')}, "
+                    f"{result.get('timings', {}).get('total_ms', 0):.0f} ms)")
+        return {
+            "success": True,
+            "message": f"Screenshot saved: {filename}",
+            "image_url": f"/api/screenshot-file/{filename}",
+            "path": screenshot_path,
+            "width": result.get("width"),
+            "height": result.get("height"),
+            "timings": result.get("timings")
+        }
@@ -27,7 +27,9 @@ LIGHT_CONSTRAINTS = {
 # Valid command types
 SKY_COMMANDS = ["get_ultra_dynamic_sky", "set_time_of_day", "set_color_temperature"]
 LIGHT_COMMANDS = ["create_mm_control_light", "get_mm_control_lights", "update_mm_control_light", "delete_mm_control_light"]
-ACTOR_COMMANDS = ["get_actors_in_level", "create_actor", "delete_actor", "set_actor_transform", "get_actor_properties"]
+ACTOR_COMMANDS = ["get_actors_in_level", "get_scene_delta", "create_actor", "delete_actor", "set_actor_transform", "get_actor_properties",
+                  "select_visible_actors", "get_character_actors", "query_actors_in_radius", "query_actors_in_frustum", "raycast",
+                  "get_properties", "set_properties", "animate_property", "stop_animation", "subscribe", "unsubscribe"]
 CESIUM_COMMANDS = ["set_cesium_latitude_longitude", "get_cesium_properties"]
 
 ALL_COMMANDS = SKY_COMMANDS + LIGHT_COMMANDS + ACTOR_COMMANDS + CESIUM_COMMANDS
@@ -7,10 +7,13 @@ A simple MCP server for interacting with Unreal Engine.
 import logging
 import os
 import socket
+import stat
 import sys
 import json
+import tempfile
+import time
 from contextlib import asynccontextmanager
-from typing import AsyncIterator, Dict, Any, Optional
+from typing import AsyncIterator, Dict, Any, List, Optional
 from mcp.server.fastmcp import FastMCP
 
 # Configure logging with more detailed format
@@ -28,6 +31,40 @@ logger = logging.getLogger("UnrealMCP")
 UNREAL_HOST = os.getenv("UNREAL_TCP_HOST", "127.0.0.1")
 UNREAL_PORT = int(os.getenv("UNREAL_TCP_PORT", "55557"))
 
+
+def _default_unix_socket() -> str:
+    """Where the editor puts its socket: a directory only this user can enter, never the shared temp dir."""
+    if not hasattr(os, "getuid"):
+        return "off"
+    directory = os.getenv("XDG_RUNTIME_DIR") or os.path.join(tempfile.gettempdir(), f"unreal-mcp-{os.getuid()}")
+    return os.path.join(directory, f"unreal-mcp-{UNREAL_PORT}.sock")
+
+
+# The editor also listens on a Unix domain socket (not on Windows); used when it exists and
+# Unreal is on this machine. Set UNREAL_MCP_UNIX_SOCKET=off to always use TCP.
+UNREAL_UNIX_SOCKET = os.getenv("UNREAL_MCP_UNIX_SOCKET") or _default_unix_socket()
+
+
+def is_private_unix_socket(path: str) -> bool:
+    """True if path is a socket owned by this user, in a directory owned by this user that nobody else can access.
+
+    Anything else may have been planted by another local user to intercept commands.
+    """
+    try:
+        directory = os.lstat(os.path.dirname(os.path.abspath(path)))
+        sock = os.lstat(path)
+    except OSError:
+        return False
+    uid = os.getuid()
+    return (stat.S_ISDIR(directory.st_mode) and directory.st_uid == uid and directory.st_mode & 0o077 == 0
+            and stat.S_ISSOCK(sock.st_mode) and sock.st_uid == uid)
+
+
+# Socket timeouts (seconds) for commands that take longer than the default
+EXTENDED_TIMEOUTS = {"take_highresshot": 30, "capture_sequence": 300}
+# Attempts while the editor answers {"status": "busy"} because its queue for the command is full
+BUSY_ATTEMPTS = 3
+
 class UnrealConnection:
     """Connection to an Unreal Engine instance."""
     
@@ -47,6 +84,11 @@ class UnrealConnection:
                     pass
                 self.socket = None
             
+            if self._connect_unix():
+                self.connected = True
+                logger.info(f"Connected to Unreal Engine at {UNREAL_UNIX_SOCKET}")
+                return True
+
             logger.info(f"Connecting to Unreal at {UNREAL_HOST}:{UNREAL_PORT}...")
             self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
             self.socket.settimeout(5)  # 5 second timeout
@@ -69,6 +111,25 @@ class UnrealConnection:
             self.connected = False
             return False
     
+    def _connect_unix(self) -> bool:
+        """Connect over the editor's Unix domain socket when Unreal runs on this machine."""
+        if (UNREAL_UNIX_SOCKET == "off" or not hasattr(socket, "AF_UNIX")
+                or UNREAL_HOST not in ("127.0.0.1", "localhost") or not os.path.exists(UNREAL_UNIX_SOCKET)):
+            return False
+        if not is_private_unix_socket(UNREAL_UNIX_SOCKET):
+            logger.warning(f"Unix socket {UNREAL_UNIX_SOCKET} or its directory is not private to this user, falling back to TCP")
+            return False
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        sock.settimeout(5)
+        try:
+            sock.connect(UNREAL_UNIX_SOCKET)
+        except OSError as e:
+            logger.warning(f"Unix socket {UNREAL_UNIX_SOCKET} unavailable ({e}), falling back to TCP")
+            sock.close()
+            return False
+        self.socket = sock
+        return True
+
     def disconnect(self):
         """Disconnect from the Unreal Engine instance."""
         if self.socket:
@@ -79,9 +140,48 @@ class UnrealConnection:
         self.socket = None
         self.connected = False
 
+    @staticmethod
+    def _json_document_end(data: bytes) -> int:
+        """Return the offset just past the first complete JSON document in data, or -1.
+
+        Works on raw bytes because binary attachments may follow the JSON on the wire.
+        """
+        depth = 0
+        in_string = False
+        escape = False
+        started = False
+        for index, byte in enumerate(data):
+            if not started:
+                if byte in (0x7B, 0x5B):  # { [
+                    started = True
+                    depth = 1
+                continue
+            if in_string:
+                if escape:
+                    escape = False
+                elif byte == 0x5C:  # backslash
+                    escape = True
+                elif byte == 0x22:  # "
+                    in_string = False
+                continue
+            if byte == 0x22:
+                in_string = True
+            elif byte in (0x7B, 0x5B):
+                depth += 1
+            elif byte in (0x7D, 0x5D):  # } ]
+                depth -= 1
+                if depth == 0:
+                    return index + 1
+        return -1
+
     def receive_full_response(self, sock, buffer_size=4096) -> bytes:
-        """Receive a complete response from Unreal, handling chunked data."""
+        """Receive a complete response from Unreal, handling chunked data.
+
+        Bytes received past the end of the JSON document (attachment data) are kept in
+        self._leftover for receive_attachments().
+        """
         chunks = []
+        self._leftover = b""
         # Use whatever timeout is already set on the socket (don't override it)
         current_timeout = sock.gettimeout()
         logger.debug(f"Using socket timeout: {current_timeout} seconds")
@@ -96,37 +196,44 @@ class UnrealConnection:
                 
                 # Process the data received so far
                 data = b''.join(chunks)
-                decoded_data = data.decode('utf-8')
-                
-                # Try to parse as JSON to check if complete
-                try:
-                    json.loads(decoded_data)
-                    logger.info(f"Received complete response ({len(data)} bytes)")
-                    return data
-                except json.JSONDecodeError:
-                    # Not complete JSON yet, continue reading
-                    logger.debug(f"Received partial response, waiting for more data...")
-                    continue
-                except Exception as e:
-                    logger.warning(f"Error processing response chunk: {str(e)}")
-                    continue
+                end = self._json_document_end(data)
+                if end >= 0:
+                    logger.info(f"Received complete response ({end} bytes)")
+                    self._leftover = data[end:]
+                    return data[:end]
+                logger.debug(f"Received partial response, waiting for more data...")
         except socket.timeout:
             logger.warning("Socket timeout during receive")
-            if chunks:
-                # If we have some data already, try to use it
-                data = b''.join(chunks)
-                try:
-                    json.loads(data.decode('utf-8'))
-                    logger.info(f"Using partial response after timeout ({len(data)} bytes)")
-                    return data
-                except:
-                    pass
             raise Exception("Timeout receiving Unreal response")
         except Exception as e:
             logger.error(f"Error during receive: {str(e)}")
             raise
+        raise Exception("Connection closed before the response was complete")
+
+    def receive_attachments(self, sock, attachments: List[Dict[str, Any]]) -> None:
+        """Read the binary attachments announced by a response and store them as attachment['data']."""
+        pending = self._leftover
+        for attachment in attachments:
+            size = int(attachment["size"])
+            while len(pending) < size:
+                chunk = sock.recv(max(65536, size - len(pending)))
+                if not chunk:
+                    raise Exception("Connection closed while receiving attachment data")
+                pending += chunk
+            attachment["data"], pending = pending[:size], pending[size:]
+        self._leftover = pending
     
     def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
+        """Send a command to Unreal Engine and get the response, backing off while the editor is busy."""
+        for attempt in range(BUSY_ATTEMPTS):
+            response = self._send_command_once(command, params)
+            if not response or response.get("status") != "busy":
+                return response
+            if attempt + 1 < BUSY_ATTEMPTS:
+                time.sleep(response.get("retry_after_ms", 100) / 1000.0)
+        return {"status": "error", "error": response.get("error", "Unreal is busy"), "busy": True}
+
+    def _send_command_once(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
         """Send a command to Unreal Engine and get the response."""
         # Always reconnect for each command, since Unreal closes the connection after each command
         # This is different from Unity which keeps connections alive
@@ -155,26 +262,34 @@ class UnrealConnection:
             self.socket.sendall(command_json.encode('utf-8'))
             
             # Use longer timeout for screenshot commands
-            if command == "take_highresshot":
-                # Screenshot commands can take 15+ seconds for high-res captures
+            extended_timeout = EXTENDED_TIMEOUTS.get(command)
+            if extended_timeout:
+                # High-res captures can take 15+ seconds, a capture_sequence several minutes
                 old_timeout = self.socket.gettimeout()
-                self.socket.settimeout(30)  # 30 second timeout for screenshots
-                logger.info("Set extended 30-second timeout for screenshot command")
+                self.socket.settimeout(extended_timeout)
+                logger.info(f"Set extended {extended_timeout}-second timeout for {command}")
             
             # Read response using improved handler
             response_data = self.receive_full_response(self.socket)
             
             # Restore original timeout if it was changed
-            if command == "take_highresshot":
+            if extended_timeout:
                 self.socket.settimeout(old_timeout)
                 logger.info("Restored original socket timeout")
             response = json.loads(response_data.decode('utf-8'))
             
-            # Log complete response for debugging
+            # Log complete response for debugging (before attachment bytes are added)
             logger.info(f"Complete response from Unreal: {response}")
+
+            # Inline images and other binary payloads follow the JSON on the same socket
+            if response.get("attachments"):
+                self.receive_attachments(self.socket, response["attachments"])
             
             # Check for both error formats: {"status": "error", ...} and {"success": false, ...}
-            if response.get("status") == "error":
+            if response.get("status") == "busy":
+                # The editor's queue for this kind of command is full; nothing was executed
+                logger.warning(f"Unreal busy: {response.get('error')} (retry after {response.get('retry_after_ms')} ms)")
+            elif response.get("status") == "error":
                 error_message = response.get("error") or response.get("message", "Unknown Unreal error")
                 logger.error(f"Unreal error (status=error): {error_message}")
                 # We want to preserve the original error structure but ensure error is accessible
@@ -215,6 +330,17 @@ class UnrealConnection:
                 "error": str(e)
             }
 
+    def send_batch(self, commands: List[Dict[str, Any]], continue_on_error: bool = False) -> Optional[Dict[str, Any]]:
+        """Send several commands in one round trip; Unreal runs them in a single game-thread task.
+
+        Each entry is {"type": ..., "params": {...}}. The result holds one entry per executed
+        command, in order, with its own status.
+        """
+        return self.send_command("batch", {
+            "commands": commands,
+            "continue_on_error": continue_on_error
+        })
+
 # Global connection state
 _unreal_connection: UnrealConnection = None
 
@@ -1,159 +1,550 @@
 #include "Commands/UnrealMCPActorCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "Commands/UnrealMCPCommandContext.h"
+#include "Commands/UnrealMCPActorIndex.h"
+#include "Commands/UnrealMCPWorldResolver.h"
+#include "Commands/UnrealMCPActorQuery.h"
+#include "Commands/UnrealMCPJsonWriter.h"
+#include "Commands/UnrealMCPSpatialIndex.h"
+#include "Commands/UnrealMCPPropertyBindings.h"
+#include "Commands/UnrealMCPConstructionScripts.h"
+#include "Commands/UnrealMCPPropertyAnimator.h"
+#include "Commands/UnrealMCPSubscriptions.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Character.h"
+#include "Components/PrimitiveComponent.h"
 #include "Components/PointLightComponent.h"
+#include "Math/Interval.h"
 #include "Engine/PointLight.h"
 
+namespace
+{
+	// How far a raycast given only a direction reaches, in cm
+	constexpr double DefaultRaycastDistance = 100000.0;
+
+	TArray<TSharedPtr<FJsonValue>> MakeVectorArray(const FVector& Vector)
+	{
+		return { MakeShared<FJsonValueNumber>(Vector.X), MakeShared<FJsonValueNumber>(Vector.Y), MakeShared<FJsonValueNumber>(Vector.Z) };
+	}
+
+	/** Writes the hits that pass the query's filters, up to its limit, each with its distance. */
+	TSharedPtr<FJsonObject> MakeSpatialResult(const FUnrealMCPActorQuery& Query, const TArray<FUnrealMCPSpatialHit>& Hits, double StartTime)
+	{
+		TArray<uint8> ActorsJson;
+		FUnrealMCPJsonWriter Writer(ActorsJson);
+		int32 Count = 0;
+		int32 Total = 0;
+		Writer.BeginArray();
+		for (const FUnrealMCPSpatialHit& Hit : Hits)
+		{
+			if (!Query.Matches(Hit.Actor))
+			{
+				continue;
+			}
+			++Total;
+			if (Query.Limit > 0 && Count >= Query.Limit)
+			{
+				continue;
+			}
+			Writer.BeginObject();
+			Query.WriteFields(Writer, Hit.Actor);
+			Writer.WriteField(TEXT("distance"), Hit.Distance);
+			Writer.EndObject();
+			++Count;
+		}
+		Writer.EndArray();
+
+		TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+		ResultObj->SetField(TEXT("actors"), MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(ActorsJson)));
+		ResultObj->SetNumberField(TEXT("count"), Count);
+		ResultObj->SetNumberField(TEXT("total"), Total);
+		ResultObj->SetNumberField(TEXT("game_thread_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return ResultObj;
+	}
+}
+
 FUnrealMCPActorCommands::FUnrealMCPActorCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPActorCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
+{
+	Registry.Register(TEXT("get_actors_in_level"), this, &FUnrealMCPActorCommands::HandleGetActorsInLevel, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
+	Registry.RegisterStreaming(TEXT("stream_actors_in_level"), this, &FUnrealMCPActorCommands::HandleStreamActorsInLevel, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
+	Registry.Register(TEXT("find_actors_by_name"), this, &FUnrealMCPActorCommands::HandleFindActorsByName, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
+	Registry.Register(TEXT("get_scene_delta"), this, &FUnrealMCPActorCommands::HandleGetSceneDelta, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
+	Registry.Register(TEXT("create_actor"), this, &FUnrealMCPActorCommands::HandleCreateActor);
+	Registry.Register(TEXT("delete_actor"), this, &FUnrealMCPActorCommands::HandleDeleteActor);
+	Registry.Register(TEXT("set_actor_transform"), this, &FUnrealMCPActorCommands::HandleSetActorTransform);
+	Registry.Register(TEXT("get_actor_properties"), this, &FUnrealMCPActorCommands::HandleGetActorProperties, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("select_visible_actors"), this, &FUnrealMCPActorCommands::HandleSelectVisibleActors, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
+	Registry.Register(TEXT("get_character_actors"), this, &FUnrealMCPActorCommands::HandleGetCharacterActors, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("query_actors_in_radius"), this, &FUnrealMCPActorCommands::HandleQueryActorsInRadius, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("query_actors_in_frustum"), this, &FUnrealMCPActorCommands::HandleQueryActorsInFrustum, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
+	Registry.Register(TEXT("raycast"), this, &FUnrealMCPActorCommands::HandleRaycast, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("get_properties"), this, &FUnrealMCPActorCommands::HandleGetProperties, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("set_properties"), this, &FUnrealMCPActorCommands::HandleSetProperties);
+	Registry.Register(TEXT("set_time_of_day"), this, &FUnrealMCPActorCommands::HandleSetTimeOfDay);
+	Registry.Register(TEXT("get_ultra_dynamic_sky"), this, &FUnrealMCPActorCommands::HandleGetUltraDynamicSkyProperties, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("get_ultra_dynamic_weather"), this, &FUnrealMCPActorCommands::HandleGetUltraDynamicWeather, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("set_current_weather_to_rain"), this, &FUnrealMCPActorCommands::HandleSetCurrentWeatherToRain);
+	Registry.Register(TEXT("set_color_temperature"), this, &FUnrealMCPActorCommands::HandleSetColorTemperature);
+	Registry.Register(TEXT("set_cesium_latitude_longitude"), this, &FUnrealMCPActorCommands::HandleSetCesiumLatitudeLongitude);
+	Registry.Register(TEXT("get_cesium_properties"), this, &FUnrealMCPActorCommands::HandleGetCesiumProperties, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.RegisterStreaming(TEXT("animate_property"), this, &FUnrealMCPActorCommands::HandleAnimateProperty);
+	Registry.Register(TEXT("stop_animation"), this, &FUnrealMCPActorCommands::HandleStopAnimation);
+	Registry.RegisterStreaming(TEXT("subscribe"), this, &FUnrealMCPActorCommands::HandleSubscribe, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("unsubscribe"), this, &FUnrealMCPActorCommands::HandleUnsubscribe, EUnrealMCPCommandFlags::ReadOnly);
+	Registry.Register(TEXT("create_mm_control_light"), this, &FUnrealMCPActorCommands::HandleCreateMMControlLight);
+	Registry.Register(TEXT("get_mm_control_lights"), this, &FUnrealMCPActorCommands::HandleGetMMControlLights, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
+	Registry.Register(TEXT("update_mm_control_light"), this, &FUnrealMCPActorCommands::HandleUpdateMMControlLight, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::Medium);
+	Registry.Register(TEXT("delete_mm_control_light"), this, &FUnrealMCPActorCommands::HandleDeleteMMControlLight, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::Medium);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
 {
-	if (CommandType == TEXT("get_actors_in_level"))
+	FUnrealMCPActorQuery Query;
+	FString ParamError;
+	if (!FUnrealMCPActorQuery::Parse(Params, Query, ParamError))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+	}
+
+	UWorld* World = GetCurrentWorld();
+	if (!World)
 	{
-		return HandleGetActorsInLevel(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
 	}
-	else if (CommandType == TEXT("find_actors_by_name"))
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<uint8> ActorsJson;
+	FUnrealMCPJsonWriter Writer(ActorsJson);
+	FUnrealMCPActorCursor Cursor = Query.Cursor;
+	int32 Count = 0;
+	Writer.BeginArray();
+	const bool bMore = Query.CollectPage(World, Cursor, Query.Limit, Writer, Count);
+	Writer.EndArray();
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetField(TEXT("actors"), MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(ActorsJson)));
+	ResultObj->SetNumberField(TEXT("count"), Count);
+	if (bMore)
 	{
-		return HandleFindActorsByName(Params);
+		ResultObj->SetStringField(TEXT("next_cursor"), Cursor.ToString());
 	}
-	else if (CommandType == TEXT("create_actor"))
+	// Where get_scene_delta picks up; only the first page's value is safe to use
+	if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
 	{
-		return HandleCreateActor(Params);
+		ResultObj->SetNumberField(TEXT("generation"), (double)Index->GetGeneration(World));
 	}
-	else if (CommandType == TEXT("delete_actor"))
+	ResultObj->SetNumberField(TEXT("game_thread_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	
+	return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetSceneDelta(const TSharedPtr<FJsonObject>& Params)
+{
+	// Same filters and fields as get_actors_in_level; deltas are never paged
+	FUnrealMCPActorQuery Query;
+	FString ParamError;
+	if (!FUnrealMCPActorQuery::Parse(Params, Query, ParamError))
 	{
-		return HandleDeleteActor(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
 	}
-	else if (CommandType == TEXT("set_actor_transform"))
+
+	double Since = 0.0;
+	Params->TryGetNumberField(TEXT("since_generation"), Since);
+	if (Since < 0.0)
 	{
-		return HandleSetActorTransform(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("since_generation must not be negative"));
 	}
-	else if (CommandType == TEXT("get_actor_properties"))
+
+	UWorld* World = GetCurrentWorld();
+	if (!World)
 	{
-		return HandleGetActorProperties(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
 	}
-	else if (CommandType == TEXT("set_time_of_day"))
+
+	const double StartTime = FPlatformTime::Seconds();
+	UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get();
+	FUnrealMCPSceneDelta Delta;
+	if (!Index || !Index->GetSceneDelta(World, (uint64)Since, Delta))
 	{
-		return HandleSetTimeOfDay(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Scene deltas need the editor actor index"));
 	}
-	else if (CommandType == TEXT("get_ultra_dynamic_sky"))
+
+	// An actor that stops matching (e.g. moves out of bounds) just stops being reported
+	auto WriteActors = [&Query](const TArray<FUnrealMCPVersionedActor>& Actors, int32& OutCount)
+	{
+		TArray<uint8> ActorsJson;
+		FUnrealMCPJsonWriter Writer(ActorsJson);
+		Writer.BeginArray();
+		for (const FUnrealMCPVersionedActor& Versioned : Actors)
+		{
+			if (!Query.Matches(Versioned.Actor))
+			{
+				continue;
+			}
+			Writer.BeginObject();
+			Query.WriteFields(Writer, Versioned.Actor);
+			Writer.WriteField(TEXT("version"), (int64)Versioned.Version);
+			Writer.EndObject();
+			++OutCount;
+		}
+		Writer.EndArray();
+		return MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(ActorsJson));
+	};
+
+	int32 NumSpawned = 0;
+	int32 NumChanged = 0;
+	TArray<TSharedPtr<FJsonValue>> DeletedJson;
+	for (const FName& Name : Delta.Deleted)
 	{
-		return HandleGetUltraDynamicSkyProperties(Params);
+		DeletedJson.Add(MakeShared<FJsonValueString>(Name.ToString()));
 	}
-	else if (CommandType == TEXT("get_ultra_dynamic_weather"))
+
+	// Clients apply deleted before spawned: a name can be deleted and reused in one delta
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetNumberField(TEXT("generation"), (double)Delta.Generation);
+	ResultObj->SetNumberField(TEXT("since_generation"), Since);
+	ResultObj->SetBoolField(TEXT("reset"), Delta.bReset);
+	ResultObj->SetField(TEXT("spawned"), WriteActors(Delta.Spawned, NumSpawned));
+	ResultObj->SetField(TEXT("changed"), WriteActors(Delta.Changed, NumChanged));
+	ResultObj->SetArrayField(TEXT("deleted"), DeletedJson);
+	ResultObj->SetNumberField(TEXT("count"), NumSpawned + NumChanged + DeletedJson.Num());
+	ResultObj->SetNumberField(TEXT("game_thread_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return ResultObj;
+}
+
+void FUnrealMCPActorCommands::HandleStreamActorsInLevel(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete)
+{
+	FUnrealMCPActorQuery Query;
+	FString ParamError;
+	if (!FUnrealMCPActorQuery::Parse(Params, Query, ParamError))
 	{
-		return HandleGetUltraDynamicWeather(Params);
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(ParamError), {});
+		return;
 	}
-	else if (CommandType == TEXT("set_current_weather_to_rain"))
+
+	UWorld* World = GetCurrentWorld();
+	if (!World)
 	{
-		return HandleSetCurrentWeatherToRain(Params);
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context")), {});
+		return;
 	}
-	else if (CommandType == TEXT("set_color_temperature"))
+
+	FUnrealMCPActorStream::Start(World, Query, MoveTemp(OnProgress), MoveTemp(OnComplete));
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
+{
+	FString Pattern;
+	if (!Params->TryGetStringField(TEXT("pattern"), Pattern))
 	{
-		return HandleSetColorTemperature(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
 	}
-	else if (CommandType == TEXT("set_cesium_latitude_longitude"))
+	
+	UWorld* World = GetCurrentWorld();
+	if (!World)
 	{
-		return HandleSetCesiumLatitudeLongitude(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
 	}
-	else if (CommandType == TEXT("get_cesium_properties"))
+	
+	// Default fields are exactly what ActorToJson produced
+	const FUnrealMCPActorQuery Query;
+	TArray<uint8> MatchingJson;
+	FUnrealMCPJsonWriter Writer(MatchingJson);
+	Writer.BeginArray();
+	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
-		return HandleGetCesiumProperties(Params);
+		AActor* Actor = *ActorItr;
+		if (Actor && IsValid(Actor) && Actor->GetName().Contains(Pattern))
+		{
+			Query.Write(Writer, Actor);
+		}
 	}
-	else if (CommandType == TEXT("create_mm_control_light"))
+	Writer.EndArray();
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetField(TEXT("actors"), MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(MatchingJson)));
+	
+	return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleSelectVisibleActors(const TSharedPtr<FJsonObject>& Params)
+{
+	return QueryActorsInView(Params, true);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleQueryActorsInFrustum(const TSharedPtr<FJsonObject>& Params)
+{
+	return QueryActorsInView(Params, false);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::QueryActorsInView(const TSharedPtr<FJsonObject>& Params, bool bVisibleOnly)
+{
+	FUnrealMCPActorQuery Query;
+	FString ParamError;
+	if (!FUnrealMCPActorQuery::Parse(Params, Query, ParamError))
 	{
-		return HandleCreateMMControlLight(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
 	}
-	else if (CommandType == TEXT("get_mm_control_lights"))
+
+	UWorld* World = GetCurrentWorld();
+	if (!World)
 	{
-		return HandleGetMMControlLights(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
 	}
-	else if (CommandType == TEXT("update_mm_control_light"))
+
+	// An explicit camera overrides the current view; select_visible_actors always uses the view
+	FUnrealMCPSpatialView View;
+	const bool bExplicitCamera = !bVisibleOnly && Params->HasField(TEXT("location")) && Params->HasField(TEXT("rotation"));
+	if (!bExplicitCamera && !FUnrealMCPSpatialView::FromWorld(World, View, ParamError))
 	{
-		return HandleUpdateMMControlLight(Params);
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
 	}
-	else if (CommandType == TEXT("delete_mm_control_light"))
+	if (!bVisibleOnly)
 	{
-		return HandleDeleteMMControlLight(Params);
+		if (Params->HasField(TEXT("location")))
+		{
+			View.Location = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location"));
+		}
+		if (Params->HasField(TEXT("rotation")))
+		{
+			View.Rotation = FUnrealMCPCommonUtils::GetRotatorFromJson(Params, TEXT("rotation"));
+		}
+		double FOV = 0.0;
+		if (Params->TryGetNumberField(TEXT("fov"), FOV))
+		{
+			View.FOV = (float)FOV;
+		}
+		double AspectRatio = 0.0;
+		if (Params->TryGetNumberField(TEXT("aspect_ratio"), AspectRatio) && AspectRatio > 0.0)
+		{
+			View.AspectRatio = (float)AspectRatio;
+		}
 	}
-	
-	
-	return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown actor command: %s"), *CommandType));
+	Params->TryGetNumberField(TEXT("max_distance"), View.MaxDistance);
+	View.BuildFrustum();
+
+	bool bRenderedOnly = false;
+	Params->TryGetBoolField(TEXT("rendered"), bRenderedOnly);
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FUnrealMCPSpatialHit> Hits;
+	QuerySpatialIndex(World, [&View, &Hits](const FUnrealMCPSpatialIndex& Spatial)
+	{
+		Spatial.FindInFrustum(View.Frustum, View.Location, Hits);
+	});
+
+	if (bVisibleOnly)
+	{
+		const bool bGameWorld = World->IsGameWorld();
+		Hits.RemoveAll([bGameWorld, bRenderedOnly](const FUnrealMCPSpatialHit& Hit)
+		{
+			const bool bHidden = bGameWorld ? Hit.Actor->IsHidden() : Hit.Actor->IsHiddenEd();
+			// Rendered means it passed occlusion culling within the last few frames
+			return bHidden || (bRenderedOnly && !Hit.Actor->WasRecentlyRendered(0.2f));
+		});
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeSpatialResult(Query, Hits, StartTime);
+	TSharedPtr<FJsonObject> ViewObj = MakeShared<FJsonObject>();
+	ViewObj->SetArrayField(TEXT("location"), MakeVectorArray(View.Location));
+	ViewObj->SetArrayField(TEXT("rotation"), MakeVectorArray(FVector(View.Rotation.Pitch, View.Rotation.Yaw, View.Rotation.Roll)));
+	ViewObj->SetNumberField(TEXT("fov"), View.FOV);
+	ViewObj->SetNumberField(TEXT("aspect_ratio"), View.AspectRatio);
+	ResultObj->SetObjectField(TEXT("view"), ViewObj);
+	return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetCharacterActors(const TSharedPtr<FJsonObject>& Params)
 {
-	// Get the world - runtime compatible way
+	FUnrealMCPActorQuery Query;
+	FString ParamError;
+	if (!FUnrealMCPActorQuery::Parse(Params, Query, ParamError))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+	}
+
 	UWorld* World = GetCurrentWorld();
 	if (!World)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
 	}
-	TArray<AActor*> AllActors;
-	// Use runtime-compatible actor iteration
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+
+	const bool bHasLocation = Params->HasField(TEXT("location"));
+	const FVector Location = bHasLocation ? FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location")) : FVector::ZeroVector;
+	double Radius = 0.0;
+	Params->TryGetNumberField(TEXT("radius"), Radius);
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FUnrealMCPSpatialHit> Hits;
+	if (bHasLocation && Radius > 0.0)
 	{
-		AActor* Actor = *ActorItr;
-		if (Actor && IsValid(Actor))
+		QuerySpatialIndex(World, [&Location, Radius, &Hits](const FUnrealMCPSpatialIndex& Spatial)
 		{
-			AllActors.Add(Actor);
-		}
+			Spatial.FindInSphere(Location, Radius, Hits);
+		});
+		Hits.RemoveAll([](const FUnrealMCPSpatialHit& Hit) { return !Hit.Actor->IsA<ACharacter>(); });
 	}
-	
-	TArray<TSharedPtr<FJsonValue>> ActorArray;
-	for (AActor* Actor : AllActors)
+	else
 	{
-		if (Actor)
+		// The class-filtered iterator only visits characters, not the whole world
+		for (TActorIterator<ACharacter> CharacterItr(World); CharacterItr; ++CharacterItr)
 		{
-			ActorArray.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+			ACharacter* Character = *CharacterItr;
+			if (IsValid(Character))
+			{
+				Hits.Add({ Character, bHasLocation ? FVector::Dist(Location, Character->GetActorLocation()) : 0.0 });
+			}
+		}
+		if (bHasLocation)
+		{
+			Hits.Sort([](const FUnrealMCPSpatialHit& A, const FUnrealMCPSpatialHit& B) { return A.Distance < B.Distance; });
 		}
 	}
-	
-	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-	ResultObj->SetArrayField(TEXT("actors"), ActorArray);
-	
-	return ResultObj;
+
+	return MakeSpatialResult(Query, Hits, StartTime);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleQueryActorsInRadius(const TSharedPtr<FJsonObject>& Params)
 {
-	FString Pattern;
-	if (!Params->TryGetStringField(TEXT("pattern"), Pattern))
+	FUnrealMCPActorQuery Query;
+	FString ParamError;
+	if (!FUnrealMCPActorQuery::Parse(Params, Query, ParamError))
 	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
 	}
-	
-	// Get the world - runtime compatible way
-	UWorld* World = nullptr;
-	
-	if (GEngine && GEngine->GetWorldContexts().Num() > 0)
+
+	double Radius = 0.0;
+	if (!Params->HasField(TEXT("location")) || !Params->TryGetNumberField(TEXT("radius"), Radius))
 	{
-		World = GEngine->GetWorldContexts()[1].World();
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'location' or 'radius' parameter"));
 	}
-	
+	if (Radius < 0.0)
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'radius' must not be negative"));
+	}
+	const FVector Location = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location"));
+
+	UWorld* World = GetCurrentWorld();
 	if (!World)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
 	}
-	
-	TArray<TSharedPtr<FJsonValue>> MatchingActors;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FUnrealMCPSpatialHit> Hits;
+	QuerySpatialIndex(World, [&Location, Radius, &Hits](const FUnrealMCPSpatialIndex& Spatial)
 	{
-		AActor* Actor = *ActorItr;
-		if (Actor && IsValid(Actor) && Actor->GetName().Contains(Pattern))
+		Spatial.FindInSphere(Location, Radius, Hits);
+	});
+
+	return MakeSpatialResult(Query, Hits, StartTime);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleRaycast(const TSharedPtr<FJsonObject>& Params)
+{
+	if (!Params->HasField(TEXT("start")))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'start' parameter"));
+	}
+	const FVector Start = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("start"));
+
+	FVector End;
+	if (Params->HasField(TEXT("end")))
+	{
+		End = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("end"));
+	}
+	else if (Params->HasField(TEXT("direction")))
+	{
+		double Distance = DefaultRaycastDistance;
+		Params->TryGetNumberField(TEXT("distance"), Distance);
+		End = Start + FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("direction")).GetSafeNormal() * Distance;
+	}
+	else
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'end' or 'direction' parameter"));
+	}
+
+	FString Against = TEXT("collision");
+	Params->TryGetStringField(TEXT("against"), Against);
+	const bool bAgainstBounds = Against.Equals(TEXT("bounds"), ESearchCase::IgnoreCase);
+	if (!bAgainstBounds && !Against.Equals(TEXT("collision"), ESearchCase::IgnoreCase))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown 'against' value '%s', expected 'collision' or 'bounds'"), *Against));
+	}
+
+	FUnrealMCPActorQuery Query;
+	FString ParamError;
+	if (!FUnrealMCPActorQuery::Parse(Params, Query, ParamError))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+	}
+
+	UWorld* World = GetCurrentWorld();
+	if (!World)
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (bAgainstBounds)
+	{
+		// Every actor whose bounds the segment crosses, including ones without collision
+		TArray<FUnrealMCPSpatialHit> Hits;
+		QuerySpatialIndex(World, [&Start, &End, &Hits](const FUnrealMCPSpatialIndex& Spatial)
 		{
-			MatchingActors.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
-		}
+			Spatial.FindAlongRay(Start, End, Hits);
+		});
+		return MakeSpatialResult(Query, Hits, StartTime);
 	}
-	
+
+	// The physics scene keeps its own acceleration structure, so a trace is already sublinear
+	bool bTraceComplex = false;
+	Params->TryGetBoolField(TEXT("trace_complex"), bTraceComplex);
+	FHitResult Hit;
+	const bool bHit = World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, FCollisionQueryParams(SCENE_QUERY_STAT(UnrealMCPRaycast), bTraceComplex));
+
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-	ResultObj->SetArrayField(TEXT("actors"), MatchingActors);
-	
+	ResultObj->SetBoolField(TEXT("hit"), bHit);
+	if (bHit)
+	{
+		if (AActor* HitActor = Hit.GetActor())
+		{
+			TArray<uint8> ActorJson;
+			FUnrealMCPJsonWriter Writer(ActorJson);
+			Query.Write(Writer, HitActor);
+			ResultObj->SetField(TEXT("actor"), MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(ActorJson)));
+		}
+		if (UPrimitiveComponent* HitComponent = Hit.GetComponent())
+		{
+			ResultObj->SetStringField(TEXT("component"), HitComponent->GetName());
+		}
+		ResultObj->SetArrayField(TEXT("location"), MakeVectorArray(Hit.ImpactPoint));
+		ResultObj->SetArrayField(TEXT("normal"), MakeVectorArray(Hit.ImpactNormal));
+		ResultObj->SetNumberField(TEXT("distance"), Hit.Distance);
+	}
+	ResultObj->SetNumberField(TEXT("game_thread_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 	return ResultObj;
 }
 
+void FUnrealMCPActorCommands::QuerySpatialIndex(UWorld* World, TFunctionRef<void(const FUnrealMCPSpatialIndex&)> Query)
+{
+	UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get();
+	if (FUnrealMCPSpatialIndex* Spatial = Index ? Index->GetSpatialIndex(World) : nullptr)
+	{
+		Query(*Spatial);
+		return;
+	}
+
+	// No index to keep a tree alive between queries; build a throwaway one
+	const FUnrealMCPSpatialIndex Throwaway(World);
+	Query(Throwaway);
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleCreateActor(const TSharedPtr<FJsonObject>& Params)
 {
 	// Get required parameters
@@ -191,32 +582,14 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleCreateActor(const TShared
 	// Create the actor based on type
 	AActor* NewActor = nullptr;
 	
-	// Get the world - runtime compatible way
-	UWorld* World = nullptr;
-	
-	if (GEngine && GEngine->GetWorldContexts().Num() > 0)
-	{
-		World = GEngine->GetWorldContexts()[1].World();
-	}
-
+	UWorld* World = GetCurrentWorld();
 	if (!World)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context"));
 	}
 
-	// Check if an actor with this name already exists - runtime compatible way
-	bool bNameExists = false;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		AActor* Actor = *ActorItr;
-		if (Actor && IsValid(Actor) && Actor->GetName() == ActorName)
-		{
-			bNameExists = true;
-			break;
-		}
-	}
-	
-	if (bNameExists)
+	// Check if an actor with this name already exists
+	if (FindActorByName(World, ActorName))
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
 	}
@@ -261,6 +634,11 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleCreateActor(const TShared
 		FTransform Transform = NewActor->GetTransform();
 		Transform.SetScale3D(Scale);
 		NewActor->SetActorTransform(Transform);
+		if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
+		{
+			// Spawn notifications fire before the scale is applied
+			Index->UpdateActorBounds(NewActor);
+		}
 
 		// Return the created actor's details
 		return FUnrealMCPCommonUtils::ActorToJsonObject(NewActor, true);
@@ -277,29 +655,14 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleDeleteActor(const TShared
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
 	}
 
-	// Get world in runtime-compatible way
-	UWorld* World = nullptr;
-	if (GEngine && GEngine->GetWorldContexts().Num() > 0)
-	{
-		World = GEngine->GetWorldContexts()[1].World();
-	}
+	UWorld* World = GetCurrentWorld();
 
 	if (!IsValid(World))
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get valid world"));
 	}
 
-	// Find the actor using runtime-compatible iteration
-	AActor* ActorToDelete = nullptr;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		AActor* Actor = *ActorItr;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			ActorToDelete = Actor;
-			break;
-		}
-	}
+	AActor* ActorToDelete = FindActorByName(World, ActorName);
 
 	if (!ActorToDelete)
 	{
@@ -335,29 +698,14 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleSetActorTransform(const T
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
 	}
 
-	// Get world in runtime-compatible way
-	UWorld* World = nullptr;
-	if (GEngine && GEngine->GetWorldContexts().Num() > 0)
-	{
-		World = GEngine->GetWorldContexts()[1].World();
-	}
+	UWorld* World = GetCurrentWorld();
 
 	if (!IsValid(World))
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get valid world"));
 	}
 
-	// Find the actor using runtime-compatible iteration
-	AActor* TargetActor = nullptr;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		AActor* Actor = *ActorItr;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			TargetActor = Actor;
-			break;
-		}
-	}
+	AActor* TargetActor = FindActorByName(World, ActorName);
 
 	if (!TargetActor)
 	{
@@ -382,6 +730,10 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleSetActorTransform(const T
 
 	// Set the new transform
 	TargetActor->SetActorTransform(NewTransform);
+	if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
+	{
+		Index->UpdateActorBounds(TargetActor);
+	}
 
 	// Return updated actor info
 	return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
@@ -396,29 +748,14 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetActorProperties(const
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
 	}
 
-	// Get world in runtime-compatible way
-	UWorld* World = nullptr;
-	if (GEngine && GEngine->GetWorldContexts().Num() > 0)
-	{
-		World = GEngine->GetWorldContexts()[1].World();
-	}
+	UWorld* World = GetCurrentWorld();
 
 	if (!IsValid(World))
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get valid world"));
 	}
 
-	// Find the actor using runtime-compatible iteration
-	AActor* TargetActor = nullptr;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		AActor* Actor = *ActorItr;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			TargetActor = Actor;
-			break;
-		}
-	}
+	AActor* TargetActor = FindActorByName(World, ActorName);
 
 	if (!TargetActor)
 	{
@@ -432,34 +769,7 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetActorProperties(const
 // common helper function
 UWorld* FUnrealMCPActorCommands::GetCurrentWorld()
 {
-	UWorld* World = nullptr;
-	if (GEngine && GEngine->GetWorldContexts().Num() > 0)
-	{
-		int32 CurrentWorldIndex = 0;
-		int32 WorldCount = GEngine->GetWorldContexts().Num();
-		for (int32 i = 0; i < WorldCount; ++i)
-		{
-			const FWorldContext& WorldContext = GEngine->GetWorldContexts()[i];
-			UWorld* TestWorld = WorldContext.World();
-			
-			// Skip invalid worlds
-			if (!TestWorld || !IsValid(TestWorld))
-			{
-				continue;
-			}
-			
-			// Find world with most actors (prefer game worlds over editor worlds)
-			int32 TestActorCount = TestWorld->GetActorCount();
-			UWorld* CurrentWorld = GEngine->GetWorldContexts()[CurrentWorldIndex].World();
-			
-			if (CurrentWorld && TestActorCount > CurrentWorld->GetActorCount())
-			{
-				CurrentWorldIndex = i;
-			}
-		}
-		World = GEngine->GetWorldContexts()[CurrentWorldIndex].World();
-	}
-	return World;
+	return FUnrealMCPWorldResolver::Get().Resolve();
 }
 
 AActor* FUnrealMCPActorCommands::FindActorByClassName(const FString& ClassName)
@@ -470,76 +780,226 @@ AActor* FUnrealMCPActorCommands::FindActorByClassName(const FString& ClassName)
 		FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get valid world"));
 		return nullptr;
 	}
-	AActor* Actor = nullptr;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+
+	FUnrealMCPCommandContext* Context = FUnrealMCPCommandContext::Get();
+	if (Context)
 	{
-		AActor* CurrentActor = *ActorItr;
-		if (CurrentActor && CurrentActor->GetClass()->GetName() == ClassName)
+		// Sub-commands of one batch may pin different worlds
+		AActor* CachedActor = Context->GetCachedActorByClass(ClassName);
+		if (CachedActor && CachedActor->GetWorld() == World)
 		{
-			Actor = CurrentActor;
-			break;
+			return CachedActor;
 		}
 	}
+
+	// FNAME_Find keeps client input out of the name table; a name that was never created matches no class
+	const FName ClassFName(*ClassName, FNAME_Find);
+	if (ClassFName.IsNone())
+	{
+		return nullptr;
+	}
+
+	AActor* Actor = FUnrealMCPPropertyBindings::Get().FindActorOfClass(World, ClassFName);
+	if (Context && Actor)
+	{
+		Context->SetCachedActorByClass(ClassName, Actor);
+	}
 	return Actor;
 }
 
-bool FUnrealMCPActorCommands::GetDoublePropertyValue(AActor* Actor, const FName& PropertyName, float& OutValue)
+AActor* FUnrealMCPActorCommands::FindActorByName(UWorld* World, const FString& ActorName)
 {
-	if (!Actor)
+	if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
 	{
-		FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Actor not found"));
-		return false;
+		const FName Name(*ActorName, FNAME_Find);
+		return Name.IsNone() ? nullptr : Index->FindActorByName(World, Name);
 	}
-	UClass* ActorClass = Actor->GetClass();
-	if (!ActorClass)
+
+	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
-		FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get actor class"));
-		return false;
+		AActor* Actor = *ActorItr;
+		if (Actor && IsValid(Actor) && Actor->GetName() == ActorName)
+		{
+			return Actor;
+		}
 	}
-	FProperty* FoundProperty = ActorClass->FindPropertyByName(PropertyName);
-	if (!FoundProperty)
+	return nullptr;
+}
+
+void FUnrealMCPActorCommands::FindActorsWithTag(UWorld* World, const FName& Tag, TArray<AActor*>& OutActors)
+{
+	if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
 	{
-		FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Property not found in %s"), *Actor->GetName()));
-		return false;
+		Index->FindActorsWithTag(World, Tag, OutActors);
+		return;
 	}
-	float DoubleValue = 0.0f;
-	if (FDoubleProperty* DoubleProp = CastField<FDoubleProperty>(FoundProperty))
+
+	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
 	{
-		DoubleValue = DoubleProp->GetPropertyValue_InContainer(Actor);
+		AActor* Actor = *ActorItr;
+		if (Actor && IsValid(Actor) && Actor->Tags.Contains(Tag))
+		{
+			OutActors.Add(Actor);
+		}
 	}
-	else
+}
+
+bool FUnrealMCPActorCommands::GetDoublePropertyValue(AActor* Actor, const FName& PropertyName, double& OutValue)
+{
+	FString Error;
+	if (!FUnrealMCPPropertyBindings::Get().GetDouble(Actor, PropertyName, OutValue, Error))
 	{
-		FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Property '%s' is not a float"), *FoundProperty->GetName()));
+		UE_LOG(LogTemp, Warning, TEXT("UnrealMCP: %s"), *Error);
 		return false;
 	}
-	OutValue = DoubleValue;
 	return true;
 }
 
-bool FUnrealMCPActorCommands::UpdateDoubleProperty(AActor* Actor, const FName& PropertyName, float NewValue)
+bool FUnrealMCPActorCommands::UpdateDoubleProperty(AActor* Actor, const FName& PropertyName, double NewValue)
 {
-	if (!Actor)
+	FString Error;
+	if (!FUnrealMCPPropertyBindings::Get().SetDouble(Actor, PropertyName, NewValue, Error))
 	{
-		FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Ultra Dynamic Sky actor not found"));
+		UE_LOG(LogTemp, Warning, TEXT("UnrealMCP: %s"), *Error);
 		return false;
 	}
-	UClass* ActorClass = Actor->GetClass();
-	FProperty* Property = ActorClass->FindPropertyByName(PropertyName);
-	if (!Property)
+
+	// Writes to the same actor in this batch or frame share one rebuild
+	FUnrealMCPConstructionScripts::Get().Request(Actor);
+	return true;
+}
+
+AActor* FUnrealMCPActorCommands::FindPropertyTarget(const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+	FString ActorName;
+	FString ActorClass;
+	if (Params->TryGetStringField(TEXT("actor_name"), ActorName))
 	{
-		return false;
+		UWorld* World = GetCurrentWorld();
+		AActor* Actor = World ? FindActorByName(World, ActorName) : nullptr;
+		if (!Actor)
+		{
+			OutError = FString::Printf(TEXT("Actor not found: %s"), *ActorName);
+		}
+		return Actor;
 	}
+	if (Params->TryGetStringField(TEXT("actor_class"), ActorClass))
+	{
+		AActor* Actor = FindActorByClassName(ActorClass);
+		if (!Actor)
+		{
+			OutError = FString::Printf(TEXT("No actor of class %s"), *ActorClass);
+		}
+		return Actor;
+	}
+
+	OutError = TEXT("Missing 'actor_name' or 'actor_class' parameter");
+	return nullptr;
+}
 
-	if (FDoubleProperty* DoubleProp = CastField<FDoubleProperty>(Property))
+// Client-supplied property names are looked up without adding them to the name table;
+// a name that was never registered can't be a property of anything
+static FName FindPropertyName(const FString& PropertyName, const AActor* Actor, FString& OutError)
+{
+	const FName Name(*PropertyName, FNAME_Find);
+	if (Name.IsNone())
 	{
-		DoubleProp->SetPropertyValue_InContainer(Actor, NewValue);
+		OutError = FString::Printf(TEXT("Property '%s' not found in %s"), *PropertyName, *Actor->GetName());
 	}
+	return Name;
+}
 
-	if (Actor->IsA<AActor>())
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetProperties(const TSharedPtr<FJsonObject>& Params)
+{
+	const TArray<TSharedPtr<FJsonValue>>* PropertyNames = nullptr;
+	if (!Params->TryGetArrayField(TEXT("properties"), PropertyNames))
 	{
-		Actor->RerunConstructionScripts();
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'properties' parameter"));
 	}
-	return true;
+
+	FString Error;
+	AActor* Actor = FindPropertyTarget(Params, Error);
+	if (!Actor)
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+	}
+
+	FUnrealMCPPropertyBindings& Bindings = FUnrealMCPPropertyBindings::Get();
+	TSharedPtr<FJsonObject> ValuesObj = MakeShared<FJsonObject>();
+	TSharedPtr<FJsonObject> ErrorsObj = MakeShared<FJsonObject>();
+	for (const TSharedPtr<FJsonValue>& NameValue : *PropertyNames)
+	{
+		const FString PropertyName = NameValue->AsString();
+		const FName Name = FindPropertyName(PropertyName, Actor, Error);
+		if (TSharedPtr<FJsonValue> Value = Name.IsNone() ? nullptr : Bindings.GetValue(Actor, Name, Error))
+		{
+			ValuesObj->SetField(PropertyName, Value);
+		}
+		else
+		{
+			ErrorsObj->SetStringField(PropertyName, Error);
+		}
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetStringField(TEXT("actor_name"), Actor->GetName());
+	ResultObj->SetObjectField(TEXT("properties"), ValuesObj);
+	if (ErrorsObj->Values.Num() > 0)
+	{
+		ResultObj->SetObjectField(TEXT("errors"), ErrorsObj);
+	}
+	return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleSetProperties(const TSharedPtr<FJsonObject>& Params)
+{
+	const TSharedPtr<FJsonObject>* PropertyValues = nullptr;
+	if (!Params->TryGetObjectField(TEXT("properties"), PropertyValues))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'properties' parameter"));
+	}
+
+	FString Error;
+	AActor* Actor = FindPropertyTarget(Params, Error);
+	if (!Actor)
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+	}
+
+	FUnrealMCPPropertyBindings& Bindings = FUnrealMCPPropertyBindings::Get();
+	TArray<TSharedPtr<FJsonValue>> Updated;
+	TSharedPtr<FJsonObject> ErrorsObj = MakeShared<FJsonObject>();
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Property : (*PropertyValues)->Values)
+	{
+		const FName Name = FindPropertyName(Property.Key, Actor, Error);
+		if (!Name.IsNone() && Bindings.SetValue(Actor, Name, Property.Value, Error))
+		{
+			Updated.Add(MakeShared<FJsonValueString>(Property.Key));
+		}
+		else
+		{
+			ErrorsObj->SetStringField(Property.Key, Error);
+		}
+	}
+
+	// One rebuild covers every value written above, and any other write to the actor this batch or frame
+	bool bRerunConstructionScripts = true;
+	Params->TryGetBoolField(TEXT("rerun_construction_scripts"), bRerunConstructionScripts);
+	const TCHAR* Rerun = TEXT("none");
+	if (bRerunConstructionScripts && Updated.Num() > 0)
+	{
+		Rerun = FUnrealMCPConstructionScripts::Get().Request(Actor) ? TEXT("scheduled") : TEXT("coalesced");
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetStringField(TEXT("actor_name"), Actor->GetName());
+	ResultObj->SetArrayField(TEXT("updated"), Updated);
+	ResultObj->SetStringField(TEXT("construction_script_rerun"), Rerun);
+	if (ErrorsObj->Values.Num() > 0)
+	{
+		ResultObj->SetObjectField(TEXT("errors"), ErrorsObj);
+	}
+	return ResultObj;
 }
 
 // Ultra Dynamic Sky specific functions from now on
@@ -566,8 +1026,8 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetUltraDynamicSkyPropert
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Ultra Dynamic Sky actor not found"));
 	}
 
-	float TimeOfDayValue;
-	float ColorTempValue;
+	double TimeOfDayValue;
+	double ColorTempValue;
 	if (!GetDoublePropertyValue(SkyActor, UDSTODName, TimeOfDayValue) ||
 		!GetDoublePropertyValue(SkyActor, UDSColorTempName, ColorTempValue))
 	{
@@ -725,8 +1185,8 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetCesiumProperties(const
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Cesium Georeference actor not found"));
 	}
-	float Latitude = 0.0;
-	float Longitude = 0.0;
+	double Latitude = 0.0;
+	double Longitude = 0.0;
 	if (!GetDoublePropertyValue(CesiumActor, CesiumLatitudeName, Latitude) ||
 		!GetDoublePropertyValue(CesiumActor, CesiumLongitudeName, Longitude))
 	{
@@ -738,6 +1198,221 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetCesiumProperties(const
 	return ResultObj;
 }
 
+// Property animation from now on
+void FUnrealMCPActorCommands::HandleAnimateProperty(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete)
+{
+	FString PropertyKey;
+	if (!Params->TryGetStringField(TEXT("property"), PropertyKey))
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'property' parameter")), {});
+		return;
+	}
+
+	FUnrealMCPPropertyAnimation Animation;
+	if (!Params->TryGetNumberField(TEXT("to"), Animation.To))
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'to' parameter")), {});
+		return;
+	}
+	double From = 0.0;
+	if (Params->TryGetNumberField(TEXT("from"), From))
+	{
+		Animation.From = From;
+	}
+	if (!Params->TryGetNumberField(TEXT("duration"), Animation.Duration) || Animation.Duration < 0.0 || Animation.Duration > 3600.0)
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'duration' must be between 0 and 3600 seconds")), {});
+		return;
+	}
+	FString EasingName;
+	if (Params->TryGetStringField(TEXT("easing"), EasingName) && !FUnrealMCPPropertyAnimator::ParseEasing(EasingName, Animation.Easing))
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown easing '%s' (expected linear, ease_in, ease_out or ease_in_out)"), *EasingName)), {});
+		return;
+	}
+	Params->TryGetNumberField(TEXT("progress_interval"), Animation.ProgressInterval);
+
+	// The sky and georeference shorthands keep the ranges their set_ commands enforce
+	AActor* Actor = nullptr;
+	FString Error;
+	TOptional<TInterval<double>> Range;
+	if (PropertyKey == UDSTODJSONKey || PropertyKey == UDSColorTempJSONKey)
+	{
+		Actor = GetUltraDynamicSkyActor();
+		Error = TEXT("Ultra Dynamic Sky actor not found");
+		const bool bTimeOfDay = PropertyKey == UDSTODJSONKey;
+		Animation.Property = bTimeOfDay ? UDSTODName : UDSColorTempName;
+		Range = bTimeOfDay ? TInterval<double>(0.0, 2400.0) : TInterval<double>(1500.0, 15000.0);
+	}
+	else if (PropertyKey == CesiumLatitudeJSONKey || PropertyKey == CesiumLongitudeJSONKey)
+	{
+		Actor = GetCesiumGeoreferenceActor();
+		Error = TEXT("Cesium Georeference actor not found");
+		const bool bLatitude = PropertyKey == CesiumLatitudeJSONKey;
+		Animation.Property = bLatitude ? CesiumLatitudeName : CesiumLongitudeName;
+		Range = bLatitude ? TInterval<double>(-90.0, 90.0) : TInterval<double>(-180.0, 180.0);
+	}
+	else
+	{
+		Actor = FindPropertyTarget(Params, Error);
+		if (Actor)
+		{
+			Animation.Property = FindPropertyName(PropertyKey, Actor, Error);
+		}
+	}
+	if (!Actor || Animation.Property.IsNone())
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(Error), {});
+		return;
+	}
+	if (Range.IsSet() && (!Range->Contains(Animation.To) || (Animation.From.IsSet() && !Range->Contains(Animation.From.GetValue()))))
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'%s' must stay between %g and %g"), *PropertyKey, Range->Min, Range->Max)), {});
+		return;
+	}
+	Animation.Actor = Actor;
+
+	// A waiting request holds the connection's mutation barrier for the whole duration
+	bool bWait = false;
+	Params->TryGetBoolField(TEXT("wait"), bWait);
+	FUnrealMCPPropertyAnimator& Animator = FUnrealMCPPropertyAnimator::Get();
+	const int32 Id = bWait
+		? Animator.Start(MoveTemp(Animation), MoveTemp(OnProgress), MoveTemp(OnComplete), Error)
+		: Animator.Start(MoveTemp(Animation), FUnrealMCPCommandProgress(), FUnrealMCPCommandCompletion(), Error);
+	if (Id == INDEX_NONE)
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(Error), {});
+		return;
+	}
+	if (!bWait)
+	{
+		OnComplete(Animator.Describe(Id), {});
+	}
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleStopAnimation(const TSharedPtr<FJsonObject>& Params)
+{
+	// Without an id every running animation stops
+	int32 Id = INDEX_NONE;
+	Params->TryGetNumberField(TEXT("animation_id"), Id);
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetNumberField(TEXT("stopped"), FUnrealMCPPropertyAnimator::Get().Stop(Id));
+	return ResultObj;
+}
+
+// Change feeds from now on
+void FUnrealMCPActorCommands::HandleSubscribe(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete)
+{
+	if (!OnProgress)
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("subscribe needs a request 'id' so notifications can be matched to it")), {});
+		return;
+	}
+
+	UWorld* World = GetCurrentWorld();
+	if (!World)
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get world context")), {});
+		return;
+	}
+
+	// Actors are chosen once, by any mix of names, a class or a tag
+	TArray<AActor*> Actors;
+	TArray<FString> ActorNames;
+	FString Value;
+	Params->TryGetStringArrayField(TEXT("actor_names"), ActorNames);
+	if (Params->TryGetStringField(TEXT("actor_name"), Value))
+	{
+		ActorNames.Add(Value);
+	}
+	for (const FString& ActorName : ActorNames)
+	{
+		AActor* Actor = FindActorByName(World, ActorName);
+		if (!Actor)
+		{
+			OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName)), {});
+			return;
+		}
+		Actors.AddUnique(Actor);
+	}
+	if (Params->TryGetStringField(TEXT("actor_class"), Value))
+	{
+		AActor* Actor = FindActorByClassName(Value);
+		if (!Actor)
+		{
+			OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("No actor of class %s"), *Value)), {});
+			return;
+		}
+		Actors.AddUnique(Actor);
+	}
+	if (Params->TryGetStringField(TEXT("tag"), Value))
+	{
+		TArray<AActor*> Tagged;
+		const FName Tag(*Value, FNAME_Find);
+		if (!Tag.IsNone())
+		{
+			FindActorsWithTag(World, Tag, Tagged);
+		}
+		for (AActor* Actor : Tagged)
+		{
+			Actors.AddUnique(Actor);
+		}
+	}
+	if (Actors.Num() == 0)
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No actors to watch; give 'actor_name', 'actor_names', 'actor_class' or 'tag'")), {});
+		return;
+	}
+	if (Actors.Num() > FUnrealMCPSubscriptions::MaxActors)
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("A subscription can watch at most %d actors"), FUnrealMCPSubscriptions::MaxActors)), {});
+		return;
+	}
+
+	TArray<FString> PropertyNames;
+	Params->TryGetStringArrayField(TEXT("properties"), PropertyNames);
+	TArray<FName> Properties;
+	for (const FString& PropertyName : PropertyNames)
+	{
+		// Like the tag above: an unregistered name can't be a property, so don't create it
+		const FName Property(*PropertyName, FNAME_Find);
+		if (Property.IsNone())
+		{
+			OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown property '%s'"), *PropertyName)), {});
+			return;
+		}
+		Properties.Add(Property);
+	}
+	bool bTransform = true;
+	Params->TryGetBoolField(TEXT("transform"), bTransform);
+	if (!bTransform && Properties.Num() == 0)
+	{
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Nothing to watch: 'transform' is false and 'properties' is empty")), {});
+		return;
+	}
+	double MinInterval = 0.0;
+	Params->TryGetNumberField(TEXT("min_interval"), MinInterval);
+
+	TSharedPtr<FJsonObject> Snapshot;
+	FUnrealMCPSubscriptions::Get().Subscribe(Actors, bTransform, Properties, MinInterval, MoveTemp(OnProgress), Snapshot);
+	OnComplete(Snapshot, {});
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleUnsubscribe(const TSharedPtr<FJsonObject>& Params)
+{
+	int32 Id = INDEX_NONE;
+	if (!Params->TryGetNumberField(TEXT("subscription_id"), Id))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'subscription_id' parameter"));
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetNumberField(TEXT("subscription_id"), Id);
+	ResultObj->SetBoolField(TEXT("unsubscribed"), FUnrealMCPSubscriptions::Get().Unsubscribe(Id));
+	return ResultObj;
+}
+
 // MM Control Light CRUD operations
 TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleCreateMMControlLight(const TSharedPtr<FJsonObject> &Params)
 {
@@ -788,18 +1463,7 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleCreateMMControlLight(cons
 	}
 
 	// Check if light with this name already exists
-	bool bNameExists = false;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		AActor* Actor = *ActorItr;
-		if (Actor && IsValid(Actor) && Actor->GetName() == LightName)
-		{
-			bNameExists = true;
-			break;
-		}
-	}
-
-	if (bNameExists)
+	if (FindActorByName(World, LightName))
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Light with name '%s' already exists"), *LightName));
 	}
@@ -831,6 +1495,11 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleCreateMMControlLight(cons
 
 	// Add MM_Control_Light tag
 	NewLightActor->Tags.Add(TEXT("MM_Control_Light"));
+	if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
+	{
+		// Spawn notifications fire before the tag is added
+		Index->ReindexActor(NewLightActor);
+	}
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -876,53 +1545,53 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleGetMMControlLights(const
 
 	// Find all actors with MM_Control_Light tag
 	TArray<AActor*> MMControlLights;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
-	{
-		AActor* Actor = *ActorItr;
-		if (Actor && IsValid(Actor) && Actor->Tags.Contains(TEXT("MM_Control_Light")))
-		{
-			MMControlLights.Add(Actor);
-		}
-	}
+	FindActorsWithTag(World, TEXT("MM_Control_Light"), MMControlLights);
 
 	// Create lights array
-	TArray<TSharedPtr<FJsonValue>> LightsArray;
+	TArray<uint8> LightsJson;
+	FUnrealMCPJsonWriter Writer(LightsJson);
+	int32 LightCount = 0;
+	Writer.BeginArray();
 	for (AActor* LightActor : MMControlLights)
 	{
 		if (LightActor && IsValid(LightActor))
 		{
-			TSharedPtr<FJsonObject> LightInfo = MakeShared<FJsonObject>();
+			Writer.BeginObject();
 			
 			// Add basic actor info
-			LightInfo->SetStringField(TEXT("actor_name"), LightActor->GetName());
+			Writer.WriteField(TEXT("actor_name"), LightActor->GetName());
 			
 			// Add location info
-			FVector Location = LightActor->GetActorLocation();
-			TSharedPtr<FJsonObject> LocationObj = MakeShared<FJsonObject>();
-			LocationObj->SetNumberField(TEXT("x"), Location.X);
-			LocationObj->SetNumberField(TEXT("y"), Location.Y);
-			LocationObj->SetNumberField(TEXT("z"), Location.Z);
-			LightInfo->SetObjectField(TEXT("location"), LocationObj);
+			const FVector Location = LightActor->GetActorLocation();
+			Writer.WriteKey(TEXT("location"));
+			Writer.BeginObject();
+			Writer.WriteField(TEXT("x"), Location.X);
+			Writer.WriteField(TEXT("y"), Location.Y);
+			Writer.WriteField(TEXT("z"), Location.Z);
+			Writer.EndObject();
 			
 			// Add default intensity and color (since this is a basic actor without light components)
 			// In a real implementation, you'd extract these from light components
-			LightInfo->SetNumberField(TEXT("intensity"), 1000);
+			Writer.WriteField(TEXT("intensity"), 1000);
 			
-			TSharedPtr<FJsonObject> ColorObj = MakeShared<FJsonObject>();
-			ColorObj->SetNumberField(TEXT("r"), 255);
-			ColorObj->SetNumberField(TEXT("g"), 255);
-			ColorObj->SetNumberField(TEXT("b"), 255);
-			LightInfo->SetObjectField(TEXT("color"), ColorObj);
+			Writer.WriteKey(TEXT("color"));
+			Writer.BeginObject();
+			Writer.WriteField(TEXT("r"), 255);
+			Writer.WriteField(TEXT("g"), 255);
+			Writer.WriteField(TEXT("b"), 255);
+			Writer.EndObject();
 			
-			LightsArray.Add(MakeShared<FJsonValueObject>(LightInfo));
+			Writer.EndObject();
+			++LightCount;
 		}
 	}
+	Writer.EndArray();
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
-	ResultObj->SetArrayField(TEXT("lights"), LightsArray);
-	ResultObj->SetNumberField(TEXT("count"), LightsArray.Num());
+	ResultObj->SetField(TEXT("lights"), MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(LightsJson)));
+	ResultObj->SetNumberField(TEXT("count"), LightCount);
 
 	return ResultObj;
 }
@@ -944,17 +1613,10 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleUpdateMMControlLight(cons
 	}
 
 	// Find the specific MM Control Light by name and tag
-	AActor* TargetLightActor = nullptr;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	AActor* TargetLightActor = FindActorByName(World, LightName);
+	if (TargetLightActor && !TargetLightActor->Tags.Contains(TEXT("MM_Control_Light")))
 	{
-		AActor* Actor = *ActorItr;
-		if (Actor && IsValid(Actor) && 
-			Actor->GetName() == LightName && 
-			Actor->Tags.Contains(TEXT("MM_Control_Light")))
-		{
-			TargetLightActor = Actor;
-			break;
-		}
+		TargetLightActor = nullptr;
 	}
 
 	if (!TargetLightActor)
@@ -970,6 +1632,10 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleUpdateMMControlLight(cons
 	{
 		FVector NewLocation = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location"));
 		TargetLightActor->SetActorLocation(NewLocation);
+		if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
+		{
+			Index->UpdateActorBounds(TargetLightActor);
+		}
 		
 		TSharedPtr<FJsonObject> LocationObj = MakeShared<FJsonObject>();
 		LocationObj->SetNumberField(TEXT("x"), NewLocation.X);
@@ -1041,17 +1707,10 @@ TSharedPtr<FJsonObject> FUnrealMCPActorCommands::HandleDeleteMMControlLight(cons
 	}
 
 	// Find the specific MM Control Light by name and tag
-	AActor* TargetLightActor = nullptr;
-	for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+	AActor* TargetLightActor = FindActorByName(World, LightName);
+	if (TargetLightActor && !TargetLightActor->Tags.Contains(TEXT("MM_Control_Light")))
 	{
-		AActor* Actor = *ActorItr;
-		if (Actor && IsValid(Actor) && 
-			Actor->GetName() == LightName && 
-			Actor->Tags.Contains(TEXT("MM_Control_Light")))
-		{
-			TargetLightActor = Actor;
-			break;
-		}
+		TargetLightActor = nullptr;
 	}
 
 	if (!TargetLightActor)
@@ -0,0 +1,582 @@
+#include "Commands/UnrealMCPActorIndex.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/Crc.h"
+
+void UUnrealMCPActorIndex::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (GEngine)
+    {
+        LevelActorAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &UUnrealMCPActorIndex::HandleActorAdded);
+        LevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &UUnrealMCPActorIndex::HandleActorRemoved);
+        ActorMovedHandle = GEngine->OnActorMoved().AddUObject(this, &UUnrealMCPActorIndex::HandleActorMoved);
+    }
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UUnrealMCPActorIndex::HandleLevelAdded);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UUnrealMCPActorIndex::HandleLevelRemoved);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UUnrealMCPActorIndex::HandleWorldCleanup);
+    UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddUObject(this, &UUnrealMCPActorIndex::HandleUndoRedo);
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UUnrealMCPActorIndex::HandleObjectPropertyChanged);
+}
+
+void UUnrealMCPActorIndex::Deinitialize()
+{
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(LevelActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedHandle);
+        GEngine->OnActorMoved().Remove(ActorMovedHandle);
+    }
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+    FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+
+    for (TPair<TObjectKey<UWorld>, TUniquePtr<FWorldIndex>>& Pair : Indices)
+    {
+        if (UWorld* World = Pair.Value->World.Get())
+        {
+            World->RemoveOnActorSpawnedHandler(Pair.Value->SpawnedHandle);
+            World->RemoveOnActorDestroyededHandler(Pair.Value->DestroyedHandle);
+        }
+    }
+    Indices.Empty();
+
+    Super::Deinitialize();
+}
+
+UUnrealMCPActorIndex* UUnrealMCPActorIndex::Get()
+{
+    return GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPActorIndex>() : nullptr;
+}
+
+AActor* UUnrealMCPActorIndex::FindActorByName(UWorld* World, FName Name)
+{
+    FWorldIndex* Index = GetIndex(World);
+    if (!Index)
+    {
+        return nullptr;
+    }
+
+    // Renamed actors stay filed under their old name until reindexed
+    for (const TWeakObjectPtr<AActor>& Candidate : Index->ByName.FindRef(Name))
+    {
+        AActor* Actor = Candidate.Get();
+        if (IsValid(Actor) && Actor->GetFName() == Name)
+        {
+            return Actor;
+        }
+    }
+    return nullptr;
+}
+
+AActor* UUnrealMCPActorIndex::FindFirstActorOfClass(UWorld* World, FName ClassName)
+{
+    FWorldIndex* Index = GetIndex(World);
+    return Index ? FirstValid(Index->ByClass, ClassName) : nullptr;
+}
+
+void UUnrealMCPActorIndex::FindActorsOfClass(UWorld* World, FName ClassName, TArray<AActor*>& OutActors)
+{
+    FWorldIndex* Index = GetIndex(World);
+    if (!Index)
+    {
+        return;
+    }
+
+    for (const TWeakObjectPtr<AActor>& Candidate : Index->ByClass.FindRef(ClassName))
+    {
+        AActor* Actor = Candidate.Get();
+        if (IsValid(Actor))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+void UUnrealMCPActorIndex::FindActorsWithTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors)
+{
+    FWorldIndex* Index = GetIndex(World);
+    if (!Index)
+    {
+        return;
+    }
+
+    for (const TWeakObjectPtr<AActor>& Candidate : Index->ByTag.FindRef(Tag))
+    {
+        AActor* Actor = Candidate.Get();
+        if (IsValid(Actor) && Actor->Tags.Contains(Tag))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+void UUnrealMCPActorIndex::ReindexActor(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    // Worlds nobody has queried yet will pick the change up when they are built
+    TUniquePtr<FWorldIndex>* Index = Indices.Find(Actor->GetWorld());
+    if (!Index || (*Index)->bDirty)
+    {
+        return;
+    }
+
+    // A renamed actor is gone under its old name as far as clients are concerned
+    const FEntry* Old = (*Index)->Entries.Find(Actor);
+    const bool bRenamed = Old && Old->Name != Actor->GetFName();
+    const uint64 SpawnVersion = Old ? Old->SpawnVersion : 0;
+
+    RemoveActor(**Index, Actor, bRenamed);
+    AddActor(**Index, Actor);
+    if (SpawnVersion != 0 && !bRenamed)
+    {
+        (*Index)->Entries[Actor].SpawnVersion = SpawnVersion;
+    }
+}
+
+FUnrealMCPSpatialIndex* UUnrealMCPActorIndex::GetSpatialIndex(UWorld* World)
+{
+    FWorldIndex* Index = GetIndex(World);
+    if (!Index)
+    {
+        return nullptr;
+    }
+
+    if (!Index->Spatial.IsValid() || Index->Spatial->NeedsRebuild())
+    {
+        Index->Spatial = MakeUnique<FUnrealMCPSpatialIndex>(World);
+    }
+    return Index->Spatial.Get();
+}
+
+void UUnrealMCPActorIndex::UpdateActorBounds(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    TUniquePtr<FWorldIndex>* Index = Indices.Find(Actor->GetWorld());
+    if (Index && (*Index)->Spatial.IsValid())
+    {
+        (*Index)->Spatial->UpdateActor(Actor);
+    }
+    MarkActorChanged(Actor);
+}
+
+void UUnrealMCPActorIndex::MarkActorChanged(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    // Dirty indices keep their entries until the rebuild, which carries the stamp over
+    TUniquePtr<FWorldIndex>* Index = Indices.Find(Actor->GetWorld());
+    FEntry* Entry = Index ? (*Index)->Entries.Find(Actor) : nullptr;
+    if (Entry)
+    {
+        Entry->Version = ++SceneGeneration;
+        Entry->Fingerprint = Fingerprint(Actor);
+    }
+}
+
+uint64 UUnrealMCPActorIndex::GetGeneration(UWorld* World)
+{
+    GetIndex(World);
+    return SceneGeneration;
+}
+
+bool UUnrealMCPActorIndex::GetSceneDelta(UWorld* World, uint64 Since, FUnrealMCPSceneDelta& OutDelta)
+{
+    FWorldIndex* Index = GetIndex(World);
+    if (!Index)
+    {
+        return false;
+    }
+
+    // Moves made from code or by gameplay raise no notification
+    TArray<TObjectKey<AActor>> Gone;
+    for (TPair<TObjectKey<AActor>, FEntry>& Pair : Index->Entries)
+    {
+        AActor* Actor = Pair.Key.ResolveObjectPtr();
+        if (!IsValid(Actor))
+        {
+            Gone.Add(Pair.Key);
+            continue;
+        }
+
+        const uint32 Print = Fingerprint(Actor);
+        if (Print != Pair.Value.Fingerprint)
+        {
+            Pair.Value.Fingerprint = Print;
+            Pair.Value.Version = ++SceneGeneration;
+        }
+    }
+
+    // Collected or pending kill without a destroy notification
+    for (const TObjectKey<AActor>& Key : Gone)
+    {
+        if (AActor* Actor = Key.ResolveObjectPtrEvenIfGarbage())
+        {
+            RemoveActor(*Index, Actor);
+        }
+        else
+        {
+            FEntry Entry;
+            Index->Entries.RemoveAndCopyValue(Key, Entry);
+            AddTombstone(*Index, Entry.Name);
+        }
+    }
+
+    // A generation from a previous session is ahead of ours
+    OutDelta.Generation = SceneGeneration;
+    OutDelta.bReset = Since == 0 || Since < Index->BaseGeneration || Since < Index->TombstoneFloor || Since > SceneGeneration;
+
+    for (const TPair<TObjectKey<AActor>, FEntry>& Pair : Index->Entries)
+    {
+        const FEntry& Entry = Pair.Value;
+        if (OutDelta.bReset || Entry.SpawnVersion > Since)
+        {
+            OutDelta.Spawned.Add({ Pair.Key.ResolveObjectPtr(), Entry.Version });
+        }
+        else if (Entry.Version > Since)
+        {
+            OutDelta.Changed.Add({ Pair.Key.ResolveObjectPtr(), Entry.Version });
+        }
+    }
+
+    if (!OutDelta.bReset)
+    {
+        for (const FTombstone& Tombstone : Index->Tombstones)
+        {
+            if (Tombstone.Generation > Since)
+            {
+                OutDelta.Deleted.Add(Tombstone.Name);
+            }
+        }
+    }
+    return true;
+}
+
+void UUnrealMCPActorIndex::Invalidate(UWorld* World)
+{
+    for (TPair<TObjectKey<UWorld>, TUniquePtr<FWorldIndex>>& Pair : Indices)
+    {
+        if (!World || Pair.Key == TObjectKey<UWorld>(World))
+        {
+            Pair.Value->bDirty = true;
+        }
+    }
+}
+
+UUnrealMCPActorIndex::FWorldIndex* UUnrealMCPActorIndex::GetIndex(UWorld* World)
+{
+    check(IsInGameThread());
+
+    if (!IsValid(World))
+    {
+        return nullptr;
+    }
+
+    TUniquePtr<FWorldIndex>& Index = Indices.FindOrAdd(World);
+    if (!Index.IsValid())
+    {
+        Index = MakeUnique<FWorldIndex>();
+        Index->World = World;
+        Index->SpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UUnrealMCPActorIndex::HandleActorAdded));
+        Index->DestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UUnrealMCPActorIndex::HandleActorRemoved));
+    }
+
+    if (Index->bDirty)
+    {
+        Rebuild(*Index);
+    }
+    return Index.Get();
+}
+
+void UUnrealMCPActorIndex::Rebuild(FWorldIndex& Index)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    Index.ByName.Reset();
+    Index.ByClass.Reset();
+    Index.ByTag.Reset();
+    Index.Spatial.Reset();
+    TMap<TObjectKey<AActor>, FEntry> Previous = MoveTemp(Index.Entries);
+    Index.Entries.Reset();
+
+    UWorld* World = Index.World.Get();
+    if (World)
+    {
+        for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+        {
+            AddActor(Index, *ActorItr);
+        }
+    }
+    Index.bDirty = false;
+
+    if (Index.BaseGeneration == 0)
+    {
+        Index.BaseGeneration = ++SceneGeneration;
+    }
+    else
+    {
+        // Carry the stamps over so a rebuild only reports what really changed
+        for (TPair<TObjectKey<AActor>, FEntry>& Pair : Index.Entries)
+        {
+            FEntry Old;
+            if (!Previous.RemoveAndCopyValue(Pair.Key, Old))
+            {
+                continue;
+            }
+            if (Old.Name != Pair.Value.Name)
+            {
+                AddTombstone(Index, Old.Name);
+                continue;
+            }
+            Pair.Value.SpawnVersion = Old.SpawnVersion;
+            if (Old.Fingerprint == Pair.Value.Fingerprint)
+            {
+                Pair.Value.Version = Old.Version;
+            }
+        }
+        for (const TPair<TObjectKey<AActor>, FEntry>& Pair : Previous)
+        {
+            AddTombstone(Index, Pair.Value.Name);
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealMCP: Indexed %d actors in %s (%.1f ms)"),
+           Index.Entries.Num(), World ? *World->GetName() : TEXT("<none>"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UUnrealMCPActorIndex::ReleaseIndex(UWorld* World)
+{
+    TUniquePtr<FWorldIndex> Index;
+    if (!World || !Indices.RemoveAndCopyValue(World, Index) || !Index.IsValid())
+    {
+        return;
+    }
+
+    // Engine spelling
+    World->RemoveOnActorSpawnedHandler(Index->SpawnedHandle);
+    World->RemoveOnActorDestroyededHandler(Index->DestroyedHandle);
+}
+
+void UUnrealMCPActorIndex::AddActor(FWorldIndex& Index, AActor* Actor)
+{
+    if (!IsValid(Actor) || Index.Entries.Contains(Actor))
+    {
+        return;
+    }
+
+    if (Index.Spatial.IsValid())
+    {
+        Index.Spatial->AddActor(Actor);
+    }
+
+    FEntry& Entry = Index.Entries.Add(Actor);
+    Entry.Name = Actor->GetFName();
+    Entry.ClassName = Actor->GetClass()->GetFName();
+    Entry.Tags = Actor->Tags;
+    Entry.SpawnVersion = Entry.Version = ++SceneGeneration;
+    Entry.Fingerprint = Fingerprint(Actor);
+
+    const TWeakObjectPtr<AActor> WeakActor(Actor);
+    Index.ByName.FindOrAdd(Entry.Name).Add(WeakActor);
+    Index.ByClass.FindOrAdd(Entry.ClassName).Add(WeakActor);
+    for (const FName& Tag : Entry.Tags)
+    {
+        Index.ByTag.FindOrAdd(Tag).AddUnique(WeakActor);
+    }
+}
+
+void UUnrealMCPActorIndex::RemoveActor(FWorldIndex& Index, AActor* Actor, bool bDeleted)
+{
+    FEntry Entry;
+    if (!Index.Entries.RemoveAndCopyValue(Actor, Entry))
+    {
+        return;
+    }
+
+    if (bDeleted)
+    {
+        AddTombstone(Index, Entry.Name);
+    }
+
+    if (Index.Spatial.IsValid())
+    {
+        Index.Spatial->RemoveActor(Actor);
+    }
+
+    const TWeakObjectPtr<AActor> WeakActor(Actor);
+    auto RemoveFrom = [&WeakActor](FBuckets& Buckets, FName Key)
+    {
+        if (TArray<TWeakObjectPtr<AActor>>* Bucket = Buckets.Find(Key))
+        {
+            // Drops entries for actors that were garbage collected without a destroy notification too
+            Bucket->RemoveAllSwap([&WeakActor](const TWeakObjectPtr<AActor>& Candidate) { return Candidate == WeakActor || Candidate.IsStale(); });
+            if (Bucket->Num() == 0)
+            {
+                Buckets.Remove(Key);
+            }
+        }
+    };
+
+    RemoveFrom(Index.ByName, Entry.Name);
+    RemoveFrom(Index.ByClass, Entry.ClassName);
+    for (const FName& Tag : Entry.Tags)
+    {
+        RemoveFrom(Index.ByTag, Tag);
+    }
+}
+
+void UUnrealMCPActorIndex::AddTombstone(FWorldIndex& Index, FName Name)
+{
+    Index.Tombstones.Add({ Name, ++SceneGeneration });
+
+    // Trim in halves so a delete-heavy session doesn't shift the array every time
+    if (Index.Tombstones.Num() > MaxTombstones)
+    {
+        const int32 NumDropped = Index.Tombstones.Num() - MaxTombstones / 2;
+        Index.TombstoneFloor = Index.Tombstones[NumDropped - 1].Generation;
+        Index.Tombstones.RemoveAt(0, NumDropped);
+    }
+}
+
+uint32 UUnrealMCPActorIndex::Fingerprint(const AActor* Actor)
+{
+    const FTransform Transform = Actor->GetActorTransform();
+    const FVector Location = Transform.GetLocation();
+    const FQuat Rotation = Transform.GetRotation();
+    const FVector Scale = Transform.GetScale3D();
+    const uint8 Hidden = (Actor->IsHidden() ? 1 : 0) | (Actor->IsHiddenEd() ? 2 : 0);
+
+    uint32 Crc = FCrc::MemCrc32(&Location, sizeof(Location));
+    Crc = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Crc);
+    Crc = FCrc::MemCrc32(&Scale, sizeof(Scale), Crc);
+    return FCrc::MemCrc32(&Hidden, sizeof(Hidden), Crc);
+}
+
+AActor* UUnrealMCPActorIndex::FirstValid(FBuckets& Buckets, FName Key)
+{
+    for (const TWeakObjectPtr<AActor>& Candidate : Buckets.FindRef(Key))
+    {
+        AActor* Actor = Candidate.Get();
+        if (IsValid(Actor))
+        {
+            return Actor;
+        }
+    }
+    return nullptr;
+}
+
+void UUnrealMCPActorIndex::HandleActorAdded(AActor* Actor)
+{
+    if (!Actor)
+    {
+        return;
+    }
+
+    TUniquePtr<FWorldIndex>* Index = Indices.Find(Actor->GetWorld());
+    if (Index && !(*Index)->bDirty)
+    {
+        AddActor(**Index, Actor);
+    }
+}
+
+void UUnrealMCPActorIndex::HandleActorRemoved(AActor* Actor)
+{
+    if (!Actor)
+    {
+        return;
+    }
+
+    TUniquePtr<FWorldIndex>* Index = Indices.Find(Actor->GetWorld());
+    if (Index && !(*Index)->bDirty)
+    {
+        RemoveActor(**Index, Actor);
+    }
+}
+
+void UUnrealMCPActorIndex::HandleActorMoved(AActor* Actor)
+{
+    UpdateActorBounds(Actor);
+}
+
+void UUnrealMCPActorIndex::HandleLevelAdded(ULevel* Level, UWorld* World)
+{
+    TUniquePtr<FWorldIndex>* Index = Indices.Find(World);
+    if (!Index || (*Index)->bDirty)
+    {
+        return;
+    }
+
+    if (!Level)
+    {
+        (*Index)->bDirty = true;
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        AddActor(**Index, Actor);
+    }
+}
+
+void UUnrealMCPActorIndex::HandleLevelRemoved(ULevel* Level, UWorld* World)
+{
+    TUniquePtr<FWorldIndex>* Index = Indices.Find(World);
+    if (!Index || (*Index)->bDirty)
+    {
+        return;
+    }
+
+    // A null level means every level is going away
+    if (!Level)
+    {
+        (*Index)->bDirty = true;
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            RemoveActor(**Index, Actor);
+        }
+    }
+}
+
+void UUnrealMCPActorIndex::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    ReleaseIndex(World);
+}
+
+void UUnrealMCPActorIndex::HandleUndoRedo()
+{
+    // Undo can resurrect deleted actors without any add notification
+    Invalidate();
+}
+
+void UUnrealMCPActorIndex::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    // Component edits count as changes to their actor; undo reports here too
+    AActor* Actor = Cast<AActor>(Object);
+    if (!Actor && Object)
+    {
+        Actor = Object->GetTypedOuter<AActor>();
+    }
+    MarkActorChanged(Actor);
+}
@@ -0,0 +1,338 @@
+#include "Commands/UnrealMCPActorQuery.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Algo/Find.h"
+
+namespace
+{
+    struct FFieldName
+    {
+        const TCHAR* Name;
+        EUnrealMCPActorFields Field;
+    };
+
+    const FFieldName FieldNames[] = {
+        { TEXT("name"), EUnrealMCPActorFields::Name },
+        { TEXT("class"), EUnrealMCPActorFields::Class },
+        { TEXT("location"), EUnrealMCPActorFields::Location },
+        { TEXT("rotation"), EUnrealMCPActorFields::Rotation },
+        { TEXT("scale"), EUnrealMCPActorFields::Scale },
+        { TEXT("tags"), EUnrealMCPActorFields::Tags },
+        { TEXT("label"), EUnrealMCPActorFields::Label },
+        { TEXT("level"), EUnrealMCPActorFields::Level },
+    };
+}
+
+FString FUnrealMCPActorCursor::ToString() const
+{
+    return FString::Printf(TEXT("%d:%d"), Level, Actor);
+}
+
+bool FUnrealMCPActorCursor::Parse(const FString& Text, FUnrealMCPActorCursor& OutCursor)
+{
+    FString LevelPart, ActorPart;
+    if (!Text.Split(TEXT(":"), &LevelPart, &ActorPart) || !LevelPart.IsNumeric() || !ActorPart.IsNumeric())
+    {
+        return false;
+    }
+    OutCursor.Level = FCString::Atoi(*LevelPart);
+    OutCursor.Actor = FCString::Atoi(*ActorPart);
+    return OutCursor.Level >= 0 && OutCursor.Actor >= 0;
+}
+
+bool FUnrealMCPActorQuery::Parse(const TSharedPtr<FJsonObject>& Params, FUnrealMCPActorQuery& OutQuery, FString& OutError)
+{
+    if (!Params.IsValid())
+    {
+        return true;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* FieldsArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("fields"), FieldsArray))
+    {
+        OutQuery.Fields = EUnrealMCPActorFields::None;
+        for (const TSharedPtr<FJsonValue>& Value : *FieldsArray)
+        {
+            const FString FieldName = Value->AsString();
+            const FFieldName* Found = Algo::FindByPredicate(FieldNames, [&FieldName](const FFieldName& Entry) { return FieldName.Equals(Entry.Name, ESearchCase::IgnoreCase); });
+            if (!Found)
+            {
+                OutError = FString::Printf(TEXT("Unknown actor field '%s'"), *FieldName);
+                return false;
+            }
+            OutQuery.Fields |= Found->Field;
+        }
+    }
+
+    FString ClassName;
+    if (Params->TryGetStringField(TEXT("class"), ClassName) && !ClassName.IsEmpty())
+    {
+        // FNAME_Find keeps client input out of the name table
+        OutQuery.ClassName = FName(*ClassName, FNAME_Find);
+        OutQuery.bMatchesNothing |= OutQuery.ClassName.IsNone();
+    }
+
+    FString Tag;
+    if (Params->TryGetStringField(TEXT("tag"), Tag) && !Tag.IsEmpty())
+    {
+        OutQuery.Tag = FName(*Tag, FNAME_Find);
+        OutQuery.bMatchesNothing |= OutQuery.Tag.IsNone();
+    }
+
+    const TSharedPtr<FJsonObject>* BoundsObj = nullptr;
+    if (Params->TryGetObjectField(TEXT("bounds"), BoundsObj))
+    {
+        if (!(*BoundsObj)->HasField(TEXT("min")) || !(*BoundsObj)->HasField(TEXT("max")))
+        {
+            OutError = TEXT("'bounds' needs 'min' and 'max'");
+            return false;
+        }
+        const FVector Min = FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObj, TEXT("min"));
+        const FVector Max = FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObj, TEXT("max"));
+        OutQuery.Bounds = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+    }
+
+    double Limit = 0.0;
+    if (Params->TryGetNumberField(TEXT("limit"), Limit))
+    {
+        if (Limit < 0.0)
+        {
+            OutError = TEXT("'limit' must not be negative");
+            return false;
+        }
+        OutQuery.Limit = (int32)FMath::Min(Limit, (double)MAX_int32);
+    }
+
+    FString CursorText;
+    if (Params->TryGetStringField(TEXT("cursor"), CursorText) && !CursorText.IsEmpty() &&
+        !FUnrealMCPActorCursor::Parse(CursorText, OutQuery.Cursor))
+    {
+        OutError = FString::Printf(TEXT("Invalid cursor '%s'"), *CursorText);
+        return false;
+    }
+
+    return true;
+}
+
+bool FUnrealMCPActorQuery::Matches(const AActor* Actor) const
+{
+    if (bMatchesNothing)
+    {
+        return false;
+    }
+    if (!ClassName.IsNone() && Actor->GetClass()->GetFName() != ClassName)
+    {
+        return false;
+    }
+    if (!Tag.IsNone() && !Actor->Tags.Contains(Tag))
+    {
+        return false;
+    }
+    if (Bounds.IsSet() && !Bounds->IsInsideOrOn(Actor->GetActorLocation()))
+    {
+        return false;
+    }
+    return true;
+}
+
+void FUnrealMCPActorQuery::Write(FUnrealMCPJsonWriter& Writer, const AActor* Actor) const
+{
+    Writer.BeginObject();
+    WriteFields(Writer, Actor);
+    Writer.EndObject();
+}
+
+void FUnrealMCPActorQuery::WriteFields(FUnrealMCPJsonWriter& Writer, const AActor* Actor) const
+{
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Name))
+    {
+        Writer.WriteField(TEXT("name"), Actor->GetName());
+    }
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Class))
+    {
+        Writer.WriteField(TEXT("class"), Actor->GetClass()->GetName());
+    }
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Label))
+    {
+        Writer.WriteField(TEXT("label"), Actor->GetActorLabel());
+    }
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Level))
+    {
+        const ULevel* Level = Actor->GetLevel();
+        Writer.WriteField(TEXT("level"), Level ? Level->GetOutermost()->GetName() : FString());
+    }
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Location))
+    {
+        const FVector Location = Actor->GetActorLocation();
+        Writer.WriteKey(TEXT("location"));
+        Writer.WriteVector(Location.X, Location.Y, Location.Z);
+    }
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Rotation))
+    {
+        const FRotator Rotation = Actor->GetActorRotation();
+        Writer.WriteKey(TEXT("rotation"));
+        Writer.WriteVector(Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+    }
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Scale))
+    {
+        const FVector Scale = Actor->GetActorScale3D();
+        Writer.WriteKey(TEXT("scale"));
+        Writer.WriteVector(Scale.X, Scale.Y, Scale.Z);
+    }
+    if (EnumHasAnyFlags(Fields, EUnrealMCPActorFields::Tags))
+    {
+        Writer.WriteKey(TEXT("tags"));
+        Writer.BeginArray();
+        for (const FName& ActorTag : Actor->Tags)
+        {
+            // FName::ToString allocates; the inline buffer doesn't
+            TStringBuilder<128> TagText;
+            ActorTag.AppendString(TagText);
+            Writer.WriteValue(TagText.ToView());
+        }
+        Writer.EndArray();
+    }
+}
+
+bool FUnrealMCPActorQuery::CollectPage(UWorld* World, FUnrealMCPActorCursor& InOutCursor, int32 MaxActors, FUnrealMCPJsonWriter& Writer, int32& OutCount) const
+{
+    const TArray<ULevel*>& Levels = World->GetLevels();
+    OutCount = 0;
+    if (bMatchesNothing)
+    {
+        // An empty last page, without walking the level
+        InOutCursor.Level = Levels.Num();
+        InOutCursor.Actor = 0;
+        return false;
+    }
+
+    for (; InOutCursor.Level < Levels.Num(); ++InOutCursor.Level, InOutCursor.Actor = 0)
+    {
+        // Same levels TActorIterator visits
+        const ULevel* Level = Levels[InOutCursor.Level];
+        if (!Level || !Level->bIsVisible)
+        {
+            continue;
+        }
+
+        const TArray<AActor*>& Actors = Level->Actors;
+        for (; InOutCursor.Actor < Actors.Num(); ++InOutCursor.Actor)
+        {
+            if (MaxActors > 0 && OutCount >= MaxActors)
+            {
+                return true;
+            }
+
+            AActor* Actor = Actors[InOutCursor.Actor];
+            if (IsValid(Actor) && Matches(Actor))
+            {
+                Write(Writer, Actor);
+                ++OutCount;
+            }
+        }
+    }
+
+    return false;
+}
+
+void FUnrealMCPActorStream::Start(UWorld* World, const FUnrealMCPActorQuery& Query, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete)
+{
+    check(IsInGameThread());
+
+    TSharedRef<FUnrealMCPActorStream> Stream = MakeShared<FUnrealMCPActorStream>(World, Query, MoveTemp(OnProgress), MoveTemp(OnComplete));
+
+    // The ticker owns the stream until its last page has been sent
+    Stream->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Stream](float DeltaTime)
+    {
+        return Stream->Tick(DeltaTime);
+    }));
+}
+
+FUnrealMCPActorStream::FUnrealMCPActorStream(UWorld* InWorld, const FUnrealMCPActorQuery& InQuery, FUnrealMCPCommandProgress InOnProgress, FUnrealMCPCommandCompletion InOnComplete)
+    : World(InWorld)
+    , Query(InQuery)
+    , OnProgress(MoveTemp(InOnProgress))
+    , OnComplete(MoveTemp(InOnComplete))
+    , Cursor(InQuery.Cursor)
+    , StartTime(FPlatformTime::Seconds())
+    , GatheredWriter(Gathered)
+{
+    if (Query.Limit <= 0)
+    {
+        Query.Limit = DefaultPageSize;
+    }
+    Query.Limit = FMath::Min(Query.Limit, MaxPageSize);
+
+    if (!OnProgress)
+    {
+        GatheredWriter.BeginArray();
+    }
+}
+
+bool FUnrealMCPActorStream::Tick(float DeltaTime)
+{
+    UWorld* StreamWorld = World.Get();
+    if (!IsValid(StreamWorld))
+    {
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("World was unloaded while listing actors")), {});
+        return false;
+    }
+
+    // Pages go straight into the gathered array when nobody is listening for progress
+    TArray<uint8> PageJson;
+    FUnrealMCPJsonWriter PageWriter(PageJson);
+    FUnrealMCPJsonWriter& Writer = OnProgress ? PageWriter : GatheredWriter;
+    if (OnProgress)
+    {
+        PageWriter.BeginArray();
+    }
+
+    const double PageStart = FPlatformTime::Seconds();
+    int32 PageCount = 0;
+    const bool bMore = Query.CollectPage(StreamWorld, Cursor, Query.Limit, Writer, PageCount);
+    GameThreadSeconds += FPlatformTime::Seconds() - PageStart;
+    Total += PageCount;
+    if (PageCount > 0)
+    {
+        ++Pages;
+    }
+
+    if (OnProgress && PageCount > 0)
+    {
+        PageWriter.EndArray();
+        TSharedPtr<FJsonObject> PageResult = MakeShared<FJsonObject>();
+        PageResult->SetNumberField(TEXT("page"), Pages);
+        PageResult->SetNumberField(TEXT("count"), PageCount);
+        PageResult->SetField(TEXT("actors"), MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(PageJson)));
+        if (!OnProgress(PageResult, {}))
+        {
+            // The client is gone; don't keep walking the level for nobody
+            TickerHandle.Reset();
+            OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Client disconnected while listing actors")), {});
+            return false;
+        }
+    }
+
+    if (bMore)
+    {
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("count"), Total);
+    ResultObj->SetNumberField(TEXT("pages"), Pages);
+    ResultObj->SetBoolField(TEXT("streamed"), (bool)OnProgress);
+    ResultObj->SetNumberField(TEXT("game_thread_ms"), GameThreadSeconds * 1000.0);
+    ResultObj->SetNumberField(TEXT("total_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    if (!OnProgress)
+    {
+        GatheredWriter.EndArray();
+        ResultObj->SetField(TEXT("actors"), MakeShared<FUnrealMCPJsonValueRaw>(MoveTemp(Gathered)));
+    }
+
+    TickerHandle.Reset();
+    OnComplete(ResultObj, {});
+    return false;
+}
@@ -1,5 +1,6 @@
 #include "Commands/UnrealMCPBlueprintCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Factories/BlueprintFactory.h"
@@ -25,46 +26,17 @@ FUnrealMCPBlueprintCommands::FUnrealMCPBlueprintCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPBlueprintCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("create_blueprint"))
-    {
-        return HandleCreateBlueprint(Params);
-    }
-    else if (CommandType == TEXT("add_component_to_blueprint"))
-    {
-        return HandleAddComponentToBlueprint(Params);
-    }
-    else if (CommandType == TEXT("set_component_property"))
-    {
-        return HandleSetComponentProperty(Params);
-    }
-    else if (CommandType == TEXT("set_physics_properties"))
-    {
-        return HandleSetPhysicsProperties(Params);
-    }
-    else if (CommandType == TEXT("compile_blueprint"))
-    {
-        return HandleCompileBlueprint(Params);
-    }
-    else if (CommandType == TEXT("spawn_blueprint_actor"))
-    {
-        return HandleSpawnBlueprintActor(Params);
-    }
-    else if (CommandType == TEXT("set_blueprint_property"))
-    {
-        return HandleSetBlueprintProperty(Params);
-    }
-    else if (CommandType == TEXT("set_static_mesh_properties"))
-    {
-        return HandleSetStaticMeshProperties(Params);
-    }
-    else if (CommandType == TEXT("set_pawn_properties"))
-    {
-        return HandleSetPawnProperties(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint command: %s"), *CommandType));
+    Registry.Register(TEXT("create_blueprint"), this, &FUnrealMCPBlueprintCommands::HandleCreateBlueprint, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::Medium);
+    Registry.Register(TEXT("add_component_to_blueprint"), this, &FUnrealMCPBlueprintCommands::HandleAddComponentToBlueprint);
+    Registry.Register(TEXT("set_component_property"), this, &FUnrealMCPBlueprintCommands::HandleSetComponentProperty);
+    Registry.Register(TEXT("set_physics_properties"), this, &FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties);
+    Registry.Register(TEXT("compile_blueprint"), this, &FUnrealMCPBlueprintCommands::HandleCompileBlueprint, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::High);
+    Registry.Register(TEXT("spawn_blueprint_actor"), this, &FUnrealMCPBlueprintCommands::HandleSpawnBlueprintActor);
+    Registry.Register(TEXT("set_blueprint_property"), this, &FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty);
+    Registry.Register(TEXT("set_static_mesh_properties"), this, &FUnrealMCPBlueprintCommands::HandleSetStaticMeshProperties);
+    Registry.Register(TEXT("set_pawn_properties"), this, &FUnrealMCPBlueprintCommands::HandleSetPawnProperties);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -1,5 +1,6 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "EdGraph/EdGraph.h"
@@ -24,46 +25,17 @@ FUnrealMCPBlueprintNodeCommands::FUnrealMCPBlueprintNodeCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPBlueprintNodeCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("connect_blueprint_nodes"))
-    {
-        return HandleConnectBlueprintNodes(Params);
-    }
-    else if (CommandType == TEXT("create_input_mapping"))
-    {
-        return HandleCreateInputMapping(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_get_self_component_reference"))
-    {
-        return HandleAddBlueprintGetSelfComponentReference(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_event_node"))
-    {
-        return HandleAddBlueprintEvent(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_function_node"))
-    {
-        return HandleAddBlueprintFunctionCall(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_variable"))
-    {
-        return HandleAddBlueprintVariable(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_input_action_node"))
-    {
-        return HandleAddBlueprintInputActionNode(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_self_reference"))
-    {
-        return HandleAddBlueprintSelfReference(Params);
-    }
-    else if (CommandType == TEXT("find_blueprint_nodes"))
-    {
-        return HandleFindBlueprintNodes(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint node command: %s"), *CommandType));
+    Registry.Register(TEXT("connect_blueprint_nodes"), this, &FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes);
+    Registry.Register(TEXT("create_input_mapping"), this, &FUnrealMCPBlueprintNodeCommands::HandleCreateInputMapping);
+    Registry.Register(TEXT("add_blueprint_get_self_component_reference"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSelfComponentReference);
+    Registry.Register(TEXT("add_blueprint_event_node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintEvent);
+    Registry.Register(TEXT("add_blueprint_function_node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunctionCall);
+    Registry.Register(TEXT("add_blueprint_variable"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintVariable);
+    Registry.Register(TEXT("add_blueprint_input_action_node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintInputActionNode);
+    Registry.Register(TEXT("add_blueprint_self_reference"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintSelfReference);
+    Registry.Register(TEXT("find_blueprint_nodes"), this, &FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNodes, EUnrealMCPCommandFlags::ReadOnly, EUnrealMCPCommandCost::Medium);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes(const TSharedPtr<FJsonObject>& Params)
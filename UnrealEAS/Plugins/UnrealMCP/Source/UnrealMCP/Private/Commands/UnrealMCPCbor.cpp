@@ -0,0 +1,809 @@
+#include "Commands/UnrealMCPCbor.h"
+#include "Commands/UnrealMCPJsonWriter.h"
+#include "Containers/StringConv.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    namespace ECborMajor
+    {
+        enum Type : uint8
+        {
+            UnsignedInt = 0,
+            NegativeInt = 1,
+            ByteString = 2,
+            TextString = 3,
+            Array = 4,
+            Map = 5,
+            Tag = 6,
+            Simple = 7,
+        };
+    }
+
+    constexpr uint8 CborFalse = 0xF4;
+    constexpr uint8 CborTrue = 0xF5;
+    constexpr uint8 CborNull = 0xF6;
+    constexpr uint8 CborFloat32 = 0xFA;
+    constexpr uint8 CborFloat64 = 0xFB;
+    constexpr uint8 CborBreak = 0xFF;
+    constexpr uint8 IndefiniteLength = 31;
+
+    // Requests are small; anything nested deeper than this is malformed or hostile
+    constexpr int32 MaxDepth = 256;
+
+    // Doubles beyond this can't all be told apart from their integer neighbours
+    constexpr double MaxExactInteger = 9007199254740992.0;
+
+    void AppendBigEndian(TArray<uint8>& Buffer, uint64 Value, int32 Size)
+    {
+        for (int32 Shift = (Size - 1) * 8; Shift >= 0; Shift -= 8)
+        {
+            Buffer.Add((uint8)(Value >> Shift));
+        }
+    }
+
+    void AppendHead(TArray<uint8>& Buffer, uint8 MajorType, uint64 Argument)
+    {
+        const uint8 Initial = (uint8)(MajorType << 5);
+        if (Argument < 24)
+        {
+            Buffer.Add(Initial | (uint8)Argument);
+        }
+        else if (Argument <= MAX_uint8)
+        {
+            Buffer.Add(Initial | 24);
+            AppendBigEndian(Buffer, Argument, 1);
+        }
+        else if (Argument <= MAX_uint16)
+        {
+            Buffer.Add(Initial | 25);
+            AppendBigEndian(Buffer, Argument, 2);
+        }
+        else if (Argument <= MAX_uint32)
+        {
+            Buffer.Add(Initial | 26);
+            AppendBigEndian(Buffer, Argument, 4);
+        }
+        else
+        {
+            Buffer.Add(Initial | 27);
+            AppendBigEndian(Buffer, Argument, 8);
+        }
+    }
+
+    void AppendInt(TArray<uint8>& Buffer, int64 Value)
+    {
+        if (Value >= 0)
+        {
+            AppendHead(Buffer, ECborMajor::UnsignedInt, (uint64)Value);
+        }
+        else
+        {
+            AppendHead(Buffer, ECborMajor::NegativeInt, (uint64)(-1 - Value));
+        }
+    }
+
+    void AppendDouble(TArray<uint8>& Buffer, double Value)
+    {
+        if (!FMath::IsFinite(Value))
+        {
+            // Matches the JSON writer, which has no other choice
+            Buffer.Add(CborNull);
+            return;
+        }
+        if (Value == FMath::TruncToDouble(Value) && FMath::Abs(Value) <= MaxExactInteger)
+        {
+            AppendInt(Buffer, (int64)Value);
+            return;
+        }
+
+        const float Single = (float)Value;
+        if ((double)Single == Value)
+        {
+            uint32 Bits;
+            FMemory::Memcpy(&Bits, &Single, sizeof(Bits));
+            Buffer.Add(CborFloat32);
+            AppendBigEndian(Buffer, Bits, 4);
+        }
+        else
+        {
+            uint64 Bits;
+            FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+            Buffer.Add(CborFloat64);
+            AppendBigEndian(Buffer, Bits, 8);
+        }
+    }
+
+    void AppendText(TArray<uint8>& Buffer, const uint8* Utf8, int32 Length)
+    {
+        AppendHead(Buffer, ECborMajor::TextString, (uint64)Length);
+        Buffer.Append(Utf8, Length);
+    }
+
+    void AppendUtf8(TArray<uint8>& Buffer, uint32 CodePoint)
+    {
+        if (CodePoint < 0x80)
+        {
+            Buffer.Add((uint8)CodePoint);
+        }
+        else if (CodePoint < 0x800)
+        {
+            const uint8 Bytes[2] = { (uint8)(0xC0 | (CodePoint >> 6)), (uint8)(0x80 | (CodePoint & 0x3F)) };
+            Buffer.Append(Bytes, 2);
+        }
+        else if (CodePoint < 0x10000)
+        {
+            const uint8 Bytes[3] = { (uint8)(0xE0 | (CodePoint >> 12)), (uint8)(0x80 | ((CodePoint >> 6) & 0x3F)), (uint8)(0x80 | (CodePoint & 0x3F)) };
+            Buffer.Append(Bytes, 3);
+        }
+        else
+        {
+            const uint8 Bytes[4] = { (uint8)(0xF0 | (CodePoint >> 18)), (uint8)(0x80 | ((CodePoint >> 12) & 0x3F)),
+                                     (uint8)(0x80 | ((CodePoint >> 6) & 0x3F)), (uint8)(0x80 | (CodePoint & 0x3F)) };
+            Buffer.Append(Bytes, 4);
+        }
+    }
+
+    /**
+     * Streams compact JSON straight into CBOR without building a DOM. Strings without
+     * escapes are already UTF-8 and are copied as they are.
+     */
+    class FJsonToCbor
+    {
+    public:
+        FJsonToCbor(TConstArrayView<uint8> Json, TArray<uint8>& InBuffer)
+            : Pos(Json.GetData())
+            , End(Json.GetData() + Json.Num())
+            , Buffer(InBuffer)
+        {
+        }
+
+        bool Transcode()
+        {
+            return Value(0);
+        }
+
+    private:
+        void SkipSpace()
+        {
+            while (Pos < End && (*Pos == ' ' || *Pos == '\t' || *Pos == '\r' || *Pos == '\n'))
+            {
+                ++Pos;
+            }
+        }
+
+        bool Consume(uint8 Char)
+        {
+            SkipSpace();
+            if (Pos < End && *Pos == Char)
+            {
+                ++Pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool Value(int32 Depth)
+        {
+            SkipSpace();
+            if (Pos >= End || Depth > MaxDepth)
+            {
+                return false;
+            }
+
+            switch (*Pos)
+            {
+            case '{':
+                ++Pos;
+                Buffer.Add(0xBF);
+                if (!Consume('}'))
+                {
+                    do
+                    {
+                        SkipSpace();
+                        if (!String() || !Consume(':') || !Value(Depth + 1))
+                        {
+                            return false;
+                        }
+                    } while (Consume(','));
+                    if (!Consume('}'))
+                    {
+                        return false;
+                    }
+                }
+                Buffer.Add(CborBreak);
+                return true;
+            case '[':
+                ++Pos;
+                Buffer.Add(0x9F);
+                if (!Consume(']'))
+                {
+                    do
+                    {
+                        if (!Value(Depth + 1))
+                        {
+                            return false;
+                        }
+                    } while (Consume(','));
+                    if (!Consume(']'))
+                    {
+                        return false;
+                    }
+                }
+                Buffer.Add(CborBreak);
+                return true;
+            case '"':
+                return String();
+            case 't':
+                return Literal("true", CborTrue);
+            case 'f':
+                return Literal("false", CborFalse);
+            case 'n':
+                return Literal("null", CborNull);
+            default:
+                return Number();
+            }
+        }
+
+        bool Literal(const ANSICHAR* Text, uint8 Code)
+        {
+            const int32 Length = FCStringAnsi::Strlen(Text);
+            if (End - Pos < Length || FMemory::Memcmp(Pos, Text, Length) != 0)
+            {
+                return false;
+            }
+            Pos += Length;
+            Buffer.Add(Code);
+            return true;
+        }
+
+        bool Number()
+        {
+            const uint8* Start = Pos;
+            bool bIntegral = true;
+            while (Pos < End && ((*Pos >= '0' && *Pos <= '9') || *Pos == '-' || *Pos == '+' || *Pos == '.' || *Pos == 'e' || *Pos == 'E'))
+            {
+                bIntegral = bIntegral && *Pos != '.' && *Pos != 'e' && *Pos != 'E';
+                ++Pos;
+            }
+
+            ANSICHAR Text[64];
+            const int32 Length = (int32)(Pos - Start);
+            if (Length == 0 || Length >= UE_ARRAY_COUNT(Text))
+            {
+                return false;
+            }
+            FMemory::Memcpy(Text, Start, Length);
+            Text[Length] = '\0';
+
+            // Up to 18 digits always fit in an int64
+            if (bIntegral && Length <= 18)
+            {
+                AppendInt(Buffer, FCStringAnsi::Atoi64(Text));
+            }
+            else
+            {
+                AppendDouble(Buffer, FCStringAnsi::Atod(Text));
+            }
+            return true;
+        }
+
+        bool String()
+        {
+            if (Pos >= End || *Pos != '"')
+            {
+                return false;
+            }
+            const uint8* Start = ++Pos;
+            while (Pos < End && *Pos != '"' && *Pos != '\\')
+            {
+                ++Pos;
+            }
+            if (Pos >= End)
+            {
+                return false;
+            }
+            if (*Pos == '"')
+            {
+                AppendText(Buffer, Start, (int32)(Pos++ - Start));
+                return true;
+            }
+
+            Scratch.Reset();
+            Scratch.Append(Start, (int32)(Pos - Start));
+            while (Pos < End && *Pos != '"')
+            {
+                if (*Pos != '\\')
+                {
+                    Scratch.Add(*Pos++);
+                    continue;
+                }
+                if (++Pos >= End)
+                {
+                    return false;
+                }
+                switch (*Pos++)
+                {
+                case '"':  Scratch.Add('"'); break;
+                case '\\': Scratch.Add('\\'); break;
+                case '/':  Scratch.Add('/'); break;
+                case 'n':  Scratch.Add('\n'); break;
+                case 'r':  Scratch.Add('\r'); break;
+                case 't':  Scratch.Add('\t'); break;
+                case 'b':  Scratch.Add('\b'); break;
+                case 'f':  Scratch.Add('\f'); break;
+                case 'u':
+                {
+                    uint32 CodePoint = 0;
+                    if (!Hex4(CodePoint))
+                    {
+                        return false;
+                    }
+                    uint32 Low = 0;
+                    if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && End - Pos >= 6 && Pos[0] == '\\' && Pos[1] == 'u')
+                    {
+                        Pos += 2;
+                        if (!Hex4(Low))
+                        {
+                            return false;
+                        }
+                        if (Low >= 0xDC00 && Low <= 0xDFFF)
+                        {
+                            CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+                            Low = 0;
+                        }
+                    }
+                    AppendUtf8(Scratch, CodePoint);
+                    if (Low != 0)
+                    {
+                        AppendUtf8(Scratch, Low);
+                    }
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            if (Pos >= End)
+            {
+                return false;
+            }
+            ++Pos;
+            AppendText(Buffer, Scratch.GetData(), Scratch.Num());
+            return true;
+        }
+
+        bool Hex4(uint32& OutValue)
+        {
+            if (End - Pos < 4)
+            {
+                return false;
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < 4; ++Index)
+            {
+                const uint8 Char = *Pos++;
+                if (!FChar::IsHexDigit((TCHAR)Char))
+                {
+                    return false;
+                }
+                OutValue = (OutValue << 4) | (uint32)FParse::HexDigit((TCHAR)Char);
+            }
+            return true;
+        }
+
+        const uint8* Pos;
+        const uint8* End;
+        TArray<uint8>& Buffer;
+        TArray<uint8> Scratch;
+    };
+
+    class FCborToJson
+    {
+    public:
+        explicit FCborToJson(TConstArrayView<uint8> Data)
+            : Pos(Data.GetData())
+            , End(Data.GetData() + Data.Num())
+        {
+        }
+
+        TSharedPtr<FJsonValue> Value(int32 Depth)
+        {
+            uint8 Major = 0;
+            uint8 Info = 0;
+            uint64 Argument = 0;
+            if (Depth > MaxDepth)
+            {
+                return Fail(TEXT("CBOR nested too deeply"));
+            }
+            if (!Head(Major, Info, Argument))
+            {
+                return nullptr;
+            }
+
+            switch (Major)
+            {
+            case ECborMajor::UnsignedInt:
+                return MakeShared<FJsonValueNumber>((double)Argument);
+            case ECborMajor::NegativeInt:
+                return MakeShared<FJsonValueNumber>(-1.0 - (double)Argument);
+            case ECborMajor::TextString:
+            {
+                FString Text;
+                return ReadText(Info, Argument, Text) ? MakeShared<FJsonValueString>(MoveTemp(Text)) : nullptr;
+            }
+            case ECborMajor::Array:
+            {
+                TArray<TSharedPtr<FJsonValue>> Elements;
+                for (uint64 Index = 0; Info == IndefiniteLength ? !Break() : Index < Argument; ++Index)
+                {
+                    TSharedPtr<FJsonValue> Element = Value(Depth + 1);
+                    if (!Element.IsValid())
+                    {
+                        return nullptr;
+                    }
+                    Elements.Add(MoveTemp(Element));
+                }
+                return MakeShared<FJsonValueArray>(MoveTemp(Elements));
+            }
+            case ECborMajor::Map:
+            {
+                TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+                for (uint64 Index = 0; Info == IndefiniteLength ? !Break() : Index < Argument; ++Index)
+                {
+                    uint8 KeyMajor = 0;
+                    uint8 KeyInfo = 0;
+                    uint64 KeyArgument = 0;
+                    FString Key;
+                    if (!Head(KeyMajor, KeyInfo, KeyArgument))
+                    {
+                        return nullptr;
+                    }
+                    if (KeyMajor != ECborMajor::TextString)
+                    {
+                        return Fail(TEXT("CBOR map keys must be text"));
+                    }
+                    if (!ReadText(KeyInfo, KeyArgument, Key))
+                    {
+                        return nullptr;
+                    }
+                    TSharedPtr<FJsonValue> Element = Value(Depth + 1);
+                    if (!Element.IsValid())
+                    {
+                        return nullptr;
+                    }
+                    Object->SetField(Key, Element);
+                }
+                return MakeShared<FJsonValueObject>(Object);
+            }
+            case ECborMajor::Tag:
+                // Dates, bignums and the like arrive as whatever they wrap
+                return Value(Depth + 1);
+            case ECborMajor::Simple:
+                return SimpleValue(Info, Argument);
+            default:
+                return Fail(TEXT("CBOR byte strings are not supported"));
+            }
+        }
+
+        bool AtEnd() const { return Pos == End; }
+
+        FString Error;
+
+    private:
+        TSharedPtr<FJsonValue> Fail(const TCHAR* Message)
+        {
+            if (Error.IsEmpty())
+            {
+                Error = Message;
+            }
+            return nullptr;
+        }
+
+        bool Head(uint8& OutMajor, uint8& OutInfo, uint64& OutArgument)
+        {
+            if (Pos >= End)
+            {
+                Fail(TEXT("Truncated CBOR message"));
+                return false;
+            }
+
+            const uint8 Initial = *Pos++;
+            OutMajor = Initial >> 5;
+            OutInfo = Initial & 0x1F;
+            OutArgument = 0;
+            if (OutInfo < 24)
+            {
+                OutArgument = OutInfo;
+                return true;
+            }
+            if (OutInfo <= 27)
+            {
+                const int32 Size = 1 << (OutInfo - 24);
+                if (End - Pos < Size)
+                {
+                    Fail(TEXT("Truncated CBOR message"));
+                    return false;
+                }
+                for (int32 Index = 0; Index < Size; ++Index)
+                {
+                    OutArgument = (OutArgument << 8) | *Pos++;
+                }
+                return true;
+            }
+            if (OutInfo == IndefiniteLength && OutMajor >= ECborMajor::ByteString && OutMajor <= ECborMajor::Map)
+            {
+                return true;
+            }
+            Fail(TEXT("Malformed CBOR item"));
+            return false;
+        }
+
+        bool Break()
+        {
+            if (Pos < End && *Pos == CborBreak)
+            {
+                ++Pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool ReadText(uint8 Info, uint64 Argument, FString& OutText)
+        {
+            if (Info != IndefiniteLength)
+            {
+                if (Argument > (uint64)(End - Pos))
+                {
+                    Fail(TEXT("Truncated CBOR message"));
+                    return false;
+                }
+                FUTF8ToTCHAR Converted((const ANSICHAR*)Pos, (int32)Argument);
+                OutText = FString(Converted.Length(), Converted.Get());
+                Pos += Argument;
+                return true;
+            }
+
+            // Chunked text: definite-length pieces up to a break
+            TArray<uint8> Utf8;
+            while (!Break())
+            {
+                uint8 ChunkMajor = 0;
+                uint8 ChunkInfo = 0;
+                uint64 ChunkLength = 0;
+                if (!Head(ChunkMajor, ChunkInfo, ChunkLength))
+                {
+                    return false;
+                }
+                if (ChunkMajor != ECborMajor::TextString || ChunkInfo == IndefiniteLength || ChunkLength > (uint64)(End - Pos))
+                {
+                    Fail(TEXT("Malformed CBOR text"));
+                    return false;
+                }
+                Utf8.Append(Pos, (int32)ChunkLength);
+                Pos += ChunkLength;
+            }
+            FUTF8ToTCHAR Converted((const ANSICHAR*)Utf8.GetData(), Utf8.Num());
+            OutText = FString(Converted.Length(), Converted.Get());
+            return true;
+        }
+
+        TSharedPtr<FJsonValue> SimpleValue(uint8 Info, uint64 Argument)
+        {
+            switch (Info)
+            {
+            case 20:
+                return MakeShared<FJsonValueBoolean>(false);
+            case 21:
+                return MakeShared<FJsonValueBoolean>(true);
+            case 22:
+            case 23:
+                return MakeShared<FJsonValueNull>();
+            case 25:
+                if (((Argument >> 10) & 0x1F) == 0x1F)
+                {
+                    return Fail(TEXT("CBOR infinities and NaNs are not supported"));
+                }
+                return MakeShared<FJsonValueNumber>(HalfToDouble((uint16)Argument));
+            case 26:
+            {
+                const uint32 Bits = (uint32)Argument;
+                float Single;
+                FMemory::Memcpy(&Single, &Bits, sizeof(Single));
+                return MakeShared<FJsonValueNumber>(Single);
+            }
+            case 27:
+            {
+                double Double;
+                FMemory::Memcpy(&Double, &Argument, sizeof(Double));
+                return MakeShared<FJsonValueNumber>(Double);
+            }
+            default:
+                return Fail(TEXT("Unsupported CBOR simple value"));
+            }
+        }
+
+        static double HalfToDouble(uint16 Half)
+        {
+            const int32 Exponent = (Half >> 10) & 0x1F;
+            const int32 Mantissa = Half & 0x3FF;
+            const double Magnitude = Exponent == 0
+                ? Mantissa * FMath::Pow(2.0, -24.0)
+                : (Mantissa + 1024) * FMath::Pow(2.0, (double)(Exponent - 25));
+            return (Half & 0x8000) ? -Magnitude : Magnitude;
+        }
+
+        const uint8* Pos;
+        const uint8* End;
+    };
+}
+
+FUnrealMCPCborWriter::FUnrealMCPCborWriter(TArray<uint8>& InBuffer)
+    : Buffer(InBuffer)
+{
+}
+
+void FUnrealMCPCborWriter::BeginObject()
+{
+    Buffer.Add((uint8)((ECborMajor::Map << 5) | IndefiniteLength));
+}
+
+void FUnrealMCPCborWriter::EndObject()
+{
+    Buffer.Add(CborBreak);
+}
+
+void FUnrealMCPCborWriter::BeginArray()
+{
+    Buffer.Add((uint8)((ECborMajor::Array << 5) | IndefiniteLength));
+}
+
+void FUnrealMCPCborWriter::EndArray()
+{
+    Buffer.Add(CborBreak);
+}
+
+void FUnrealMCPCborWriter::WriteKey(FStringView Key)
+{
+    WriteValue(Key);
+}
+
+void FUnrealMCPCborWriter::WriteValue(FStringView Value)
+{
+    FTCHARToUTF8 Utf8(Value.GetData(), Value.Len());
+    WriteUtf8((const uint8*)Utf8.Get(), Utf8.Length());
+}
+
+void FUnrealMCPCborWriter::WriteValue(double Value)
+{
+    AppendDouble(Buffer, Value);
+}
+
+void FUnrealMCPCborWriter::WriteValue(int64 Value)
+{
+    AppendInt(Buffer, Value);
+}
+
+void FUnrealMCPCborWriter::WriteValue(bool bValue)
+{
+    Buffer.Add(bValue ? CborTrue : CborFalse);
+}
+
+void FUnrealMCPCborWriter::WriteNull()
+{
+    Buffer.Add(CborNull);
+}
+
+void FUnrealMCPCborWriter::WriteVector(double X, double Y, double Z)
+{
+    WriteHead(ECborMajor::Array, 3);
+    WriteValue(X);
+    WriteValue(Y);
+    WriteValue(Z);
+}
+
+void FUnrealMCPCborWriter::WriteRaw(TConstArrayView<uint8> Json)
+{
+    const int32 Start = Buffer.Num();
+    if (!FJsonToCbor(Json, Buffer).Transcode())
+    {
+        // Only our own writer produces raw values, so this means a handler bug
+        UE_LOG(LogTemp, Error, TEXT("UnrealMCP: Could not transcode %d bytes of JSON to CBOR"), Json.Num());
+        Buffer.SetNum(Start, EAllowShrinking::No);
+        WriteNull();
+    }
+}
+
+void FUnrealMCPCborWriter::WriteJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+    if (!Value.IsValid())
+    {
+        WriteNull();
+        return;
+    }
+
+    if (const FUnrealMCPJsonValueRaw* Raw = FUnrealMCPJsonValueRaw::Cast(Value))
+    {
+        WriteRaw(Raw->GetJson());
+        return;
+    }
+
+    switch (Value->Type)
+    {
+    case EJson::String:
+        WriteValue(Value->AsString());
+        break;
+    case EJson::Number:
+        WriteValue(Value->AsNumber());
+        break;
+    case EJson::Boolean:
+        WriteValue(Value->AsBool());
+        break;
+    case EJson::Array:
+    {
+        const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+        WriteHead(ECborMajor::Array, Elements.Num());
+        for (const TSharedPtr<FJsonValue>& Element : Elements)
+        {
+            WriteJsonValue(Element);
+        }
+        break;
+    }
+    case EJson::Object:
+        WriteJsonObject(Value->AsObject());
+        break;
+    default:
+        WriteNull();
+        break;
+    }
+}
+
+void FUnrealMCPCborWriter::WriteJsonObject(const TSharedPtr<FJsonObject>& Object)
+{
+    if (!Object.IsValid())
+    {
+        WriteNull();
+        return;
+    }
+
+    // DOM containers know their size, which saves the break byte
+    WriteHead(ECborMajor::Map, Object->Values.Num());
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+    {
+        WriteKey(Field.Key);
+        WriteJsonValue(Field.Value);
+    }
+}
+
+void FUnrealMCPCborWriter::WriteHead(uint8 MajorType, uint64 Argument)
+{
+    AppendHead(Buffer, MajorType, Argument);
+}
+
+void FUnrealMCPCborWriter::WriteUtf8(const uint8* Text, int32 Length)
+{
+    AppendText(Buffer, Text, Length);
+}
+
+bool FUnrealMCPCborReader::ReadObject(TConstArrayView<uint8> Data, TSharedPtr<FJsonObject>& OutObject, FString& OutError)
+{
+    FCborToJson Decoder(Data);
+    TSharedPtr<FJsonValue> Value = Decoder.Value(0);
+    if (!Value.IsValid())
+    {
+        OutError = Decoder.Error;
+        return false;
+    }
+    if (Value->Type != EJson::Object)
+    {
+        OutError = TEXT("CBOR message must be a map");
+        return false;
+    }
+    if (!Decoder.AtEnd())
+    {
+        OutError = TEXT("Trailing bytes after CBOR message");
+        return false;
+    }
+    OutObject = Value->AsObject();
+    return true;
+}
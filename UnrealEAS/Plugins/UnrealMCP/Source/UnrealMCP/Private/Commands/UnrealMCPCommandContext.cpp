@@ -0,0 +1,47 @@
+#include "Commands/UnrealMCPCommandContext.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+    // Contexts are only created and used on the game thread
+    FUnrealMCPCommandContext* GActiveCommandContext = nullptr;
+}
+
+FUnrealMCPCommandContext::FUnrealMCPCommandContext()
+    : Outer(GActiveCommandContext)
+{
+    check(IsInGameThread());
+    GActiveCommandContext = this;
+}
+
+FUnrealMCPCommandContext::~FUnrealMCPCommandContext()
+{
+    check(GActiveCommandContext == this);
+    GActiveCommandContext = Outer;
+}
+
+FUnrealMCPCommandContext* FUnrealMCPCommandContext::Get()
+{
+    return IsInGameThread() ? GActiveCommandContext : nullptr;
+}
+
+AActor* FUnrealMCPCommandContext::GetCachedActorByClass(const FString& ClassName) const
+{
+    const TWeakObjectPtr<AActor>* Found = ActorsByClass.Find(ClassName);
+    if (!Found)
+    {
+        return nullptr;
+    }
+
+    // Actors deleted by an earlier command in the scope simply miss the cache
+    AActor* Actor = Found->Get();
+    return IsValid(Actor) ? Actor : nullptr;
+}
+
+void FUnrealMCPCommandContext::SetCachedActorByClass(const FString& ClassName, AActor* Actor)
+{
+    if (IsValid(Actor))
+    {
+        ActorsByClass.Add(ClassName, Actor);
+    }
+}
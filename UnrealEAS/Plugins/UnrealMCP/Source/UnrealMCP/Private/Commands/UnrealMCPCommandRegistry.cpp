@@ -0,0 +1,34 @@
+#include "Commands/UnrealMCPCommandRegistry.h"
+
+FUnrealMCPCommandInfo& FUnrealMCPCommandRegistry::Add(FName Name, EUnrealMCPCommandFlags Flags, EUnrealMCPCommandCost Cost)
+{
+    ensureMsgf(!Commands.Contains(Name), TEXT("UnrealMCP command '%s' registered twice"), *Name.ToString());
+
+    FUnrealMCPCommandInfo& Info = Commands.Add(Name);
+    Info.Name = Name;
+    Info.Flags = Flags;
+    Info.Cost = Cost;
+    return Info;
+}
+
+void FUnrealMCPCommandRegistry::Register(FName Name, FUnrealMCPCommandHandler Handler, EUnrealMCPCommandFlags Flags, EUnrealMCPCommandCost Cost)
+{
+    Add(Name, Flags, Cost).Handler = MoveTemp(Handler);
+}
+
+void FUnrealMCPCommandRegistry::RegisterAsync(FName Name, FUnrealMCPAsyncCommandHandler Handler, EUnrealMCPCommandFlags Flags, EUnrealMCPCommandCost Cost)
+{
+    Add(Name, Flags, Cost).AsyncHandler = MoveTemp(Handler);
+}
+
+void FUnrealMCPCommandRegistry::RegisterStreaming(FName Name, FUnrealMCPStreamingCommandHandler Handler, EUnrealMCPCommandFlags Flags, EUnrealMCPCommandCost Cost)
+{
+    Add(Name, Flags, Cost).StreamingHandler = MoveTemp(Handler);
+}
+
+const FUnrealMCPCommandInfo* FUnrealMCPCommandRegistry::Find(const FString& CommandType) const
+{
+    // FNAME_Find never grows the name table, so arbitrary client input is safe to look up
+    const FName Name(*CommandType, FNAME_Find);
+    return Name.IsNone() ? nullptr : Commands.Find(Name);
+}
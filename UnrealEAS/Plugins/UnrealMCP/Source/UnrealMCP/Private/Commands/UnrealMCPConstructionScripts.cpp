@@ -0,0 +1,117 @@
+#include "Commands/UnrealMCPConstructionScripts.h"
+#include "GameFramework/Actor.h"
+
+FUnrealMCPConstructionScripts& FUnrealMCPConstructionScripts::Get()
+{
+    static FUnrealMCPConstructionScripts Instance;
+    return Instance;
+}
+
+bool FUnrealMCPConstructionScripts::Request(AActor* Actor)
+{
+    check(IsInGameThread());
+
+    if (!IsValid(Actor))
+    {
+        return false;
+    }
+
+    ++TotalRequests;
+    if (Pending.Contains(Actor))
+    {
+        return false;
+    }
+    Pending.Add(Actor, Actor);
+
+    if (ScopeDepth == 0 && !TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUnrealMCPConstructionScripts::Tick));
+    }
+    return true;
+}
+
+int32 FUnrealMCPConstructionScripts::Flush()
+{
+    check(IsInGameThread());
+
+    if (Pending.Num() == 0)
+    {
+        return 0;
+    }
+
+    // A construction script may write properties of its own; those land in the next flush
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    Pending.GenerateValueArray(Actors);
+    Pending.Reset();
+
+    int32 Reruns = 0;
+    for (const TWeakObjectPtr<AActor>& WeakActor : Actors)
+    {
+        // Actors deleted since the request need no rebuild
+        AActor* Actor = WeakActor.Get();
+        if (IsValid(Actor))
+        {
+            Actor->RerunConstructionScripts();
+            ++Reruns;
+        }
+    }
+    TotalReruns += Reruns;
+    return Reruns;
+}
+
+void FUnrealMCPConstructionScripts::Shutdown()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    Pending.Reset();
+}
+
+bool FUnrealMCPConstructionScripts::Tick(float DeltaTime)
+{
+    TickerHandle.Reset();
+
+    const int32 Reruns = Flush();
+    UE_LOG(LogTemp, Verbose, TEXT("UnrealMCP: Reran %d construction scripts for this frame's property writes"), Reruns);
+    return false;
+}
+
+FUnrealMCPConstructionScripts::FScope::FScope()
+{
+    FUnrealMCPConstructionScripts& Scripts = FUnrealMCPConstructionScripts::Get();
+    check(IsInGameThread());
+    ++Scripts.ScopeDepth;
+    StartRequests = Scripts.TotalRequests;
+    StartReruns = Scripts.TotalReruns;
+}
+
+FUnrealMCPConstructionScripts::FScope::~FScope()
+{
+    FUnrealMCPConstructionScripts& Scripts = FUnrealMCPConstructionScripts::Get();
+    check(Scripts.ScopeDepth > 0);
+    if (--Scripts.ScopeDepth == 0)
+    {
+        Scripts.Flush();
+    }
+}
+
+void FUnrealMCPConstructionScripts::FScope::Flush()
+{
+    FUnrealMCPConstructionScripts& Scripts = FUnrealMCPConstructionScripts::Get();
+    if (Scripts.ScopeDepth == 1)
+    {
+        Scripts.Flush();
+    }
+}
+
+int32 FUnrealMCPConstructionScripts::FScope::GetRequests() const
+{
+    return FUnrealMCPConstructionScripts::Get().TotalRequests - StartRequests;
+}
+
+int32 FUnrealMCPConstructionScripts::FScope::GetReruns() const
+{
+    return FUnrealMCPConstructionScripts::Get().TotalReruns - StartReruns;
+}
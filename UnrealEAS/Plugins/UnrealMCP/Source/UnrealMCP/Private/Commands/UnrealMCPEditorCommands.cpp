@@ -1,29 +1,23 @@
 #include "Commands/UnrealMCPEditorCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPImageDelivery.h"
+#include "Commands/UnrealMCPImageEncoder.h"
+#include "Commands/UnrealMCPViewportReadback.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
-#include "ImageUtils.h"
 #include "HighResScreenshot.h"
 #include "Engine/GameViewportClient.h"
-#include "Misc/FileHelper.h"
+#include "Async/Async.h"
 
 FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPEditorCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("focus_viewport"))
-    {
-        return HandleFocusViewport(Params);
-    }
-    else if (CommandType == TEXT("take_screenshot"))
-    {
-        return HandleTakeScreenshot(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
+    Registry.Register(TEXT("focus_viewport"), this, &FUnrealMCPEditorCommands::HandleFocusViewport);
+    Registry.RegisterAsync(TEXT("take_screenshot"), this, &FUnrealMCPEditorCommands::HandleTakeScreenshot, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::High);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSharedPtr<FJsonObject>& Params)
@@ -43,33 +37,89 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to focus viewport"));
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPEditorCommands::HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandCompletion OnComplete)
 {
+    EUnrealMCPImageDelivery Delivery;
+    FUnrealMCPImageEncodeSettings Encoding;
+    FString ErrorMessage;
+    if (!FUnrealMCPImageDelivery::ParseDelivery(Params, Delivery, ErrorMessage) ||
+        !FUnrealMCPImageEncoder::ParseSettings(Params, Encoding, ErrorMessage))
+    {
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage), {});
+        return;
+    }
+
+    // The path is only needed when the image goes to disk
     FString FilePath;
-    if (!Params->TryGetStringField(TEXT("filepath"), FilePath))
+    if (!Params->TryGetStringField(TEXT("filepath"), FilePath) && Delivery == EUnrealMCPImageDelivery::File)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'filepath' parameter"));
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'filepath' parameter")), {});
+        return;
     }
     
-    if (GEditor && GEditor->GetActiveViewport())
+    if (!GEditor || !GEditor->GetActiveViewport())
     {
-        FViewport* Viewport = GEditor->GetActiveViewport();
-        TArray<FColor> Bitmap;
-        FIntRect ViewportRect(0, 0, Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y);
-        
-        if (Viewport->ReadPixels(Bitmap, FReadSurfaceDataFlags(), ViewportRect))
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot")), {});
+        return;
+    }
+
+    // Async readback completes a few frames later without flushing the renderer
+    bool bAsyncReadback = true;
+    Params->TryGetBoolField(TEXT("async_readback"), bAsyncReadback);
+
+    const double StartTime = FPlatformTime::Seconds();
+    FUnrealMCPImageEncoder::Load();
+    FUnrealMCPViewportReadback::Get().Capture(GEditor->GetActiveViewport(), bAsyncReadback,
+        [OnComplete = MoveTemp(OnComplete), Delivery, Encoding, FilePath, StartTime](FUnrealMCPViewportPixels&& Readback) mutable
+    {
+        if (!Readback.bSuccess)
         {
-            TArray<uint8> CompressedBitmap;
-            FImageUtils::CompressImageArray(Viewport->GetSizeXY().X, Viewport->GetSizeXY().Y, Bitmap, CompressedBitmap);
-            
-            if (FFileHelper::SaveArrayToFile(CompressedBitmap, *FilePath))
+            OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(Readback.Error), {});
+            return;
+        }
+
+        // Encoding and file I/O run on the pool
+        const double ReadbackTime = FPlatformTime::Seconds();
+        Async(EAsyncExecution::ThreadPool, [OnComplete = MoveTemp(OnComplete), Readback = MoveTemp(Readback), Delivery, Encoding, FilePath,
+                                            StartTime, ReadbackTime]() mutable
+        {
+            TArray64<uint8> Encoded;
+            FString ErrorMessage;
+            const bool bEncoded = FUnrealMCPImageEncoder::Encode(Encoding, Readback.Width, Readback.Height, Readback.Pixels, Encoded, ErrorMessage);
+            const double EncodedTime = FPlatformTime::Seconds();
+
+            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+            TArray<FUnrealMCPAttachment> Attachments;
+            if (bEncoded && FUnrealMCPImageDelivery::Deliver(Delivery, FilePath, FUnrealMCPImageEncoder::GetContentType(Encoding.Format),
+                                                             MoveTemp(Encoded), ResultObj, Attachments, ErrorMessage))
             {
-                TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-                ResultObj->SetStringField(TEXT("filepath"), FilePath);
-                return ResultObj;
+                const double DeliveredTime = FPlatformTime::Seconds();
+                TSharedPtr<FJsonObject> TimingsObj = MakeShared<FJsonObject>();
+                TimingsObj->SetNumberField(TEXT("readback_ms"), (ReadbackTime - StartTime) * 1000.0);
+                TimingsObj->SetNumberField(TEXT("readback_frames"), (double)Readback.Frames);
+                TimingsObj->SetNumberField(TEXT("encode_ms"), (EncodedTime - ReadbackTime) * 1000.0);
+                TimingsObj->SetNumberField(TEXT("deliver_ms"), (DeliveredTime - EncodedTime) * 1000.0);
+
+                if (Delivery == EUnrealMCPImageDelivery::File)
+                {
+                    ResultObj->SetStringField(TEXT("filepath"), FilePath);
+                }
+                ResultObj->SetNumberField(TEXT("width"), Readback.Width);
+                ResultObj->SetNumberField(TEXT("height"), Readback.Height);
+                ResultObj->SetStringField(TEXT("format"), FUnrealMCPImageEncoder::GetExtension(Encoding.Format));
+                ResultObj->SetStringField(TEXT("readback"), Readback.bAsync ? TEXT("async") : TEXT("sync"));
+                ResultObj->SetObjectField(TEXT("timings"), TimingsObj);
             }
-        }
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot"));
+            else
+            {
+                ResultObj = FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage);
+                Attachments.Reset();
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete), ResultObj, Attachments = MoveTemp(Attachments)]() mutable
+            {
+                OnComplete(ResultObj, MoveTemp(Attachments));
+            });
+        });
+    });
 } 
\ No newline at end of file
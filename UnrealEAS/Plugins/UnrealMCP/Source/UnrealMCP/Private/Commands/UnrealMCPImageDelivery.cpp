@@ -0,0 +1,152 @@
+#include "Commands/UnrealMCPImageDelivery.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    struct FSharedImageRegion
+    {
+        FString Name;
+        FPlatformMemory::FSharedMemoryRegion* Region;
+    };
+
+    FCriticalSection SharedRegionsLock;
+    TArray<FSharedImageRegion> SharedRegions;  // oldest first
+    FThreadSafeCounter SharedRegionCounter;
+
+    void UnmapRegion(FSharedImageRegion& Entry)
+    {
+        if (Entry.Region)
+        {
+            FPlatformMemory::UnmapNamedSharedMemoryRegion(Entry.Region);
+            Entry.Region = nullptr;
+        }
+    }
+}
+
+bool FUnrealMCPImageDelivery::ParseDelivery(const TSharedPtr<FJsonObject>& Params, EUnrealMCPImageDelivery& OutDelivery, FString& OutError)
+{
+    OutDelivery = EUnrealMCPImageDelivery::File;
+
+    FString DeliveryName;
+    if (!Params.IsValid() || !Params->TryGetStringField(TEXT("delivery"), DeliveryName) || DeliveryName == TEXT("file"))
+    {
+        return true;
+    }
+    else if (DeliveryName == TEXT("inline"))
+    {
+        OutDelivery = EUnrealMCPImageDelivery::Inline;
+        return true;
+    }
+    else if (DeliveryName == TEXT("shared_memory"))
+    {
+        OutDelivery = EUnrealMCPImageDelivery::SharedMemory;
+        return true;
+    }
+
+    OutError = FString::Printf(TEXT("Unknown delivery '%s' (expected 'file', 'inline' or 'shared_memory')"), *DeliveryName);
+    return false;
+}
+
+bool FUnrealMCPImageDelivery::Deliver(EUnrealMCPImageDelivery Delivery, const FString& Path, const FString& ContentType, TArray64<uint8>&& Encoded,
+                                      const TSharedPtr<FJsonObject>& Result, TArray<FUnrealMCPAttachment>& OutAttachments, FString& OutError)
+{
+    const int64 Size = Encoded.Num();
+    if (Size == 0)
+    {
+        OutError = TEXT("Image encoding produced no data");
+        return false;
+    }
+
+    Result->SetStringField(TEXT("delivery"), Delivery == EUnrealMCPImageDelivery::Inline ? TEXT("inline") :
+                                             Delivery == EUnrealMCPImageDelivery::SharedMemory ? TEXT("shared_memory") : TEXT("file"));
+    Result->SetStringField(TEXT("content_type"), ContentType);
+    Result->SetNumberField(TEXT("size_bytes"), (double)Size);
+
+    if (Delivery == EUnrealMCPImageDelivery::Inline)
+    {
+        FUnrealMCPAttachment& Attachment = OutAttachments.AddDefaulted_GetRef();
+        Attachment.Name = TEXT("image");
+        Attachment.ContentType = ContentType;
+        Attachment.Data = MakeShared<TArray64<uint8>, ESPMode::ThreadSafe>(MoveTemp(Encoded));
+
+        Result->SetStringField(TEXT("attachment"), Attachment.Name);
+        return true;
+    }
+
+    if (Delivery == EUnrealMCPImageDelivery::SharedMemory)
+    {
+        const FString Name = FString::Printf(TEXT("UnrealMCP_%u_%d"), FPlatformProcess::GetCurrentProcessId(), SharedRegionCounter.Increment());
+        FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(
+            Name, true, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, (SIZE_T)Size);
+        if (!Region)
+        {
+            OutError = FString::Printf(TEXT("Failed to create shared memory region '%s' (%lld bytes)"), *Name, Size);
+            return false;
+        }
+        FMemory::Memcpy(Region->GetAddress(), Encoded.GetData(), Size);
+
+        FScopeLock Lock(&SharedRegionsLock);
+        SharedRegions.Add({ Name, Region });
+        while (SharedRegions.Num() > MaxSharedMemoryRegions)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("UnrealMCP: Releasing unclaimed shared memory region %s"), *SharedRegions[0].Name);
+            UnmapRegion(SharedRegions[0]);
+            SharedRegions.RemoveAt(0);
+        }
+
+        Result->SetStringField(TEXT("shared_memory_name"), Name);
+        return true;
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Encoded, *Path))
+    {
+        OutError = FString::Printf(TEXT("Failed to write image to %s"), *Path);
+        return false;
+    }
+    Result->SetStringField(TEXT("path"), Path);
+    Result->SetStringField(TEXT("filename"), FPaths::GetCleanFilename(Path));
+    return true;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPImageDelivery::HandleReleaseSharedMemory(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Name;
+    if (!Params->TryGetStringField(TEXT("name"), Name))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("name"), Name);
+    ResultObj->SetBoolField(TEXT("released"), ReleaseSharedMemory(Name));
+    return ResultObj;
+}
+
+bool FUnrealMCPImageDelivery::ReleaseSharedMemory(const FString& Name)
+{
+    FScopeLock Lock(&SharedRegionsLock);
+    const int32 Index = SharedRegions.IndexOfByPredicate([&Name](const FSharedImageRegion& Entry) { return Entry.Name == Name; });
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+    UnmapRegion(SharedRegions[Index]);
+    SharedRegions.RemoveAt(Index);
+    return true;
+}
+
+void FUnrealMCPImageDelivery::ReleaseAllSharedMemory()
+{
+    FScopeLock Lock(&SharedRegionsLock);
+    for (FSharedImageRegion& Entry : SharedRegions)
+    {
+        UnmapRegion(Entry);
+    }
+    SharedRegions.Empty();
+}
@@ -0,0 +1,175 @@
+#include "Commands/UnrealMCPImageEncoder.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+    const FName ImageWrapperModuleName(TEXT("ImageWrapper"));
+
+    constexpr int32 DefaultJpegQuality = 85;
+    constexpr int32 DefaultWebPQuality = 90;
+}
+
+bool FUnrealMCPImageEncoder::ParseSettings(const TSharedPtr<FJsonObject>& Params, FUnrealMCPImageEncodeSettings& OutSettings, FString& OutError)
+{
+    OutSettings = FUnrealMCPImageEncodeSettings();
+    if (!Params.IsValid())
+    {
+        return true;
+    }
+
+    FString FormatName;
+    if (Params->TryGetStringField(TEXT("format"), FormatName))
+    {
+        FormatName = FormatName.ToLower();
+        if (FormatName == TEXT("png"))
+        {
+            OutSettings.Format = EUnrealMCPImageFormat::Png;
+        }
+        else if (FormatName == TEXT("jpeg") || FormatName == TEXT("jpg"))
+        {
+            OutSettings.Format = EUnrealMCPImageFormat::Jpeg;
+        }
+        else if (FormatName == TEXT("webp"))
+        {
+            OutSettings.Format = EUnrealMCPImageFormat::WebP;
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Unknown format '%s' (expected 'png', 'jpeg' or 'webp')"), *FormatName);
+            return false;
+        }
+    }
+
+    Params->TryGetBoolField(TEXT("lossless"), OutSettings.bLossless);
+
+    int32 Quality = -1;
+    if (Params->TryGetNumberField(TEXT("quality"), Quality))
+    {
+        const int32 MinQuality = OutSettings.Format == EUnrealMCPImageFormat::Png ? 0 : 1;
+        const int32 MaxQuality = OutSettings.Format == EUnrealMCPImageFormat::Png ? 9 : 100;
+        if (Quality < MinQuality || Quality > MaxQuality)
+        {
+            OutError = FString::Printf(TEXT("quality for %s must be between %d and %d"), GetExtension(OutSettings.Format), MinQuality, MaxQuality);
+            return false;
+        }
+        OutSettings.Quality = Quality;
+
+        // An explicit quality on WebP asks for lossy output unless lossless was requested too
+        if (OutSettings.Format == EUnrealMCPImageFormat::WebP && !Params->HasField(TEXT("lossless")))
+        {
+            OutSettings.bLossless = false;
+        }
+    }
+
+    return true;
+}
+
+const TCHAR* FUnrealMCPImageEncoder::GetExtension(EUnrealMCPImageFormat Format)
+{
+    switch (Format)
+    {
+    case EUnrealMCPImageFormat::Jpeg:
+        return TEXT("jpg");
+    case EUnrealMCPImageFormat::WebP:
+        return TEXT("webp");
+    default:
+        return TEXT("png");
+    }
+}
+
+const TCHAR* FUnrealMCPImageEncoder::GetContentType(EUnrealMCPImageFormat Format)
+{
+    switch (Format)
+    {
+    case EUnrealMCPImageFormat::Jpeg:
+        return TEXT("image/jpeg");
+    case EUnrealMCPImageFormat::WebP:
+        return TEXT("image/webp");
+    default:
+        return TEXT("image/png");
+    }
+}
+
+void FUnrealMCPImageEncoder::Load()
+{
+    check(IsInGameThread());
+    FModuleManager::LoadModuleChecked<IImageWrapperModule>(ImageWrapperModuleName);
+}
+
+bool FUnrealMCPImageEncoder::Encode(const FUnrealMCPImageEncodeSettings& Settings, int32 Width, int32 Height, TArray<FColor>& Pixels,
+                                    TArray64<uint8>& OutEncoded, FString& OutError)
+{
+    if (Width <= 0 || Height <= 0 || Pixels.Num() != Width * Height)
+    {
+        OutError = FString::Printf(TEXT("Invalid image data (%dx%d, %d pixels)"), Width, Height, Pixels.Num());
+        return false;
+    }
+
+    IImageWrapperModule* ImageWrapperModule = FModuleManager::GetModulePtr<IImageWrapperModule>(ImageWrapperModuleName);
+    if (!ImageWrapperModule)
+    {
+        OutError = TEXT("ImageWrapper module is not loaded");
+        return false;
+    }
+
+    // WebP support depends on the engine build, so look it up instead of assuming it
+    EImageFormat WrapperFormat = EImageFormat::PNG;
+    int32 WrapperQuality = (int32)EImageCompressionQuality::Default;
+    switch (Settings.Format)
+    {
+    case EUnrealMCPImageFormat::Jpeg:
+        WrapperFormat = EImageFormat::JPEG;
+        WrapperQuality = Settings.Quality > 0 ? Settings.Quality : DefaultJpegQuality;
+        break;
+    case EUnrealMCPImageFormat::WebP:
+        WrapperFormat = ImageWrapperModule->GetImageFormatFromExtension(TEXT("webp"));
+        WrapperQuality = Settings.bLossless ? (int32)EImageCompressionQuality::Uncompressed
+                                            : (Settings.Quality > 0 ? Settings.Quality : DefaultWebPQuality);
+        break;
+    default:
+        // The wrapper reserves 1 for "uncompressed", so zlib level 1 is rounded up to 2
+        if (Settings.Quality == 0)
+        {
+            WrapperQuality = (int32)EImageCompressionQuality::Uncompressed;
+        }
+        else if (Settings.Quality > 0)
+        {
+            WrapperQuality = FMath::Max(Settings.Quality, 2);
+        }
+        break;
+    }
+
+    if (WrapperFormat == EImageFormat::Invalid)
+    {
+        OutError = FString::Printf(TEXT("%s encoding is not available in this engine build"), GetExtension(Settings.Format));
+        return false;
+    }
+
+    TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule->CreateImageWrapper(WrapperFormat);
+    if (!ImageWrapper.IsValid())
+    {
+        OutError = FString::Printf(TEXT("No image wrapper for %s"), GetExtension(Settings.Format));
+        return false;
+    }
+
+    for (FColor& Pixel : Pixels)
+    {
+        Pixel.A = 255;
+    }
+
+    if (!ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), Width, Height, ERGBFormat::BGRA, 8))
+    {
+        OutError = TEXT("Image wrapper rejected the pixel data");
+        return false;
+    }
+
+    OutEncoded = ImageWrapper->GetCompressed(WrapperQuality);
+    if (OutEncoded.Num() == 0)
+    {
+        OutError = FString::Printf(TEXT("%s encoding failed"), GetExtension(Settings.Format));
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,265 @@
+#include "Commands/UnrealMCPJsonWriter.h"
+
+namespace
+{
+    void AppendUtf8(TArray<uint8>& Buffer, uint32 CodePoint)
+    {
+        if (CodePoint < 0x80)
+        {
+            Buffer.Add((uint8)CodePoint);
+        }
+        else if (CodePoint < 0x800)
+        {
+            const uint8 Bytes[2] = { (uint8)(0xC0 | (CodePoint >> 6)), (uint8)(0x80 | (CodePoint & 0x3F)) };
+            Buffer.Append(Bytes, 2);
+        }
+        else if (CodePoint < 0x10000)
+        {
+            const uint8 Bytes[3] = { (uint8)(0xE0 | (CodePoint >> 12)), (uint8)(0x80 | ((CodePoint >> 6) & 0x3F)), (uint8)(0x80 | (CodePoint & 0x3F)) };
+            Buffer.Append(Bytes, 3);
+        }
+        else
+        {
+            const uint8 Bytes[4] = { (uint8)(0xF0 | (CodePoint >> 18)), (uint8)(0x80 | ((CodePoint >> 12) & 0x3F)),
+                                     (uint8)(0x80 | ((CodePoint >> 6) & 0x3F)), (uint8)(0x80 | (CodePoint & 0x3F)) };
+            Buffer.Append(Bytes, 4);
+        }
+    }
+}
+
+FUnrealMCPJsonWriter::FUnrealMCPJsonWriter(TArray<uint8>& InBuffer)
+    : Buffer(InBuffer)
+{
+}
+
+void FUnrealMCPJsonWriter::BeginObject()
+{
+    BeforeValue();
+    Buffer.Add('{');
+    bNeedComma = false;
+}
+
+void FUnrealMCPJsonWriter::EndObject()
+{
+    Buffer.Add('}');
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::BeginArray()
+{
+    BeforeValue();
+    Buffer.Add('[');
+    bNeedComma = false;
+}
+
+void FUnrealMCPJsonWriter::EndArray()
+{
+    Buffer.Add(']');
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::WriteKey(FStringView Key)
+{
+    BeforeValue();
+    AppendEscaped(Key);
+    Buffer.Add(':');
+    // The value that follows belongs to this key
+    bNeedComma = false;
+}
+
+void FUnrealMCPJsonWriter::WriteValue(FStringView Value)
+{
+    BeforeValue();
+    AppendEscaped(Value);
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::WriteValue(double Value)
+{
+    if (!FMath::IsFinite(Value))
+    {
+        // JSON has no representation for these
+        WriteNull();
+        return;
+    }
+
+    BeforeValue();
+    // Same format TJsonPrintPolicy uses, so both writers agree on every number
+    ANSICHAR Text[32];
+    const int32 Length = FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%.17g", Value);
+    Append(Text, Length);
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::WriteValue(int64 Value)
+{
+    BeforeValue();
+    ANSICHAR Text[24];
+    const int32 Length = FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%lld", (long long)Value);
+    Append(Text, Length);
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::WriteValue(bool bValue)
+{
+    BeforeValue();
+    if (bValue)
+    {
+        Append("true", 4);
+    }
+    else
+    {
+        Append("false", 5);
+    }
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::WriteNull()
+{
+    BeforeValue();
+    Append("null", 4);
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::WriteVector(double X, double Y, double Z)
+{
+    BeginArray();
+    WriteValue(X);
+    WriteValue(Y);
+    WriteValue(Z);
+    EndArray();
+}
+
+void FUnrealMCPJsonWriter::WriteRaw(TConstArrayView<uint8> Json)
+{
+    BeforeValue();
+    Buffer.Append(Json.GetData(), Json.Num());
+    bNeedComma = true;
+}
+
+void FUnrealMCPJsonWriter::WriteJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+    if (!Value.IsValid())
+    {
+        WriteNull();
+        return;
+    }
+
+    if (const FUnrealMCPJsonValueRaw* Raw = FUnrealMCPJsonValueRaw::Cast(Value))
+    {
+        WriteRaw(Raw->GetJson());
+        return;
+    }
+
+    switch (Value->Type)
+    {
+    case EJson::String:
+        WriteValue(Value->AsString());
+        break;
+    case EJson::Number:
+        WriteValue(Value->AsNumber());
+        break;
+    case EJson::Boolean:
+        WriteValue(Value->AsBool());
+        break;
+    case EJson::Array:
+        BeginArray();
+        for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+        {
+            WriteJsonValue(Element);
+        }
+        EndArray();
+        break;
+    case EJson::Object:
+        WriteJsonObject(Value->AsObject());
+        break;
+    default:
+        WriteNull();
+        break;
+    }
+}
+
+void FUnrealMCPJsonWriter::WriteJsonObject(const TSharedPtr<FJsonObject>& Object)
+{
+    if (!Object.IsValid())
+    {
+        WriteNull();
+        return;
+    }
+
+    BeginObject();
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+    {
+        WriteKey(Field.Key);
+        WriteJsonValue(Field.Value);
+    }
+    EndObject();
+}
+
+void FUnrealMCPJsonWriter::BeforeValue()
+{
+    if (bNeedComma)
+    {
+        Buffer.Add(',');
+    }
+}
+
+void FUnrealMCPJsonWriter::Append(const ANSICHAR* Text, int32 Length)
+{
+    Buffer.Append((const uint8*)Text, Length);
+}
+
+void FUnrealMCPJsonWriter::AppendEscaped(FStringView Text)
+{
+    Buffer.Add('"');
+
+    const TCHAR* Chars = Text.GetData();
+    const int32 Num = Text.Len();
+    for (int32 Index = 0; Index < Num; ++Index)
+    {
+        uint32 CodePoint = (uint32)Chars[Index];
+        switch (CodePoint)
+        {
+        case '"':  Append("\\\"", 2); continue;
+        case '\\': Append("\\\\", 2); continue;
+        case '\n': Append("\\n", 2); continue;
+        case '\r': Append("\\r", 2); continue;
+        case '\t': Append("\\t", 2); continue;
+        case '\b': Append("\\b", 2); continue;
+        case '\f': Append("\\f", 2); continue;
+        default: break;
+        }
+
+        if (CodePoint < 0x20)
+        {
+            ANSICHAR Escape[8];
+            Append(Escape, FCStringAnsi::Snprintf(Escape, UE_ARRAY_COUNT(Escape), "\\u%04x", CodePoint));
+            continue;
+        }
+
+        // TCHAR is UTF-16 on some platforms; join surrogate pairs before encoding
+        if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Index + 1 < Num)
+        {
+            const uint32 Low = (uint32)Chars[Index + 1];
+            if (Low >= 0xDC00 && Low <= 0xDFFF)
+            {
+                CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+                ++Index;
+            }
+        }
+        AppendUtf8(Buffer, CodePoint);
+    }
+
+    Buffer.Add('"');
+}
+
+FUnrealMCPJsonValueRaw::FUnrealMCPJsonValueRaw(TArray<uint8>&& InJson)
+    : Json(MoveTemp(InJson))
+{
+    Type = EJson::None;
+}
+
+const FUnrealMCPJsonValueRaw* FUnrealMCPJsonValueRaw::Cast(const TSharedPtr<FJsonValue>& Value)
+{
+    return (Value.IsValid() && Value->Type == EJson::None) ? static_cast<const FUnrealMCPJsonValueRaw*>(Value.Get()) : nullptr;
+}
@@ -0,0 +1,250 @@
+#include "Commands/UnrealMCPPropertyAnimator.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPConstructionScripts.h"
+#include "Commands/UnrealMCPPropertyBindings.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+    // Cubic curves, the same shape as the editor's default ease
+    constexpr float EaseExponent = 3.0f;
+
+    const TCHAR* const EasingNames[] = { TEXT("linear"), TEXT("ease_in"), TEXT("ease_out"), TEXT("ease_in_out") };
+}
+
+FUnrealMCPPropertyAnimator& FUnrealMCPPropertyAnimator::Get()
+{
+    static FUnrealMCPPropertyAnimator Instance;
+    return Instance;
+}
+
+bool FUnrealMCPPropertyAnimator::ParseEasing(const FString& Name, EUnrealMCPEasing& OutEasing)
+{
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(EasingNames); ++Index)
+    {
+        if (Name.Equals(EasingNames[Index], ESearchCase::IgnoreCase))
+        {
+            OutEasing = (EUnrealMCPEasing)Index;
+            return true;
+        }
+    }
+    return false;
+}
+
+const TCHAR* FUnrealMCPPropertyAnimator::EasingToString(EUnrealMCPEasing Easing)
+{
+    return EasingNames[(int32)Easing];
+}
+
+double FUnrealMCPPropertyAnimator::Ease(EUnrealMCPEasing Easing, double Alpha)
+{
+    Alpha = FMath::Clamp(Alpha, 0.0, 1.0);
+    switch (Easing)
+    {
+    case EUnrealMCPEasing::EaseIn:
+        return FMath::InterpEaseIn(0.0, 1.0, Alpha, EaseExponent);
+    case EUnrealMCPEasing::EaseOut:
+        return FMath::InterpEaseOut(0.0, 1.0, Alpha, EaseExponent);
+    case EUnrealMCPEasing::EaseInOut:
+        return FMath::InterpEaseInOut(0.0, 1.0, Alpha, EaseExponent);
+    default:
+        return Alpha;
+    }
+}
+
+int32 FUnrealMCPPropertyAnimator::Start(FUnrealMCPPropertyAnimation&& Animation, FUnrealMCPCommandProgress&& OnProgress, FUnrealMCPCommandCompletion&& OnComplete, FString& OutError)
+{
+    check(IsInGameThread());
+
+    AActor* Actor = Animation.Actor.Get();
+    if (!IsValid(Actor))
+    {
+        OutError = TEXT("Actor not found");
+        return INDEX_NONE;
+    }
+    if (Animation.Duration < 0.0)
+    {
+        OutError = TEXT("duration must not be negative");
+        return INDEX_NONE;
+    }
+
+    // Also checks that the property exists and is a number
+    double Current = 0.0;
+    if (!FUnrealMCPPropertyBindings::Get().GetDouble(Actor, Animation.Property, Current, OutError))
+    {
+        return INDEX_NONE;
+    }
+
+    // The new animation picks up from wherever the old one had got to
+    TArray<FRunning> Replaced;
+    for (int32 Index = Animations.Num() - 1; Index >= 0; --Index)
+    {
+        const FRunning& Running = Animations[Index];
+        if (Running.Animation.Actor == Animation.Actor && Running.Animation.Property == Animation.Property)
+        {
+            FRunning& Old = Replaced.Add_GetRef(MoveTemp(Animations[Index]));
+            Old.State = TEXT("replaced");
+            Animations.RemoveAt(Index);
+        }
+    }
+
+    FRunning& Running = Animations.AddDefaulted_GetRef();
+    Running.Id = NextId++;
+    Running.ActorName = Actor->GetName();
+    Running.From = Animation.From.Get(Current);
+    Running.Value = Current;
+    Running.StartTime = FPlatformTime::Seconds();
+    Running.LastProgressTime = Running.StartTime;
+    Running.Animation = MoveTemp(Animation);
+    Running.OnProgress = MoveTemp(OnProgress);
+    Running.OnComplete = MoveTemp(OnComplete);
+    const int32 Id = Running.Id;
+
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUnrealMCPPropertyAnimator::Tick));
+    }
+
+    Complete(Replaced);
+    return Id;
+}
+
+int32 FUnrealMCPPropertyAnimator::Stop(int32 Id)
+{
+    check(IsInGameThread());
+
+    TArray<FRunning> Stopped;
+    for (int32 Index = Animations.Num() - 1; Index >= 0; --Index)
+    {
+        if (Id == INDEX_NONE || Animations[Index].Id == Id)
+        {
+            FRunning& Running = Stopped.Add_GetRef(MoveTemp(Animations[Index]));
+            Running.State = TEXT("stopped");
+            Animations.RemoveAt(Index);
+        }
+    }
+
+    Complete(Stopped);
+    return Stopped.Num();
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPPropertyAnimator::Describe(int32 Id) const
+{
+    const FRunning* Running = Animations.FindByPredicate([Id](const FRunning& Candidate) { return Candidate.Id == Id; });
+    return Running ? MakeState(*Running) : nullptr;
+}
+
+void FUnrealMCPPropertyAnimator::Shutdown()
+{
+    Stop(INDEX_NONE);
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+bool FUnrealMCPPropertyAnimator::Tick(float DeltaTime)
+{
+    FUnrealMCPPropertyBindings& Bindings = FUnrealMCPPropertyBindings::Get();
+    FUnrealMCPConstructionScripts& ConstructionScripts = FUnrealMCPConstructionScripts::Get();
+    const double Now = FPlatformTime::Seconds();
+
+    TArray<FRunning> Finished;
+    for (int32 Index = 0; Index < Animations.Num();)
+    {
+        FRunning& Running = Animations[Index];
+        const FUnrealMCPPropertyAnimation& Animation = Running.Animation;
+
+        AActor* Actor = Animation.Actor.Get();
+        if (!IsValid(Actor))
+        {
+            Running.Error = FString::Printf(TEXT("Actor %s was deleted while animating '%s'"), *Running.ActorName, *Animation.Property.ToString());
+        }
+        else
+        {
+            Running.Alpha = Animation.Duration > 0.0 ? FMath::Clamp((Now - Running.StartTime) / Animation.Duration, 0.0, 1.0) : 1.0;
+            Running.Value = FMath::Lerp(Running.From, Animation.To, Ease(Animation.Easing, Running.Alpha));
+            if (Bindings.SetDouble(Actor, Animation.Property, Running.Value, Running.Error))
+            {
+                ++Running.Frames;
+                ConstructionScripts.Request(Actor);
+                if (Running.Alpha >= 1.0)
+                {
+                    Running.State = TEXT("completed");
+                }
+                else if (Running.OnProgress && Now - Running.LastProgressTime >= Animation.ProgressInterval)
+                {
+                    Running.LastProgressTime = Now;
+                    if (!Running.OnProgress(MakeState(Running), {}))
+                    {
+                        // The client is gone; the animation runs on and still completes
+                        Running.OnProgress = nullptr;
+                    }
+                }
+            }
+        }
+
+        if (!Running.Error.IsEmpty())
+        {
+            Running.State = TEXT("failed");
+        }
+        if (Running.Alpha >= 1.0 || !Running.Error.IsEmpty())
+        {
+            Finished.Add(MoveTemp(Running));
+            Animations.RemoveAt(Index);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    // One rebuild per actor covers every property animated on it this frame
+    ConstructionScripts.Flush();
+    Complete(Finished);
+
+    if (Animations.Num() == 0)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPPropertyAnimator::MakeState(const FRunning& Running) const
+{
+    TSharedPtr<FJsonObject> StateJson = MakeShared<FJsonObject>();
+    StateJson->SetNumberField(TEXT("animation_id"), Running.Id);
+    StateJson->SetStringField(TEXT("actor_name"), Running.ActorName);
+    StateJson->SetStringField(TEXT("property"), Running.Animation.Property.ToString());
+    StateJson->SetStringField(TEXT("state"), Running.State);
+    StateJson->SetNumberField(TEXT("value"), Running.Value);
+    StateJson->SetNumberField(TEXT("from"), Running.From);
+    StateJson->SetNumberField(TEXT("to"), Running.Animation.To);
+    StateJson->SetNumberField(TEXT("progress"), Running.Alpha);
+    StateJson->SetNumberField(TEXT("duration"), Running.Animation.Duration);
+    StateJson->SetStringField(TEXT("easing"), EasingToString(Running.Animation.Easing));
+    StateJson->SetNumberField(TEXT("frames"), Running.Frames);
+    StateJson->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - Running.StartTime) * 1000.0);
+    return StateJson;
+}
+
+void FUnrealMCPPropertyAnimator::Complete(TArray<FRunning>& Finished) const
+{
+    for (FRunning& Running : Finished)
+    {
+        if (!Running.OnComplete)
+        {
+            continue;
+        }
+        if (Running.Error.IsEmpty())
+        {
+            Running.OnComplete(MakeState(Running), {});
+        }
+        else
+        {
+            Running.OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(Running.Error), {});
+        }
+    }
+}
@@ -0,0 +1,365 @@
+#include "Commands/UnrealMCPPropertyBindings.h"
+#include "Commands/UnrealMCPActorIndex.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UnrealType.h"
+
+FUnrealMCPPropertyBindings& FUnrealMCPPropertyBindings::Get()
+{
+    static FUnrealMCPPropertyBindings Instance;
+    return Instance;
+}
+
+FProperty* FUnrealMCPPropertyBindings::FindProperty(UClass* Class, FName Name)
+{
+    check(IsInGameThread());
+    BindDelegates();
+
+    if (!Class)
+    {
+        return nullptr;
+    }
+
+    const TPair<TObjectKey<UClass>, FName> Key(Class, Name);
+    if (FProperty** Found = Properties.Find(Key))
+    {
+        return *Found;
+    }
+
+    // Misses aren't cached: names come from clients, so they would grow the map without bound
+    FProperty* Property = Class->FindPropertyByName(Name);
+    if (Property)
+    {
+        Properties.Add(Key, Property);
+    }
+    return Property;
+}
+
+AActor* FUnrealMCPPropertyBindings::FindActorOfClass(UWorld* World, FName ClassName)
+{
+    check(IsInGameThread());
+    BindDelegates();
+
+    if (!IsValid(World))
+    {
+        return nullptr;
+    }
+
+    const TPair<TObjectKey<UWorld>, FName> Key(World, ClassName);
+    AActor* Actor = Actors.FindRef(Key).Get();
+    if (IsValid(Actor) && Actor->GetClass()->GetFName() == ClassName)
+    {
+        return Actor;
+    }
+
+    Actor = nullptr;
+    if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
+    {
+        Actor = Index->FindFirstActorOfClass(World, ClassName);
+    }
+    else
+    {
+        for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+        {
+            if (IsValid(*ActorItr) && ActorItr->GetClass()->GetFName() == ClassName)
+            {
+                Actor = *ActorItr;
+                break;
+            }
+        }
+    }
+
+    // Only hits are cached: the actor may be placed later
+    if (Actor)
+    {
+        Actors.Add(Key, Actor);
+    }
+    return Actor;
+}
+
+bool FUnrealMCPPropertyBindings::GetDouble(AActor* Actor, FName PropertyName, double& OutValue, FString& OutError)
+{
+    FProperty* Property = FindPropertyChecked(Actor, PropertyName, OutError);
+    if (!Property)
+    {
+        return false;
+    }
+
+    const FNumericProperty* Numeric = CastField<FNumericProperty>(Property);
+    if (!Numeric || Numeric->IsEnum())
+    {
+        OutError = FString::Printf(TEXT("Property '%s' is not a number"), *PropertyName.ToString());
+        return false;
+    }
+
+    const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Actor);
+    OutValue = Numeric->IsFloatingPoint() ? Numeric->GetFloatingPointPropertyValue(ValuePtr) : (double)Numeric->GetSignedIntPropertyValue(ValuePtr);
+    return true;
+}
+
+bool FUnrealMCPPropertyBindings::SetDouble(AActor* Actor, FName PropertyName, double Value, FString& OutError)
+{
+    FProperty* Property = FindPropertyChecked(Actor, PropertyName, OutError);
+    if (!Property)
+    {
+        return false;
+    }
+
+    FNumericProperty* Numeric = CastField<FNumericProperty>(Property);
+    if (!Numeric || Numeric->IsEnum())
+    {
+        OutError = FString::Printf(TEXT("Property '%s' is not a number"), *PropertyName.ToString());
+        return false;
+    }
+
+    void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Actor);
+    if (Numeric->IsFloatingPoint())
+    {
+        Numeric->SetFloatingPointPropertyValue(ValuePtr, Value);
+    }
+    else
+    {
+        Numeric->SetIntPropertyValue(ValuePtr, (int64)FMath::RoundToDouble(Value));
+    }
+    MarkChanged(Actor);
+    return true;
+}
+
+TSharedPtr<FJsonValue> FUnrealMCPPropertyBindings::GetValue(AActor* Actor, FName PropertyName, FString& OutError)
+{
+    FProperty* Property = FindPropertyChecked(Actor, PropertyName, OutError);
+    if (!Property)
+    {
+        return nullptr;
+    }
+
+    const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Actor);
+    if (const FNumericProperty* Numeric = CastField<FNumericProperty>(Property))
+    {
+        if (const UEnum* Enum = Numeric->GetIntPropertyEnum())
+        {
+            return MakeShared<FJsonValueString>(Enum->GetNameStringByValue(Numeric->GetSignedIntPropertyValue(ValuePtr)));
+        }
+        if (Numeric->IsFloatingPoint())
+        {
+            return MakeShared<FJsonValueNumber>(Numeric->GetFloatingPointPropertyValue(ValuePtr));
+        }
+        return MakeShared<FJsonValueNumber>((double)Numeric->GetSignedIntPropertyValue(ValuePtr));
+    }
+    if (const FBoolProperty* Bool = CastField<FBoolProperty>(Property))
+    {
+        return MakeShared<FJsonValueBoolean>(Bool->GetPropertyValue(ValuePtr));
+    }
+    if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+    {
+        const int64 EnumValue = EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr);
+        return MakeShared<FJsonValueString>(EnumProperty->GetEnum()->GetNameStringByValue(EnumValue));
+    }
+    if (const FStrProperty* Str = CastField<FStrProperty>(Property))
+    {
+        return MakeShared<FJsonValueString>(Str->GetPropertyValue(ValuePtr));
+    }
+    if (const FNameProperty* Name = CastField<FNameProperty>(Property))
+    {
+        return MakeShared<FJsonValueString>(Name->GetPropertyValue(ValuePtr).ToString());
+    }
+    if (const FTextProperty* Text = CastField<FTextProperty>(Property))
+    {
+        return MakeShared<FJsonValueString>(Text->GetPropertyValue(ValuePtr).ToString());
+    }
+
+    FString Exported;
+    Property->ExportTextItem_Direct(Exported, ValuePtr, nullptr, Actor, PPF_None);
+    return MakeShared<FJsonValueString>(Exported);
+}
+
+bool FUnrealMCPPropertyBindings::SetValue(AActor* Actor, FName PropertyName, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+{
+    if (!WriteValue(Actor, PropertyName, Value, OutError))
+    {
+        return false;
+    }
+    MarkChanged(Actor);
+    return true;
+}
+
+bool FUnrealMCPPropertyBindings::WriteValue(AActor* Actor, FName PropertyName, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+{
+    FProperty* Property = FindPropertyChecked(Actor, PropertyName, OutError);
+    if (!Property)
+    {
+        return false;
+    }
+    if (!Value.IsValid() || Value->IsNull())
+    {
+        OutError = FString::Printf(TEXT("No value given for '%s'"), *PropertyName.ToString());
+        return false;
+    }
+
+    void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Actor);
+    auto ParseEnum = [&OutError, &PropertyName](const UEnum* Enum, const TSharedPtr<FJsonValue>& EnumValue, int64& OutEnumValue)
+    {
+        if (EnumValue->Type == EJson::Number)
+        {
+            OutEnumValue = (int64)EnumValue->AsNumber();
+            return true;
+        }
+        OutEnumValue = Enum->GetValueByNameString(EnumValue->AsString());
+        if (OutEnumValue == INDEX_NONE)
+        {
+            OutError = FString::Printf(TEXT("'%s' is not a value of %s for '%s'"), *EnumValue->AsString(), *Enum->GetName(), *PropertyName.ToString());
+            return false;
+        }
+        return true;
+    };
+
+    if (FNumericProperty* Numeric = CastField<FNumericProperty>(Property))
+    {
+        if (const UEnum* Enum = Numeric->GetIntPropertyEnum())
+        {
+            int64 EnumValue = 0;
+            if (!ParseEnum(Enum, Value, EnumValue))
+            {
+                return false;
+            }
+            Numeric->SetIntPropertyValue(ValuePtr, EnumValue);
+            return true;
+        }
+
+        double Number = 0.0;
+        if (!Value->TryGetNumber(Number))
+        {
+            OutError = FString::Printf(TEXT("Property '%s' needs a number"), *PropertyName.ToString());
+            return false;
+        }
+        return SetDouble(Actor, PropertyName, Number, OutError);
+    }
+    if (FBoolProperty* Bool = CastField<FBoolProperty>(Property))
+    {
+        bool bValue = false;
+        if (!Value->TryGetBool(bValue))
+        {
+            OutError = FString::Printf(TEXT("Property '%s' needs a bool"), *PropertyName.ToString());
+            return false;
+        }
+        Bool->SetPropertyValue(ValuePtr, bValue);
+        return true;
+    }
+    if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+    {
+        int64 EnumValue = 0;
+        if (!ParseEnum(EnumProperty->GetEnum(), Value, EnumValue))
+        {
+            return false;
+        }
+        EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(ValuePtr, EnumValue);
+        return true;
+    }
+
+    FString Text;
+    if (!Value->TryGetString(Text))
+    {
+        OutError = FString::Printf(TEXT("Property '%s' needs a string"), *PropertyName.ToString());
+        return false;
+    }
+    if (FStrProperty* Str = CastField<FStrProperty>(Property))
+    {
+        Str->SetPropertyValue(ValuePtr, Text);
+        return true;
+    }
+    if (FNameProperty* Name = CastField<FNameProperty>(Property))
+    {
+        Name->SetPropertyValue(ValuePtr, FName(*Text));
+        return true;
+    }
+    if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+    {
+        TextProperty->SetPropertyValue(ValuePtr, FText::FromString(Text));
+        return true;
+    }
+
+    if (!Property->ImportText_Direct(*Text, ValuePtr, Actor, PPF_None))
+    {
+        OutError = FString::Printf(TEXT("Could not parse '%s' for property '%s'"), *Text, *PropertyName.ToString());
+        return false;
+    }
+    return true;
+}
+
+void FUnrealMCPPropertyBindings::MarkChanged(AActor* Actor)
+{
+    // Writes through reflection raise no property change notification
+    if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
+    {
+        Index->MarkActorChanged(Actor);
+    }
+}
+
+void FUnrealMCPPropertyBindings::Invalidate()
+{
+    Properties.Reset();
+    Actors.Reset();
+}
+
+void FUnrealMCPPropertyBindings::Shutdown()
+{
+    if (bBound)
+    {
+        if (GEditor)
+        {
+            GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+        }
+        FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+        bBound = false;
+    }
+    Invalidate();
+}
+
+void FUnrealMCPPropertyBindings::BindDelegates()
+{
+    if (bBound)
+    {
+        return;
+    }
+    bBound = true;
+
+    if (GEditor)
+    {
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FUnrealMCPPropertyBindings::HandleBlueprintCompiled);
+    }
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FUnrealMCPPropertyBindings::HandleReloadComplete);
+}
+
+FProperty* FUnrealMCPPropertyBindings::FindPropertyChecked(AActor* Actor, FName PropertyName, FString& OutError)
+{
+    if (!IsValid(Actor))
+    {
+        OutError = TEXT("Actor not found");
+        return nullptr;
+    }
+
+    FProperty* Property = FindProperty(Actor->GetClass(), PropertyName);
+    if (!Property)
+    {
+        OutError = FString::Printf(TEXT("Property '%s' not found in %s"), *PropertyName.ToString(), *Actor->GetName());
+    }
+    return Property;
+}
+
+void FUnrealMCPPropertyBindings::HandleBlueprintCompiled()
+{
+    Invalidate();
+
+    // Recompiling reinstances placed actors without spawn or destroy notifications
+    if (UUnrealMCPActorIndex* Index = UUnrealMCPActorIndex::Get())
+    {
+        Index->Invalidate();
+    }
+}
+
+void FUnrealMCPPropertyBindings::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+    Invalidate();
+}
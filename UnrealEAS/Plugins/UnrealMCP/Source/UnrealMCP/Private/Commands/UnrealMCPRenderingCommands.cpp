@@ -1,105 +1,69 @@
 #include "Commands/UnrealMCPRenderingCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPScreenshotCapture.h"
+#include "Commands/UnrealMCPSequenceCapture.h"
 #include "Engine/Engine.h"
-#include "Engine/GameViewportClient.h"
-#include "Engine/World.h"
-#include "Misc/Paths.h"
-#include "HAL/PlatformFilemanager.h"
-#include "HAL/PlatformProcess.h"
-#include "Editor.h"
 
 FUnrealMCPRenderingCommands::FUnrealMCPRenderingCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPRenderingCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPRenderingCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-	if (CommandType == TEXT("take_highresshot"))
-	{
-		return HandleTakeHighResShot(Params);
-	}
-	return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown rendering command: %s"), *CommandType));
+	CommandRegistry = &Registry;
+	Registry.RegisterAsync(TEXT("take_highresshot"), this, &FUnrealMCPRenderingCommands::HandleTakeHighResShot, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::High);
+	Registry.RegisterStreaming(TEXT("capture_sequence"), this, &FUnrealMCPRenderingCommands::HandleCaptureSequence, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::High);
+	Registry.Register(TEXT("release_shared_memory"), &FUnrealMCPImageDelivery::HandleReleaseSharedMemory, EUnrealMCPCommandFlags::AnyThread);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPRenderingCommands::HandleTakeHighResShot(const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPRenderingCommands::HandleTakeHighResShot(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandCompletion OnComplete)
 {
 	// Get parameters with defaults
-	double ResolutionMultiplier = 1.0;
-	bool bIncludeUI = false;
+	FUnrealMCPScreenshotRequest Request;
 
 	if (Params.IsValid())
 	{
-		Params->TryGetNumberField(TEXT("resolution_multiplier"), ResolutionMultiplier);
-		Params->TryGetBoolField(TEXT("include_ui"), bIncludeUI);
+		Params->TryGetNumberField(TEXT("resolution_multiplier"), Request.ResolutionMultiplier);
+		Params->TryGetBoolField(TEXT("include_ui"), Request.bIncludeUI);
+		Params->TryGetStringField(TEXT("filename"), Request.Filename);
 	}
 
 	// Validate resolution multiplier
-	if (ResolutionMultiplier < 1.0 || ResolutionMultiplier > 8.0)
+	if (Request.ResolutionMultiplier < 1.0 || Request.ResolutionMultiplier > 8.0)
 	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Resolution multiplier must be between 1.0 and 8.0"));
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Resolution multiplier must be between 1.0 and 8.0")), {});
+		return;
 	}
 
-	// Use immediate response approach - return quickly without waiting for file detection
-	UE_LOG(LogTemp, Log, TEXT("Using immediate response approach for resolution multiplier: %.1f"), ResolutionMultiplier);
-	return HandleQuickScreenshot(Params);
-}
-
-TSharedPtr<FJsonObject> FUnrealMCPRenderingCommands::HandleQuickScreenshot(const TSharedPtr<FJsonObject>& Params)
-{
-	// Get parameters with defaults
-	double ResolutionMultiplier = 1.0;
-	bool bIncludeUI = false;
-
-	if (Params.IsValid())
+	FString ParamError;
+	if (!FUnrealMCPImageDelivery::ParseDelivery(Params, Request.Delivery, ParamError) ||
+		!FUnrealMCPImageEncoder::ParseSettings(Params, Request.Encoding, ParamError))
 	{
-		Params->TryGetNumberField(TEXT("resolution_multiplier"), ResolutionMultiplier);
-		Params->TryGetBoolField(TEXT("include_ui"), bIncludeUI);
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(ParamError), {});
+		return;
 	}
 
-	// Determine world context
-	UWorld* World = nullptr;
-	UGameViewportClient* GameViewportClient = GEngine->GameViewport;
-	
-	if (GameViewportClient)
-	{
-		World = GameViewportClient->GetWorld();
-	}
-	else
-	{
-		World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
-		if (!World)
-		{
-			return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No valid world context found"));
-		}
-	}
-
-	// Hide UI if requested
-	if (!bIncludeUI)
-	{
-		GEngine->Exec(World, TEXT("showflag.hud 0"));
-		GEngine->Exec(World, TEXT("showflag.screenmessages 0"));
-	}
-
-	// Execute HighResShot command
-	FString ScreenshotCommand = FString::Printf(TEXT("HighResShot %d"), FMath::RoundToInt(ResolutionMultiplier));
-	bool bCommandSuccess = GEngine->Exec(World, *ScreenshotCommand);
+	// Completes once the image is encoded and written, with its exact path
+	FUnrealMCPScreenshotCapture::Get().Capture(Request, MoveTemp(OnComplete));
+}
 
-	// Restore UI immediately if it was hidden
-	if (!bIncludeUI)
+void FUnrealMCPRenderingCommands::HandleCaptureSequence(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete)
+{
+	FUnrealMCPSequenceRequest Request;
+	FString ParamError;
+	if (!FUnrealMCPSequenceCapture::ParseRequest(Params, Request, ParamError))
 	{
-		GEngine->Exec(World, TEXT("showflag.hud 1"));
-		GEngine->Exec(World, TEXT("showflag.screenmessages 1"));
+		OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(ParamError), {});
+		return;
 	}
 
-	if (!bCommandSuccess)
+	// Time of day goes through the same handler as set_time_of_day, so Ultra Dynamic Sky updates identically
+	FUnrealMCPCommandHandler SetTimeOfDay;
+	const FUnrealMCPCommandInfo* TimeCommand = CommandRegistry ? CommandRegistry->Find(FName(TEXT("set_time_of_day"))) : nullptr;
+	if (TimeCommand)
 	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to execute HighResShot command"));
+		SetTimeOfDay = TimeCommand->Handler;
 	}
 
-	// Simple success response
-	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-	ResultObj->SetStringField(TEXT("success"), TEXT("true"));
-	ResultObj->SetStringField(TEXT("message"), TEXT("Screenshot command executed"));
-	
-	return ResultObj;
-}
\ No newline at end of file
+	FUnrealMCPSequenceCapture::Start(MoveTemp(Request), MoveTemp(SetTimeOfDay), MoveTemp(OnProgress), MoveTemp(OnComplete));
+}
@@ -0,0 +1,246 @@
+#include "Commands/UnrealMCPScreenshotCapture.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPConstructionScripts.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "UnrealClient.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Async/Async.h"
+#include "Editor.h"
+
+namespace
+{
+    UWorld* GetScreenshotWorld()
+    {
+        if (GEngine && GEngine->GameViewport)
+        {
+            return GEngine->GameViewport->GetWorld();
+        }
+        return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    }
+
+    double ToMilliseconds(double StartSeconds, double EndSeconds)
+    {
+        return (EndSeconds - StartSeconds) * 1000.0;
+    }
+}
+
+FUnrealMCPScreenshotCapture& FUnrealMCPScreenshotCapture::Get()
+{
+    static FUnrealMCPScreenshotCapture Instance;
+    return Instance;
+}
+
+void FUnrealMCPScreenshotCapture::Capture(const FUnrealMCPScreenshotRequest& Request, FUnrealMCPCommandCompletion OnComplete)
+{
+    check(IsInGameThread());
+
+    // The worker encodes through ImageWrapper, which must be loaded on the game thread
+    FUnrealMCPImageEncoder::Load();
+
+    TUniquePtr<FPendingCapture> Pending = MakeUnique<FPendingCapture>();
+    Pending->Request = Request;
+    Pending->OnComplete = MoveTemp(OnComplete);
+    Pending->QueuedTime = FPlatformTime::Seconds();
+
+    FString Filename = Request.Filename;
+    if (Filename.IsEmpty())
+    {
+        Filename = FString::Printf(TEXT("HighresScreenshot_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_%s")));
+    }
+    // Only file delivery touches the disk
+    Pending->Path = FPaths::ConvertRelativePathToFull(FPaths::ScreenShotDir() / FPaths::GetBaseFilename(Filename) + TEXT(".") + FUnrealMCPImageEncoder::GetExtension(Request.Encoding.Format));
+
+    Queue.Add(MoveTemp(Pending));
+    if (!Active.IsValid())
+    {
+        StartNext();
+    }
+}
+
+void FUnrealMCPScreenshotCapture::StartNext()
+{
+    while (!Active.IsValid() && Queue.Num() > 0)
+    {
+        Active = MoveTemp(Queue[0]);
+        Queue.RemoveAt(0);
+
+        UWorld* World = GetScreenshotWorld();
+        if (!World)
+        {
+            FailActive(TEXT("No valid world context found"));
+            continue;
+        }
+
+        Active->StartTime = FPlatformTime::Seconds();
+        BindDelegates();
+
+        // Property writes still waiting for their rebuild must show up in the shot
+        FUnrealMCPConstructionScripts::Get().Flush();
+
+        if (!Active->Request.bIncludeUI)
+        {
+            SetUIVisible(false);
+        }
+
+        // The frame is delivered to HandleScreenshotCaptured when the viewport next draws
+        const FString ScreenshotCommand = FString::Printf(TEXT("HighResShot %d"), FMath::RoundToInt(Active->Request.ResolutionMultiplier));
+        if (!GEngine->Exec(World, *ScreenshotCommand))
+        {
+            if (!Active->Request.bIncludeUI)
+            {
+                SetUIVisible(true);
+            }
+            FailActive(TEXT("Failed to execute HighResShot command"));
+            continue;
+        }
+
+        // Non-realtime editor viewports only draw when invalidated
+        if (GEditor)
+        {
+            GEditor->RedrawLevelEditingViewports(false);
+        }
+
+        if (!TimeoutTickerHandle.IsValid())
+        {
+            TimeoutTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUnrealMCPScreenshotCapture::TickTimeout), 0.25f);
+        }
+    }
+
+    if (!Active.IsValid())
+    {
+        UnbindDelegates();
+    }
+}
+
+void FUnrealMCPScreenshotCapture::HandleScreenshotCaptured(int32 Width, int32 Height, const TArray<FColor>& Bitmap)
+{
+    if (!Active.IsValid())
+    {
+        return;
+    }
+
+    TUniquePtr<FPendingCapture> Capture = MoveTemp(Active);
+    const double CapturedTime = FPlatformTime::Seconds();
+
+    if (!Capture->Request.bIncludeUI)
+    {
+        SetUIVisible(true);
+    }
+
+    // Encoding and disk I/O happen off the game thread; the next capture can start right away
+    Async(EAsyncExecution::ThreadPool, [Capture = MoveTemp(Capture), Width, Height, Pixels = Bitmap, CapturedTime]() mutable
+    {
+        const FUnrealMCPImageEncodeSettings& Encoding = Capture->Request.Encoding;
+        TArray64<uint8> Encoded;
+        FString ErrorMessage;
+        const bool bEncoded = FUnrealMCPImageEncoder::Encode(Encoding, Width, Height, Pixels, Encoded, ErrorMessage);
+        const double EncodedTime = FPlatformTime::Seconds();
+
+        TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+        TArray<FUnrealMCPAttachment> Attachments;
+        const bool bDelivered = bEncoded && FUnrealMCPImageDelivery::Deliver(Capture->Request.Delivery, Capture->Path,
+                                                                             FUnrealMCPImageEncoder::GetContentType(Encoding.Format),
+                                                                             MoveTemp(Encoded), ResultJson, Attachments, ErrorMessage);
+        const double DeliveredTime = FPlatformTime::Seconds();
+
+        if (bDelivered)
+        {
+            TSharedPtr<FJsonObject> TimingsJson = MakeShared<FJsonObject>();
+            TimingsJson->SetNumberField(TEXT("queued_ms"), ToMilliseconds(Capture->QueuedTime, Capture->StartTime));
+            TimingsJson->SetNumberField(TEXT("capture_ms"), ToMilliseconds(Capture->StartTime, CapturedTime));
+            TimingsJson->SetNumberField(TEXT("encode_ms"), ToMilliseconds(CapturedTime, EncodedTime));
+            TimingsJson->SetNumberField(TEXT("deliver_ms"), ToMilliseconds(EncodedTime, DeliveredTime));
+            TimingsJson->SetNumberField(TEXT("total_ms"), ToMilliseconds(Capture->QueuedTime, DeliveredTime));
+
+            ResultJson->SetBoolField(TEXT("success"), true);
+            ResultJson->SetStringField(TEXT("message"), TEXT("Screenshot captured"));
+            ResultJson->SetNumberField(TEXT("width"), Width);
+            ResultJson->SetNumberField(TEXT("height"), Height);
+            ResultJson->SetStringField(TEXT("format"), FUnrealMCPImageEncoder::GetExtension(Encoding.Format));
+            ResultJson->SetObjectField(TEXT("timings"), TimingsJson);
+        }
+        else
+        {
+            ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(Capture->OnComplete), ResultJson, Attachments = MoveTemp(Attachments)]() mutable
+        {
+            OnComplete(ResultJson, MoveTemp(Attachments));
+        });
+    });
+
+    StartNext();
+}
+
+bool FUnrealMCPScreenshotCapture::TickTimeout(float DeltaTime)
+{
+    if (!Active.IsValid())
+    {
+        TimeoutTickerHandle.Reset();
+        return false;
+    }
+
+    if (FPlatformTime::Seconds() - Active->StartTime > CaptureTimeoutSeconds)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCP: Screenshot %s timed out waiting for the viewport"), *Active->Path);
+        if (!Active->Request.bIncludeUI)
+        {
+            SetUIVisible(true);
+        }
+        FailActive(FString::Printf(TEXT("Screenshot was not captured within %.0f seconds"), CaptureTimeoutSeconds));
+        StartNext();
+    }
+    return true;
+}
+
+void FUnrealMCPScreenshotCapture::SetUIVisible(bool bVisible) const
+{
+    UWorld* World = GetScreenshotWorld();
+    if (World)
+    {
+        GEngine->Exec(World, bVisible ? TEXT("showflag.hud 1") : TEXT("showflag.hud 0"));
+        GEngine->Exec(World, bVisible ? TEXT("showflag.screenmessages 1") : TEXT("showflag.screenmessages 0"));
+    }
+}
+
+void FUnrealMCPScreenshotCapture::BindDelegates()
+{
+    // Editor viewports report through FScreenshotRequest, PIE/game viewports through UGameViewportClient
+    if (!ScreenshotRequestHandle.IsValid())
+    {
+        ScreenshotRequestHandle = FScreenshotRequest::OnScreenshotCaptured().AddRaw(this, &FUnrealMCPScreenshotCapture::HandleScreenshotCaptured);
+    }
+    if (!GameViewportHandle.IsValid())
+    {
+        GameViewportHandle = UGameViewportClient::OnScreenshotCaptured().AddRaw(this, &FUnrealMCPScreenshotCapture::HandleScreenshotCaptured);
+    }
+}
+
+void FUnrealMCPScreenshotCapture::UnbindDelegates()
+{
+    if (ScreenshotRequestHandle.IsValid())
+    {
+        FScreenshotRequest::OnScreenshotCaptured().Remove(ScreenshotRequestHandle);
+        ScreenshotRequestHandle.Reset();
+    }
+    if (GameViewportHandle.IsValid())
+    {
+        UGameViewportClient::OnScreenshotCaptured().Remove(GameViewportHandle);
+        GameViewportHandle.Reset();
+    }
+}
+
+void FUnrealMCPScreenshotCapture::FailActive(const FString& ErrorMessage)
+{
+    if (!Active.IsValid())
+    {
+        return;
+    }
+
+    TUniquePtr<FPendingCapture> Failed = MoveTemp(Active);
+    Failed->OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage), {});
+}
@@ -0,0 +1,475 @@
+#include "Commands/UnrealMCPSequenceCapture.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPConstructionScripts.h"
+#include "Commands/UnrealMCPViewportReadback.h"
+#include "Editor.h"
+#include "EditorViewportClient.h"
+#include "UnrealClient.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Async/Async.h"
+
+namespace
+{
+    TSharedPtr<FUnrealMCPSequenceCapture> ActiveSequence;
+
+    FViewport* GetSequenceViewport()
+    {
+        return GEditor ? GEditor->GetActiveViewport() : nullptr;
+    }
+
+    FEditorViewportClient* GetSequenceViewportClient()
+    {
+        FViewport* Viewport = GetSequenceViewport();
+        return Viewport ? static_cast<FEditorViewportClient*>(Viewport->GetClient()) : nullptr;
+    }
+
+    double ToMilliseconds(double StartSeconds, double EndSeconds)
+    {
+        return (EndSeconds - StartSeconds) * 1000.0;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> MakeNumberArray(double X, double Y, double Z)
+    {
+        return { MakeShared<FJsonValueNumber>(X), MakeShared<FJsonValueNumber>(Y), MakeShared<FJsonValueNumber>(Z) };
+    }
+
+    TSharedPtr<FJsonObject> MakeFrameError(int32 Index, const FString& ErrorMessage)
+    {
+        TSharedPtr<FJsonObject> FrameJson = FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage);
+        FrameJson->SetNumberField(TEXT("index"), Index);
+        return FrameJson;
+    }
+}
+
+bool FUnrealMCPSequenceCapture::ParseRequest(const TSharedPtr<FJsonObject>& Params, FUnrealMCPSequenceRequest& OutRequest, FString& OutError)
+{
+    const TArray<TSharedPtr<FJsonValue>>* FramesArray = nullptr;
+    if (!Params->TryGetArrayField(TEXT("frames"), FramesArray) || FramesArray->Num() == 0)
+    {
+        OutError = TEXT("Missing or empty 'frames' array");
+        return false;
+    }
+    if (FramesArray->Num() > MaxFrames)
+    {
+        OutError = FString::Printf(TEXT("A sequence can have at most %d frames"), MaxFrames);
+        return false;
+    }
+
+    for (int32 Index = 0; Index < FramesArray->Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* FrameObject = nullptr;
+        if (!(*FramesArray)[Index]->TryGetObject(FrameObject))
+        {
+            OutError = FString::Printf(TEXT("Frame %d is not an object"), Index);
+            return false;
+        }
+
+        FUnrealMCPSequenceFrame& Frame = OutRequest.Frames.AddDefaulted_GetRef();
+        if ((*FrameObject)->HasField(TEXT("location")))
+        {
+            Frame.Location = FUnrealMCPCommonUtils::GetVectorFromJson(*FrameObject, TEXT("location"));
+        }
+        if ((*FrameObject)->HasField(TEXT("rotation")))
+        {
+            Frame.Rotation = FUnrealMCPCommonUtils::GetRotatorFromJson(*FrameObject, TEXT("rotation"));
+        }
+        double TimeOfDay = 0.0;
+        if ((*FrameObject)->TryGetNumberField(TEXT("time_of_day"), TimeOfDay))
+        {
+            Frame.TimeOfDay = TimeOfDay;
+        }
+
+        if (!Frame.Location.IsSet() && !Frame.Rotation.IsSet() && !Frame.TimeOfDay.IsSet())
+        {
+            OutError = FString::Printf(TEXT("Frame %d sets none of 'location', 'rotation' or 'time_of_day'"), Index);
+            return false;
+        }
+    }
+
+    Params->TryGetNumberField(TEXT("settle_frames"), OutRequest.SettleFrames);
+    if (OutRequest.SettleFrames < 0 || OutRequest.SettleFrames > 60)
+    {
+        OutError = TEXT("settle_frames must be between 0 and 60");
+        return false;
+    }
+
+    Params->TryGetBoolField(TEXT("restore_camera"), OutRequest.bRestoreCamera);
+
+    if (!Params->TryGetStringField(TEXT("filename_prefix"), OutRequest.FilenamePrefix) || OutRequest.FilenamePrefix.IsEmpty())
+    {
+        OutRequest.FilenamePrefix = FString::Printf(TEXT("Sequence_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_%s")));
+    }
+    OutRequest.FilenamePrefix = FPaths::GetBaseFilename(OutRequest.FilenamePrefix);
+
+    return FUnrealMCPImageDelivery::ParseDelivery(Params, OutRequest.Delivery, OutError) &&
+           FUnrealMCPImageEncoder::ParseSettings(Params, OutRequest.Encoding, OutError);
+}
+
+void FUnrealMCPSequenceCapture::Start(FUnrealMCPSequenceRequest&& Request, FUnrealMCPCommandHandler SetTimeOfDay,
+                                      FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete)
+{
+    check(IsInGameThread());
+
+    if (ActiveSequence.IsValid())
+    {
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("A capture sequence is already running")), {});
+        return;
+    }
+
+    FEditorViewportClient* ViewportClient = GetSequenceViewportClient();
+    if (!ViewportClient)
+    {
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No active editor viewport")), {});
+        return;
+    }
+
+    // Workers encode through ImageWrapper, which must be loaded on the game thread
+    FUnrealMCPImageEncoder::Load();
+
+    TSharedPtr<FUnrealMCPSequenceCapture> Sequence = MakeShared<FUnrealMCPSequenceCapture>(MoveTemp(Request), MoveTemp(SetTimeOfDay), MoveTemp(OnProgress), MoveTemp(OnComplete));
+    Sequence->bHaveSavedCamera = true;
+    Sequence->SavedLocation = ViewportClient->GetViewLocation();
+    Sequence->SavedRotation = ViewportClient->GetViewRotation();
+    Sequence->StartTime = FPlatformTime::Seconds();
+    Sequence->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(Sequence.ToSharedRef(), &FUnrealMCPSequenceCapture::Tick));
+
+    ActiveSequence = Sequence;
+}
+
+FUnrealMCPSequenceCapture::FUnrealMCPSequenceCapture(FUnrealMCPSequenceRequest&& InRequest, FUnrealMCPCommandHandler InSetTimeOfDay,
+                                                     FUnrealMCPCommandProgress InOnProgress, FUnrealMCPCommandCompletion InOnComplete)
+    : Request(MoveTemp(InRequest))
+    , SetTimeOfDay(MoveTemp(InSetTimeOfDay))
+    , OnProgress(MoveTemp(InOnProgress))
+    , OnComplete(MoveTemp(InOnComplete))
+{
+    Times.SetNum(Request.Frames.Num());
+    FrameResults.SetNum(Request.Frames.Num());
+}
+
+bool FUnrealMCPSequenceCapture::Tick(float DeltaTime)
+{
+    // One tick may apply the next frame right after issuing the previous frame's readback:
+    // the copy is already queued on the render thread, so the new state can't leak into it
+    for (;;)
+    {
+        // A frame reported from this loop may have aborted the sequence
+        if (bFinished)
+        {
+            return false;
+        }
+
+        switch (Step)
+        {
+        case EStep::Apply:
+        {
+            if (CurrentFrame >= Request.Frames.Num())
+            {
+                RestoreCamera();
+                Step = EStep::Draining;
+                break;
+            }
+
+            FString ErrorMessage;
+            if (!ApplyFrame(CurrentFrame, ErrorMessage))
+            {
+                OnFrameDone(CurrentFrame, MakeFrameError(CurrentFrame, ErrorMessage), {});
+                ++CurrentFrame;
+                break;
+            }
+            Step = EStep::Settle;
+            return true;
+        }
+
+        case EStep::Settle:
+            if (GFrameCounter - Times[CurrentFrame].AppliedFrameCounter < (uint64)Request.SettleFrames)
+            {
+                return true;
+            }
+            Step = EStep::Capture;
+            break;
+
+        case EStep::Capture:
+        {
+            FViewport* Viewport = GetSequenceViewport();
+            if (!Viewport)
+            {
+                OnFrameDone(CurrentFrame, MakeFrameError(CurrentFrame, TEXT("The editor viewport went away")), {});
+            }
+            else
+            {
+                // Wait for a free slot so the copy is taken now, not after the next frame is applied
+                if (!FUnrealMCPViewportReadback::Get().HasFreeSlot())
+                {
+                    return true;
+                }
+
+                Times[CurrentFrame].CaptureStarted = FPlatformTime::Seconds();
+                FUnrealMCPViewportReadback::Get().Capture(Viewport, true, [Self = AsShared(), Index = CurrentFrame](FUnrealMCPViewportPixels&& Pixels)
+                {
+                    Self->OnReadback(Index, MoveTemp(Pixels));
+                });
+            }
+            ++CurrentFrame;
+            Step = EStep::Apply;
+            break;
+        }
+
+        case EStep::Draining:
+            if (FramesDone == Request.Frames.Num())
+            {
+                Finish();
+            }
+            return !bFinished;
+        }
+    }
+}
+
+bool FUnrealMCPSequenceCapture::ApplyFrame(int32 Index, FString& OutError)
+{
+    const FUnrealMCPSequenceFrame& Frame = Request.Frames[Index];
+    Times[Index].Applied = FPlatformTime::Seconds();
+    Times[Index].AppliedFrameCounter = GFrameCounter;
+
+    if (Frame.TimeOfDay.IsSet())
+    {
+        if (!SetTimeOfDay)
+        {
+            OutError = TEXT("set_time_of_day is not available");
+            return false;
+        }
+
+        TSharedPtr<FJsonObject> TimeParams = MakeShared<FJsonObject>();
+        TimeParams->SetNumberField(TEXT("time_of_day"), Frame.TimeOfDay.GetValue());
+        TSharedPtr<FJsonObject> TimeResult = SetTimeOfDay(TimeParams);
+
+        bool bSuccess = TimeResult.IsValid();
+        if (bSuccess && TimeResult->TryGetBoolField(TEXT("success"), bSuccess) && !bSuccess)
+        {
+            TimeResult->TryGetStringField(TEXT("error"), OutError);
+            return false;
+        }
+        if (!bSuccess)
+        {
+            OutError = TEXT("Failed to set time of day");
+            return false;
+        }
+
+        // Rebuild the sky now so the settle frames already render it
+        FUnrealMCPConstructionScripts::Get().Flush();
+    }
+
+    FEditorViewportClient* ViewportClient = GetSequenceViewportClient();
+    if (!ViewportClient)
+    {
+        OutError = TEXT("No active editor viewport");
+        return false;
+    }
+    if (Frame.Location.IsSet())
+    {
+        ViewportClient->SetViewLocation(Frame.Location.GetValue());
+    }
+    if (Frame.Rotation.IsSet())
+    {
+        ViewportClient->SetViewRotation(Frame.Rotation.GetValue());
+    }
+
+    // Non-realtime viewports only draw when invalidated
+    ViewportClient->Invalidate();
+    return true;
+}
+
+void FUnrealMCPSequenceCapture::OnReadback(int32 Index, FUnrealMCPViewportPixels&& Pixels)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    if (!Pixels.bSuccess)
+    {
+        OnFrameDone(Index, MakeFrameError(Index, Pixels.Error), {});
+        return;
+    }
+
+    Times[Index].ReadbackDone = FPlatformTime::Seconds();
+
+    const FString Path = FPaths::ConvertRelativePathToFull(FPaths::ScreenShotDir() /
+        FString::Printf(TEXT("%s_%03d.%s"), *Request.FilenamePrefix, Index, FUnrealMCPImageEncoder::GetExtension(Request.Encoding.Format)));
+
+    // Encoding runs on the pool while the game thread moves on to the next frame
+    Async(EAsyncExecution::ThreadPool, [Self = AsShared(), Index, Pixels = MoveTemp(Pixels), Path, Frame = Request.Frames[Index], FrameTimes = Times[Index],
+                                        Delivery = Request.Delivery, Encoding = Request.Encoding]() mutable
+    {
+        TArray64<uint8> Encoded;
+        FString ErrorMessage;
+        const bool bEncoded = FUnrealMCPImageEncoder::Encode(Encoding, Pixels.Width, Pixels.Height, Pixels.Pixels, Encoded, ErrorMessage);
+        const double EncodedTime = FPlatformTime::Seconds();
+
+        TSharedPtr<FJsonObject> FrameJson = MakeShared<FJsonObject>();
+        TArray<FUnrealMCPAttachment> Attachments;
+        if (bEncoded && FUnrealMCPImageDelivery::Deliver(Delivery, Path, FUnrealMCPImageEncoder::GetContentType(Encoding.Format),
+                                                         MoveTemp(Encoded), FrameJson, Attachments, ErrorMessage))
+        {
+            const double DeliveredTime = FPlatformTime::Seconds();
+            TSharedPtr<FJsonObject> TimingsJson = MakeShared<FJsonObject>();
+            TimingsJson->SetNumberField(TEXT("settle_ms"), ToMilliseconds(FrameTimes.Applied, FrameTimes.CaptureStarted));
+            TimingsJson->SetNumberField(TEXT("readback_ms"), ToMilliseconds(FrameTimes.CaptureStarted, FrameTimes.ReadbackDone));
+            TimingsJson->SetNumberField(TEXT("readback_frames"), (double)Pixels.Frames);
+            TimingsJson->SetNumberField(TEXT("encode_ms"), ToMilliseconds(FrameTimes.ReadbackDone, EncodedTime));
+            TimingsJson->SetNumberField(TEXT("deliver_ms"), ToMilliseconds(EncodedTime, DeliveredTime));
+            TimingsJson->SetNumberField(TEXT("total_ms"), ToMilliseconds(FrameTimes.Applied, DeliveredTime));
+
+            FrameJson->SetNumberField(TEXT("index"), Index);
+            FrameJson->SetNumberField(TEXT("width"), Pixels.Width);
+            FrameJson->SetNumberField(TEXT("height"), Pixels.Height);
+            FrameJson->SetStringField(TEXT("format"), FUnrealMCPImageEncoder::GetExtension(Encoding.Format));
+            if (Frame.Location.IsSet())
+            {
+                const FVector& Location = Frame.Location.GetValue();
+                FrameJson->SetArrayField(TEXT("location"), MakeNumberArray(Location.X, Location.Y, Location.Z));
+            }
+            if (Frame.Rotation.IsSet())
+            {
+                const FRotator& Rotation = Frame.Rotation.GetValue();
+                FrameJson->SetArrayField(TEXT("rotation"), MakeNumberArray(Rotation.Pitch, Rotation.Yaw, Rotation.Roll));
+            }
+            if (Frame.TimeOfDay.IsSet())
+            {
+                FrameJson->SetNumberField(TEXT("time_of_day"), Frame.TimeOfDay.GetValue());
+            }
+            FrameJson->SetObjectField(TEXT("timings"), TimingsJson);
+        }
+        else
+        {
+            FrameJson = MakeFrameError(Index, ErrorMessage);
+            Attachments.Reset();
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [Self, Index, FrameJson, Attachments = MoveTemp(Attachments)]() mutable
+        {
+            Self->OnFrameDone(Index, FrameJson, MoveTemp(Attachments));
+        });
+    });
+}
+
+void FUnrealMCPSequenceCapture::OnFrameDone(int32 Index, TSharedPtr<FJsonObject> FrameJson, TArray<FUnrealMCPAttachment> Attachments)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    ++FramesDone;
+
+    bool bSuccess = true;
+    if (FrameJson->TryGetBoolField(TEXT("success"), bSuccess) && !bSuccess)
+    {
+        ++FramesFailed;
+    }
+
+    // Several frames may share one response, so give each attachment its own name
+    for (FUnrealMCPAttachment& Attachment : Attachments)
+    {
+        Attachment.Name = FString::Printf(TEXT("frame_%d"), Index);
+        FrameJson->SetStringField(TEXT("attachment"), Attachment.Name);
+    }
+
+    FrameResults[Index] = MakeShared<FJsonValueObject>(FrameJson);
+
+    if (OnProgress)
+    {
+        TSharedPtr<FJsonObject> ProgressJson = MakeShared<FJsonObject>();
+        ProgressJson->SetNumberField(TEXT("frames_done"), FramesDone);
+        ProgressJson->SetNumberField(TEXT("frames_total"), Request.Frames.Num());
+        ProgressJson->SetObjectField(TEXT("frame"), FrameJson);
+        if (!OnProgress(ProgressJson, MoveTemp(Attachments)))
+        {
+            // Nobody is left to receive the rest, so stop moving the camera and writing images
+            Abort(TEXT("Client disconnected during the capture sequence"));
+            return;
+        }
+    }
+    else
+    {
+        HeldAttachments.Append(MoveTemp(Attachments));
+    }
+
+    if (Step == EStep::Draining && FramesDone == Request.Frames.Num())
+    {
+        Finish();
+    }
+}
+
+void FUnrealMCPSequenceCapture::RestoreCamera()
+{
+    if (!bHaveSavedCamera)
+    {
+        return;
+    }
+    bHaveSavedCamera = false;
+
+    FEditorViewportClient* ViewportClient = GetSequenceViewportClient();
+    if (Request.bRestoreCamera && ViewportClient)
+    {
+        ViewportClient->SetViewLocation(SavedLocation);
+        ViewportClient->SetViewRotation(SavedRotation);
+        ViewportClient->Invalidate();
+    }
+}
+
+void FUnrealMCPSequenceCapture::Abort(const FString& ErrorMessage)
+{
+    if (bFinished)
+    {
+        return;
+    }
+    bFinished = true;
+
+    TSharedRef<FUnrealMCPSequenceCapture> KeepAlive = AsShared();
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+    RestoreCamera();
+    ActiveSequence.Reset();
+    HeldAttachments.Empty();
+
+    OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage), {});
+}
+
+void FUnrealMCPSequenceCapture::Finish()
+{
+    if (bFinished)
+    {
+        return;
+    }
+    bFinished = true;
+
+    // Dropping ActiveSequence may release the last reference to this
+    TSharedRef<FUnrealMCPSequenceCapture> KeepAlive = AsShared();
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+    RestoreCamera();
+    ActiveSequence.Reset();
+
+    const int32 NumFrames = Request.Frames.Num();
+    const double TotalMs = ToMilliseconds(StartTime, FPlatformTime::Seconds());
+
+    if (FramesFailed == NumFrames)
+    {
+        FString FirstError = TEXT("unknown error");
+        FrameResults[0]->AsObject()->TryGetStringField(TEXT("error"), FirstError);
+        OnComplete(FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("All %d frames failed; first error: %s"), NumFrames, *FirstError)), {});
+        return;
+    }
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetBoolField(TEXT("success"), true);
+    ResultJson->SetNumberField(TEXT("frames_total"), NumFrames);
+    ResultJson->SetNumberField(TEXT("frames_captured"), NumFrames - FramesFailed);
+    ResultJson->SetNumberField(TEXT("frames_failed"), FramesFailed);
+    ResultJson->SetBoolField(TEXT("streamed"), (bool)OnProgress);
+    ResultJson->SetNumberField(TEXT("total_ms"), TotalMs);
+    ResultJson->SetNumberField(TEXT("frames_per_second"), TotalMs > 0.0 ? (NumFrames - FramesFailed) * 1000.0 / TotalMs : 0.0);
+    ResultJson->SetArrayField(TEXT("frames"), FrameResults);
+
+    OnComplete(ResultJson, MoveTemp(HeldAttachments));
+}
@@ -0,0 +1,344 @@
+#include "Commands/UnrealMCPSpatialIndex.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "LevelEditorViewport.h"
+#include "SceneManagement.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+
+namespace
+{
+    // Keeps the tree usefully deep even when a level's actors sit close together
+    constexpr double MinRootExtent = 10000.0;
+
+    // Elements outside the root all pile up in the root node; past this many, rebuild around them
+    constexpr int32 MinOutsideRootForRebuild = 64;
+
+    FLevelEditorViewportClient* FindLevelViewportClient(UWorld* World)
+    {
+        if (GCurrentLevelEditingViewportClient && GCurrentLevelEditingViewportClient->GetWorld() == World &&
+            GCurrentLevelEditingViewportClient->IsPerspective())
+        {
+            return GCurrentLevelEditingViewportClient;
+        }
+
+        if (GEditor)
+        {
+            for (FLevelEditorViewportClient* ViewportClient : GEditor->GetLevelViewportClients())
+            {
+                if (ViewportClient && ViewportClient->GetWorld() == World && ViewportClient->IsPerspective())
+                {
+                    return ViewportClient;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    void SortByDistance(TArray<FUnrealMCPSpatialHit>& Hits)
+    {
+        Hits.Sort([](const FUnrealMCPSpatialHit& A, const FUnrealMCPSpatialHit& B) { return A.Distance < B.Distance; });
+    }
+}
+
+FUnrealMCPSpatialIndex::FUnrealMCPSpatialIndex(UWorld* World)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    bGameWorld = World && World->IsGameWorld();
+
+    TArray<AActor*> Actors;
+    FBox Locations(ForceInit);
+    if (World)
+    {
+        for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
+        {
+            AActor* Actor = *ActorItr;
+            if (IsValid(Actor) && Actor->GetRootComponent())
+            {
+                Actors.Add(Actor);
+                if (!IsDynamic(Actor))
+                {
+                    Locations += Actor->GetActorLocation();
+                }
+            }
+        }
+    }
+
+    // Fit the root to where actors are rather than the whole world, or every
+    // leaf would be kilometres wide. Oversized actors settle in the upper nodes.
+    const FVector Origin = Locations.IsValid ? Locations.GetCenter() : FVector::ZeroVector;
+    const double Extent = FMath::Max(Locations.IsValid ? Locations.GetExtent().GetMax() * 1.25 : 0.0, MinRootExtent);
+    RootBounds = FBox(Origin - FVector(Extent), Origin + FVector(Extent));
+    Octree = MakeUnique<FOctree>(Origin, Extent);
+
+    for (AActor* Actor : Actors)
+    {
+        AddActor(Actor);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealMCP: Built spatial index for %d actors (%d dynamic) in %s (%.1f ms)"),
+           Num(), Dynamic.Num(), World ? *World->GetName() : TEXT("<none>"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FUnrealMCPSpatialIndex::AddActor(AActor* Actor)
+{
+    // Actors without a root (world settings, game modes) have no place in the world
+    if (!IsValid(Actor) || !Actor->GetRootComponent())
+    {
+        return;
+    }
+
+    const TObjectKey<AActor> Key(Actor);
+    if (ElementIds.Contains(Key) || Dynamic.Contains(Key))
+    {
+        return;
+    }
+
+    if (IsDynamic(Actor))
+    {
+        Dynamic.Add(Key, Actor);
+        return;
+    }
+
+    FElement Element;
+    Element.Actor = Actor;
+    Element.Key = Key;
+    Element.Bounds = FBoxCenterAndExtent(GetActorBounds(Actor));
+    Element.Ids = &ElementIds;
+
+    if (!RootBounds.IsInsideOrOn(FVector(Element.Bounds.Center)))
+    {
+        ++OutsideRoot;
+    }
+    Octree->AddElement(Element);
+}
+
+void FUnrealMCPSpatialIndex::RemoveActor(AActor* Actor)
+{
+    const TObjectKey<AActor> Key(Actor);
+    if (Dynamic.Remove(Key) > 0)
+    {
+        return;
+    }
+
+    FOctreeElementId2 ElementId;
+    if (!ElementIds.RemoveAndCopyValue(Key, ElementId) || !Octree->IsValidElementId(ElementId))
+    {
+        return;
+    }
+
+    if (!RootBounds.IsInsideOrOn(FVector(Octree->GetElementById(ElementId).Bounds.Center)))
+    {
+        --OutsideRoot;
+    }
+    Octree->RemoveElement(ElementId);
+}
+
+void FUnrealMCPSpatialIndex::UpdateActor(AActor* Actor)
+{
+    RemoveActor(Actor);
+    AddActor(Actor);
+}
+
+bool FUnrealMCPSpatialIndex::NeedsRebuild() const
+{
+    return OutsideRoot >= MinOutsideRootForRebuild && OutsideRoot * 4 >= ElementIds.Num();
+}
+
+void FUnrealMCPSpatialIndex::FindInSphere(const FVector& Center, double Radius, TArray<FUnrealMCPSpatialHit>& OutHits) const
+{
+    const FSphere Sphere(Center, Radius);
+    auto Overlaps = [&Sphere](const FBox& Bounds, const AActor* Actor, double& OutDistance)
+    {
+        OutDistance = FVector::Dist(Sphere.Center, Actor->GetActorLocation());
+        return FMath::SphereAABBIntersection(Sphere, Bounds);
+    };
+
+    const FBox QueryBox(Center - FVector(Radius), Center + FVector(Radius));
+    Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(QueryBox), [&Overlaps, &OutHits](const FElement& Element)
+    {
+        TestElement(Element, Overlaps, OutHits);
+    });
+    ForEachDynamic(Overlaps, OutHits);
+
+    SortByDistance(OutHits);
+}
+
+void FUnrealMCPSpatialIndex::FindInFrustum(const FConvexVolume& Frustum, const FVector& Origin, TArray<FUnrealMCPSpatialHit>& OutHits) const
+{
+    auto Overlaps = [&Frustum, &Origin](const FBox& Bounds, const AActor* Actor, double& OutDistance)
+    {
+        OutDistance = FVector::Dist(Origin, Actor->GetActorLocation());
+        return Frustum.IntersectBox(Bounds.GetCenter(), Bounds.GetExtent());
+    };
+
+    Octree->FindElementsWithPredicate(
+        [&Frustum](FOctreeNodeIndex ParentNodeIndex, FOctreeNodeIndex NodeIndex, const FBoxCenterAndExtent& NodeBounds)
+        {
+            return Frustum.IntersectBox(FVector(NodeBounds.Center), FVector(NodeBounds.Extent));
+        },
+        [&Overlaps, &OutHits](FOctreeNodeIndex ParentNodeIndex, const FElement& Element)
+        {
+            TestElement(Element, Overlaps, OutHits);
+        });
+    ForEachDynamic(Overlaps, OutHits);
+
+    SortByDistance(OutHits);
+}
+
+void FUnrealMCPSpatialIndex::FindAlongRay(const FVector& Start, const FVector& End, TArray<FUnrealMCPSpatialHit>& OutHits) const
+{
+    const FVector StartToEnd = End - Start;
+    const double Length = StartToEnd.Size();
+    if (Length <= UE_KINDA_SMALL_NUMBER)
+    {
+        return;
+    }
+
+    auto Overlaps = [&Start, &End, Length](const FBox& Bounds, const AActor* Actor, double& OutDistance)
+    {
+        FVector HitLocation;
+        FVector HitNormal;
+        float HitTime = 0.0f;
+        if (!FMath::LineExtentBoxIntersection(Bounds, Start, End, FVector::ZeroVector, HitLocation, HitNormal, HitTime))
+        {
+            return false;
+        }
+        OutDistance = HitTime * Length;
+        return true;
+    };
+
+    Octree->FindElementsWithPredicate(
+        [&Start, &End, &StartToEnd](FOctreeNodeIndex ParentNodeIndex, FOctreeNodeIndex NodeIndex, const FBoxCenterAndExtent& NodeBounds)
+        {
+            return FMath::LineBoxIntersection(NodeBounds.GetBox(), Start, End, StartToEnd);
+        },
+        [&Overlaps, &OutHits](FOctreeNodeIndex ParentNodeIndex, const FElement& Element)
+        {
+            TestElement(Element, Overlaps, OutHits);
+        });
+    ForEachDynamic(Overlaps, OutHits);
+
+    SortByDistance(OutHits);
+}
+
+FBox FUnrealMCPSpatialIndex::GetActorBounds(const AActor* Actor)
+{
+    FBox Bounds = Actor->GetComponentsBoundingBox(true);
+    if (!Bounds.IsValid)
+    {
+        const FVector Location = Actor->GetActorLocation();
+        Bounds = FBox(Location, Location);
+    }
+    return Bounds;
+}
+
+bool FUnrealMCPSpatialIndex::IsDynamic(const AActor* Actor) const
+{
+    return bGameWorld && Actor->IsRootComponentMovable();
+}
+
+template <typename OverlapFunc>
+void FUnrealMCPSpatialIndex::TestElement(const FElement& Element, const OverlapFunc& Overlaps, TArray<FUnrealMCPSpatialHit>& OutHits)
+{
+    AActor* Actor = Element.Actor.Get();
+    double Distance = 0.0;
+    if (IsValid(Actor) && Overlaps(Element.Bounds.GetBox(), Actor, Distance))
+    {
+        OutHits.Add({ Actor, Distance });
+    }
+}
+
+template <typename OverlapFunc>
+void FUnrealMCPSpatialIndex::ForEachDynamic(const OverlapFunc& Overlaps, TArray<FUnrealMCPSpatialHit>& OutHits) const
+{
+    for (const TPair<TObjectKey<AActor>, TWeakObjectPtr<AActor>>& Pair : Dynamic)
+    {
+        AActor* Actor = Pair.Value.Get();
+        double Distance = 0.0;
+        if (IsValid(Actor) && Overlaps(GetActorBounds(Actor), Actor, Distance))
+        {
+            OutHits.Add({ Actor, Distance });
+        }
+    }
+}
+
+bool FUnrealMCPSpatialView::FromWorld(UWorld* World, FUnrealMCPSpatialView& OutView, FString& OutError)
+{
+    if (!World)
+    {
+        OutError = TEXT("Failed to get world context");
+        return false;
+    }
+
+    if (World->IsGameWorld())
+    {
+        APlayerController* PlayerController = World->GetFirstPlayerController();
+        if (!PlayerController)
+        {
+            OutError = TEXT("Game world has no player controller to take the view from");
+            return false;
+        }
+
+        PlayerController->GetPlayerViewPoint(OutView.Location, OutView.Rotation);
+        if (PlayerController->PlayerCameraManager)
+        {
+            OutView.FOV = PlayerController->PlayerCameraManager->GetFOVAngle();
+        }
+        if (UGameViewportClient* GameViewport = World->GetGameViewport())
+        {
+            FVector2D Size;
+            GameViewport->GetViewportSize(Size);
+            if (Size.X > 0.0 && Size.Y > 0.0)
+            {
+                OutView.AspectRatio = Size.X / Size.Y;
+            }
+        }
+    }
+    else
+    {
+        FLevelEditorViewportClient* ViewportClient = FindLevelViewportClient(World);
+        if (!ViewportClient)
+        {
+            OutError = TEXT("No perspective level viewport is showing the world");
+            return false;
+        }
+
+        OutView.Location = ViewportClient->GetViewLocation();
+        OutView.Rotation = ViewportClient->GetViewRotation();
+        OutView.FOV = ViewportClient->ViewFOV;
+        if (ViewportClient->Viewport)
+        {
+            const FIntPoint Size = ViewportClient->Viewport->GetSizeXY();
+            if (Size.X > 0 && Size.Y > 0)
+            {
+                OutView.AspectRatio = (float)Size.X / (float)Size.Y;
+            }
+        }
+    }
+
+    OutView.BuildFrustum();
+    return true;
+}
+
+void FUnrealMCPSpatialView::BuildFrustum()
+{
+    // View space looks down +Z with +X right and +Y up
+    const FMatrix ViewMatrix = FTranslationMatrix(-Location) * FInverseRotationMatrix(Rotation) *
+        FMatrix(FPlane(0, 0, 1, 0), FPlane(1, 0, 0, 0), FPlane(0, 1, 0, 0), FPlane(0, 0, 0, 1));
+    const float HalfFOV = FMath::DegreesToRadians(FMath::Clamp(FOV, 1.0f, 170.0f) * 0.5f);
+    const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix(HalfFOV, FMath::Max(AspectRatio, 0.01f), 1.0f, 10.0f);
+
+    // No near plane: the side planes already meet at the camera
+    GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, false);
+
+    if (MaxDistance > 0.0)
+    {
+        const FVector Forward = Rotation.Vector();
+        Frustum.Planes.Add(FPlane(Location + Forward * MaxDistance, Forward));
+        Frustum.Init();
+    }
+}
@@ -0,0 +1,254 @@
+#include "Commands/UnrealMCPSubscriptions.h"
+#include "Commands/UnrealMCPPropertyBindings.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+    // Transform noise below this (cm, degrees, scale) is not reported as a move
+    constexpr double TransformTolerance = 1.e-3;
+
+    TArray<TSharedPtr<FJsonValue>> MakeNumberArray(double X, double Y, double Z)
+    {
+        return { MakeShared<FJsonValueNumber>(X), MakeShared<FJsonValueNumber>(Y), MakeShared<FJsonValueNumber>(Z) };
+    }
+}
+
+FUnrealMCPSubscriptions& FUnrealMCPSubscriptions::Get()
+{
+    static FUnrealMCPSubscriptions Instance;
+    return Instance;
+}
+
+int32 FUnrealMCPSubscriptions::Subscribe(const TArray<AActor*>& Actors, bool bTransform, const TArray<FName>& Properties, double MinInterval,
+                                         FUnrealMCPCommandProgress&& OnNotify, TSharedPtr<FJsonObject>& OutSnapshot)
+{
+    check(IsInGameThread());
+
+    FUnrealMCPPropertyBindings& Bindings = FUnrealMCPPropertyBindings::Get();
+    FSubscription& Subscription = Subscriptions.AddDefaulted_GetRef();
+    Subscription.Id = NextId++;
+    Subscription.ClientId = CurrentClientId;
+    Subscription.bTransform = bTransform;
+    Subscription.Properties = Properties;
+    Subscription.MinInterval = FMath::Max(0.0, MinInterval);
+    Subscription.LastSent = FPlatformTime::Seconds();
+    Subscription.OnNotify = MoveTemp(OnNotify);
+
+    TArray<TSharedPtr<FJsonValue>> ActorsJson;
+    TSharedPtr<FJsonObject> ErrorsObj = MakeShared<FJsonObject>();
+    for (AActor* Actor : Actors)
+    {
+        if (!IsValid(Actor))
+        {
+            continue;
+        }
+
+        FWatchedActor& Watched = Subscription.Actors.AddDefaulted_GetRef();
+        Watched.Actor = Actor;
+        Watched.Name = Actor->GetName();
+        Watched.Transform = Actor->GetActorTransform();
+
+        TSharedPtr<FJsonObject> ActorJson = MakeShared<FJsonObject>();
+        ActorJson->SetStringField(TEXT("actor_name"), Watched.Name);
+        if (bTransform)
+        {
+            WriteTransform(Watched.Transform, ActorJson);
+        }
+        if (Properties.Num() > 0)
+        {
+            TSharedPtr<FJsonObject> ValuesObj = MakeShared<FJsonObject>();
+            for (const FName& Property : Properties)
+            {
+                FString Error;
+                TSharedPtr<FJsonValue>& Value = Watched.Values.Add_GetRef(Bindings.GetValue(Actor, Property, Error));
+                if (Value.IsValid())
+                {
+                    ValuesObj->SetField(Property.ToString(), Value);
+                }
+                else
+                {
+                    ErrorsObj->SetStringField(FString::Printf(TEXT("%s.%s"), *Watched.Name, *Property.ToString()), Error);
+                }
+            }
+            ActorJson->SetObjectField(TEXT("properties"), ValuesObj);
+        }
+        ActorsJson.Add(MakeShared<FJsonValueObject>(ActorJson));
+    }
+
+    OutSnapshot = MakeShared<FJsonObject>();
+    OutSnapshot->SetNumberField(TEXT("subscription_id"), Subscription.Id);
+    OutSnapshot->SetArrayField(TEXT("actors"), ActorsJson);
+    if (ErrorsObj->Values.Num() > 0)
+    {
+        OutSnapshot->SetObjectField(TEXT("errors"), ErrorsObj);
+    }
+
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUnrealMCPSubscriptions::Tick));
+    }
+    return Subscription.Id;
+}
+
+bool FUnrealMCPSubscriptions::Unsubscribe(int32 Id)
+{
+    check(IsInGameThread());
+    // Ids are sequential, so without the owner check any client could cancel another's feed
+    const int32 ClientId = CurrentClientId;
+    return Subscriptions.RemoveAll([Id, ClientId](const FSubscription& Subscription) { return Subscription.Id == Id && Subscription.ClientId == ClientId; }) > 0;
+}
+
+FUnrealMCPSubscriptions::FScopedClient::FScopedClient(int32 ClientId)
+{
+    check(IsInGameThread());
+    FUnrealMCPSubscriptions& Subscriptions = FUnrealMCPSubscriptions::Get();
+    Previous = Subscriptions.CurrentClientId;
+    Subscriptions.CurrentClientId = ClientId;
+}
+
+FUnrealMCPSubscriptions::FScopedClient::~FScopedClient()
+{
+    FUnrealMCPSubscriptions::Get().CurrentClientId = Previous;
+}
+
+void FUnrealMCPSubscriptions::Shutdown()
+{
+    Subscriptions.Reset();
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+bool FUnrealMCPSubscriptions::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    for (int32 Index = 0; Index < Subscriptions.Num();)
+    {
+        FSubscription& Subscription = Subscriptions[Index];
+
+        // Skipped checks are not lost: the next one diffs against the last report
+        bool bKeep = true;
+        bool bNotified = false;
+        if (Now - Subscription.LastSent >= Subscription.MinInterval)
+        {
+            TArray<TSharedPtr<FJsonValue>> Changes;
+            for (FWatchedActor& Watched : Subscription.Actors)
+            {
+                if (TSharedPtr<FJsonObject> Change = Diff(Subscription, Watched))
+                {
+                    Changes.Add(MakeShared<FJsonValueObject>(Change));
+                }
+            }
+            Subscription.Actors.RemoveAll([](const FWatchedActor& Watched) { return !Watched.Actor.IsValid(); });
+
+            if (Changes.Num() > 0)
+            {
+                TSharedPtr<FJsonObject> Notification = MakeShared<FJsonObject>();
+                Notification->SetNumberField(TEXT("subscription_id"), Subscription.Id);
+                Notification->SetNumberField(TEXT("frame"), (double)GFrameCounter);
+                Notification->SetArrayField(TEXT("changes"), Changes);
+                Subscription.LastSent = Now;
+
+                // The client went away
+                bKeep = Subscription.OnNotify(Notification, {});
+                bNotified = true;
+            }
+            bKeep = bKeep && Subscription.Actors.Num() > 0;
+        }
+
+        // Quiet subscriptions still notice a disconnect without waiting for a change
+        if (bKeep && !bNotified)
+        {
+            bKeep = Subscription.OnNotify(nullptr, {});
+        }
+
+        if (bKeep)
+        {
+            ++Index;
+        }
+        else
+        {
+            Subscriptions.RemoveAt(Index);
+        }
+    }
+
+    if (Subscriptions.Num() == 0)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPSubscriptions::Diff(const FSubscription& Subscription, FWatchedActor& Watched)
+{
+    AActor* Actor = Watched.Actor.Get();
+    if (!IsValid(Actor))
+    {
+        Watched.Actor.Reset();
+        TSharedPtr<FJsonObject> Change = MakeShared<FJsonObject>();
+        Change->SetStringField(TEXT("actor_name"), Watched.Name);
+        Change->SetBoolField(TEXT("deleted"), true);
+        return Change;
+    }
+
+    TSharedPtr<FJsonObject> Change;
+    auto GetChange = [&Change, &Watched]() -> FJsonObject&
+    {
+        if (!Change.IsValid())
+        {
+            Change = MakeShared<FJsonObject>();
+            Change->SetStringField(TEXT("actor_name"), Watched.Name);
+        }
+        return *Change;
+    };
+
+    if (Subscription.bTransform)
+    {
+        const FTransform Transform = Actor->GetActorTransform();
+        if (!Transform.Equals(Watched.Transform, TransformTolerance))
+        {
+            Watched.Transform = Transform;
+            GetChange();
+            WriteTransform(Transform, Change);
+        }
+    }
+
+    FUnrealMCPPropertyBindings& Bindings = FUnrealMCPPropertyBindings::Get();
+    TSharedPtr<FJsonObject> ValuesObj;
+    for (int32 Index = 0; Index < Subscription.Properties.Num(); ++Index)
+    {
+        TSharedPtr<FJsonValue>& LastValue = Watched.Values[Index];
+        if (!LastValue.IsValid())
+        {
+            continue;
+        }
+
+        FString Error;
+        TSharedPtr<FJsonValue> Value = Bindings.GetValue(Actor, Subscription.Properties[Index], Error);
+        if (Value.IsValid() && !FJsonValue::CompareEqual(*Value, *LastValue))
+        {
+            if (!ValuesObj.IsValid())
+            {
+                ValuesObj = MakeShared<FJsonObject>();
+                GetChange().SetObjectField(TEXT("properties"), ValuesObj);
+            }
+            ValuesObj->SetField(Subscription.Properties[Index].ToString(), Value);
+            LastValue = Value;
+        }
+    }
+    return Change;
+}
+
+void FUnrealMCPSubscriptions::WriteTransform(const FTransform& Transform, const TSharedPtr<FJsonObject>& OutJson)
+{
+    const FVector Location = Transform.GetLocation();
+    const FRotator Rotation = Transform.Rotator();
+    const FVector Scale = Transform.GetScale3D();
+    OutJson->SetArrayField(TEXT("location"), MakeNumberArray(Location.X, Location.Y, Location.Z));
+    OutJson->SetArrayField(TEXT("rotation"), MakeNumberArray(Rotation.Pitch, Rotation.Yaw, Rotation.Roll));
+    OutJson->SetArrayField(TEXT("scale"), MakeNumberArray(Scale.X, Scale.Y, Scale.Z));
+}
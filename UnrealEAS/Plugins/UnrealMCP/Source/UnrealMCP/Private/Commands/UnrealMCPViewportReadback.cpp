@@ -0,0 +1,344 @@
+#include "Commands/UnrealMCPViewportReadback.h"
+#include "UnrealClient.h"
+#include "Editor.h"
+#include "EditorViewportClient.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "RHI.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "Math/Float16Color.h"
+#include "Misc/App.h"
+#include "Algo/AnyOf.h"
+#include "Async/Async.h"
+
+namespace
+{
+    // Converts one row of a mapped staging texture to FColor. Returns false for formats we can't read.
+    bool ConvertRow(EPixelFormat Format, const uint8* Src, FColor* Dst, int32 Width)
+    {
+        switch (Format)
+        {
+        case PF_B8G8R8A8:
+            FMemory::Memcpy(Dst, Src, Width * sizeof(FColor));
+            return true;
+        case PF_R8G8B8A8:
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const uint8* Texel = Src + X * 4;
+                Dst[X] = FColor(Texel[0], Texel[1], Texel[2], Texel[3]);
+            }
+            return true;
+        case PF_A2B10G10R10:
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const uint32 Texel = ((const uint32*)Src)[X];
+                Dst[X] = FColor((uint8)((Texel & 0x3FF) >> 2), (uint8)(((Texel >> 10) & 0x3FF) >> 2), (uint8)(((Texel >> 20) & 0x3FF) >> 2), 255);
+            }
+            return true;
+        case PF_FloatRGBA:
+            for (int32 X = 0; X < Width; ++X)
+            {
+                // Viewport targets are already display-encoded, so no sRGB conversion here
+                Dst[X] = FLinearColor(((const FFloat16Color*)Src)[X]).ToFColor(false);
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Requests keep a raw FViewport for frames; Slate may have closed it since
+    bool IsViewportAlive(const FViewport* Viewport)
+    {
+        if (GEditor)
+        {
+            for (const FEditorViewportClient* Client : GEditor->GetAllViewportClients())
+            {
+                if (Client && Client->Viewport == Viewport)
+                {
+                    return true;
+                }
+            }
+        }
+        return GEngine && GEngine->GameViewport && GEngine->GameViewport->Viewport == Viewport;
+    }
+}
+
+FUnrealMCPViewportReadback& FUnrealMCPViewportReadback::Get()
+{
+    static FUnrealMCPViewportReadback Instance;
+    return Instance;
+}
+
+bool FUnrealMCPViewportReadback::IsAsyncSupported()
+{
+    return !GUsingNullRHI && FApp::CanEverRender();
+}
+
+bool FUnrealMCPViewportReadback::HasFreeSlot() const
+{
+    if (!IsAsyncSupported())
+    {
+        return true;
+    }
+    return Pending.Num() == 0 && Algo::AnyOf(Slots, [](const FSlot& Slot) { return Slot.State == ESlotState::Free; });
+}
+
+void FUnrealMCPViewportReadback::Capture(FViewport* Viewport, bool bAllowAsync, FUnrealMCPReadbackCompletion OnComplete)
+{
+    check(IsInGameThread());
+
+    if (!Viewport)
+    {
+        FUnrealMCPViewportPixels Result;
+        Result.Error = TEXT("No viewport to capture");
+        OnComplete(MoveTemp(Result));
+        return;
+    }
+
+    if (!bAllowAsync || !IsAsyncSupported())
+    {
+        OnComplete(ReadSynchronously(Viewport));
+        return;
+    }
+
+    FRequest& Request = Pending.AddDefaulted_GetRef();
+    Request.Viewport = Viewport;
+    Request.Size = Viewport->GetSizeXY();
+    Request.OnComplete = MoveTemp(OnComplete);
+    Request.StartFrame = GFrameCounter;
+
+    StartPending();
+}
+
+void FUnrealMCPViewportReadback::Shutdown()
+{
+    check(IsInGameThread());
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    // Render commands still reference the staging textures
+    FlushRenderingCommands();
+
+    TArray<FUnrealMCPReadbackCompletion> Abandoned;
+    for (FSlot& Slot : Slots)
+    {
+        if (Slot.State != ESlotState::Free)
+        {
+            Abandoned.Add(MoveTemp(Slot.Request.OnComplete));
+        }
+        Slot = FSlot();
+    }
+    for (FRequest& Request : Pending)
+    {
+        Abandoned.Add(MoveTemp(Request.OnComplete));
+    }
+    Pending.Empty();
+
+    for (FUnrealMCPReadbackCompletion& OnComplete : Abandoned)
+    {
+        FUnrealMCPViewportPixels Result;
+        Result.Error = TEXT("Viewport readback was shut down");
+        OnComplete(MoveTemp(Result));
+    }
+}
+
+void FUnrealMCPViewportReadback::StartPending()
+{
+    for (int32 SlotIndex = 0; SlotIndex < NumSlots && Pending.Num() > 0; ++SlotIndex)
+    {
+        if (Slots[SlotIndex].State == ESlotState::Free)
+        {
+            Slots[SlotIndex].Request = MoveTemp(Pending[0]);
+            Pending.RemoveAt(0);
+            StartCopy(SlotIndex);
+        }
+    }
+
+    if (!TickerHandle.IsValid() && (Pending.Num() > 0 || Algo::AnyOf(Slots, [](const FSlot& Slot) { return Slot.State != ESlotState::Free; })))
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUnrealMCPViewportReadback::Tick));
+    }
+}
+
+void FUnrealMCPViewportReadback::StartCopy(int32 SlotIndex)
+{
+    FSlot& Slot = Slots[SlotIndex];
+    if (!Slot.Readback.IsValid())
+    {
+        Slot.Readback = MakeUnique<FRHIGPUTextureReadback>(*FString::Printf(TEXT("UnrealMCPViewportReadback%d"), SlotIndex));
+    }
+
+    Slot.State = ESlotState::Copying;
+    Slot.StartTime = FPlatformTime::Seconds();
+    Slot.Copy = MakeShared<FCopyState, ESPMode::ThreadSafe>();
+
+    // Recorded behind whatever the viewport has already queued, so no flush is needed
+    ENQUEUE_RENDER_COMMAND(UnrealMCPEnqueueViewportReadback)(
+        [Readback = Slot.Readback.Get(), Viewport = Slot.Request.Viewport, Copy = Slot.Copy](FRHICommandListImmediate& RHICmdList)
+        {
+            FRHITexture* Texture = Viewport->GetRenderTargetTexture();
+            if (Texture)
+            {
+                RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::Unknown, ERHIAccess::CopySrc));
+                Readback->EnqueueCopy(RHICmdList, Texture);
+                // Slate samples viewport targets, so hand it back as a shader resource
+                RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::CopySrc, ERHIAccess::SRVMask));
+
+                Copy->Format = Texture->GetFormat();
+                Copy->bHasSource = true;
+            }
+            Copy->bEnqueued = true;
+        });
+}
+
+bool FUnrealMCPViewportReadback::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+    {
+        FSlot& Slot = Slots[SlotIndex];
+        if (Slot.State != ESlotState::Copying)
+        {
+            continue;
+        }
+
+        if (Slot.Copy->bEnqueued && (!Slot.Copy->bHasSource || Slot.Readback->IsReady()))
+        {
+            Resolve(SlotIndex);
+        }
+        else if (Now - Slot.StartTime > ReadbackTimeoutSeconds)
+        {
+            // Drop the staging texture rather than reuse one with a copy still pending. The copy
+            // command may not have run yet, so the texture is freed behind it on the render thread.
+            UE_LOG(LogTemp, Warning, TEXT("UnrealMCP: Viewport readback timed out, falling back to ReadPixels"));
+            FUnrealMCPViewportPixels Result = ReadSynchronously(Slot.Request.Viewport);
+            ENQUEUE_RENDER_COMMAND(UnrealMCPReleaseViewportReadback)(
+                [Readback = MoveTemp(Slot.Readback)](FRHICommandListImmediate& RHICmdList) mutable
+                {
+                    Readback.Reset();
+                });
+            Complete(SlotIndex, Slot.Copy, MoveTemp(Result));
+        }
+    }
+
+    StartPending();
+
+    const bool bBusy = Pending.Num() > 0 || Algo::AnyOf(Slots, [](const FSlot& Slot) { return Slot.State != ESlotState::Free; });
+    if (!bBusy)
+    {
+        TickerHandle.Reset();
+    }
+    return bBusy;
+}
+
+void FUnrealMCPViewportReadback::Resolve(int32 SlotIndex)
+{
+    FSlot& Slot = Slots[SlotIndex];
+    Slot.State = ESlotState::Resolving;
+
+    // Staging textures can only be mapped on the render thread
+    ENQUEUE_RENDER_COMMAND(UnrealMCPResolveViewportReadback)(
+        [this, SlotIndex, Readback = Slot.Readback.Get(), Copy = Slot.Copy, Size = Slot.Request.Size](FRHICommandListImmediate& RHICmdList)
+        {
+            FUnrealMCPViewportPixels Result;
+            Result.bAsync = true;
+
+            if (!Copy->bHasSource)
+            {
+                Result.Error = TEXT("Viewport has no render target");
+            }
+            else
+            {
+                int32 RowPitchInPixels = 0;
+                int32 BufferHeight = 0;
+                const uint8* Data = (const uint8*)Readback->Lock(RowPitchInPixels, &BufferHeight);
+                if (!Data)
+                {
+                    Result.Error = TEXT("Failed to map the readback texture");
+                }
+                else
+                {
+                    const int32 BytesPerPixel = GPixelFormats[Copy->Format].BlockBytes;
+                    Result.Width = FMath::Min(Size.X, RowPitchInPixels);
+                    Result.Height = BufferHeight > 0 ? FMath::Min(Size.Y, BufferHeight) : Size.Y;
+                    Result.Pixels.SetNumUninitialized(Result.Width * Result.Height);
+
+                    Result.bSuccess = true;
+                    for (int32 Y = 0; Y < Result.Height && Result.bSuccess; ++Y)
+                    {
+                        Result.bSuccess = ConvertRow(Copy->Format, Data + (int64)Y * RowPitchInPixels * BytesPerPixel, Result.Pixels.GetData() + (int64)Y * Result.Width, Result.Width);
+                    }
+                    Readback->Unlock();
+
+                    if (!Result.bSuccess)
+                    {
+                        Result.Pixels.Empty();
+                        Result.Error = FString::Printf(TEXT("Unsupported viewport pixel format %s"), GPixelFormats[Copy->Format].Name);
+                    }
+                }
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [this, SlotIndex, Copy, Result = MoveTemp(Result)]() mutable
+            {
+                Complete(SlotIndex, Copy, MoveTemp(Result));
+            });
+        });
+}
+
+void FUnrealMCPViewportReadback::Complete(int32 SlotIndex, const TSharedPtr<FCopyState, ESPMode::ThreadSafe>& Copy, FUnrealMCPViewportPixels&& Result)
+{
+    FSlot& Slot = Slots[SlotIndex];
+
+    // The slot was shut down or timed out and reused since this copy started
+    if (Slot.State == ESlotState::Free || Slot.Copy != Copy)
+    {
+        return;
+    }
+
+    // Formats we can't convert still get an image, just the slow way
+    if (!Result.bSuccess && Copy->bHasSource)
+    {
+        Result = ReadSynchronously(Slot.Request.Viewport);
+    }
+
+    Result.Frames = GFrameCounter - Slot.Request.StartFrame;
+
+    FUnrealMCPReadbackCompletion OnComplete = MoveTemp(Slot.Request.OnComplete);
+    Slot.Request = FRequest();
+    Slot.Copy.Reset();
+    Slot.State = ESlotState::Free;
+
+    OnComplete(MoveTemp(Result));
+    StartPending();
+}
+
+FUnrealMCPViewportPixels FUnrealMCPViewportReadback::ReadSynchronously(FViewport* Viewport)
+{
+    FUnrealMCPViewportPixels Result;
+    if (!IsViewportAlive(Viewport))
+    {
+        Result.Error = TEXT("The viewport was closed during the capture");
+        return Result;
+    }
+
+    const FIntPoint Size = Viewport->GetSizeXY();
+    if (Viewport->ReadPixels(Result.Pixels, FReadSurfaceDataFlags(), FIntRect(0, 0, Size.X, Size.Y)))
+    {
+        Result.bSuccess = true;
+        Result.Width = Size.X;
+        Result.Height = Size.Y;
+    }
+    else
+    {
+        Result.Error = TEXT("Failed to read viewport pixels");
+    }
+    return Result;
+}
@@ -0,0 +1,169 @@
+#include "Commands/UnrealMCPWorldResolver.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+FUnrealMCPWorldResolver& FUnrealMCPWorldResolver::Get()
+{
+    static FUnrealMCPWorldResolver Instance;
+    return Instance;
+}
+
+bool FUnrealMCPWorldResolver::ParseTarget(const FString& Name, EUnrealMCPWorldTarget& OutTarget)
+{
+    for (int32 Index = 0; Index < (int32)EUnrealMCPWorldTarget::Count; ++Index)
+    {
+        if (Name.Equals(TargetToString((EUnrealMCPWorldTarget)Index), ESearchCase::IgnoreCase))
+        {
+            OutTarget = (EUnrealMCPWorldTarget)Index;
+            return true;
+        }
+    }
+    return false;
+}
+
+const TCHAR* FUnrealMCPWorldResolver::TargetToString(EUnrealMCPWorldTarget Target)
+{
+    switch (Target)
+    {
+    case EUnrealMCPWorldTarget::Editor:
+        return TEXT("editor");
+    case EUnrealMCPWorldTarget::PIE:
+        return TEXT("pie");
+    case EUnrealMCPWorldTarget::Game:
+        return TEXT("game");
+    default:
+        return TEXT("auto");
+    }
+}
+
+UWorld* FUnrealMCPWorldResolver::Resolve()
+{
+    return Resolve(Pinned);
+}
+
+UWorld* FUnrealMCPWorldResolver::Resolve(EUnrealMCPWorldTarget Target)
+{
+    check(IsInGameThread());
+    BindDelegates();
+
+    TWeakObjectPtr<UWorld>& Slot = Cached[(int32)Target];
+    UWorld* World = Slot.Get();
+    if (!IsValid(World))
+    {
+        World = FindWorld(Target);
+        Slot = World;
+    }
+    return World;
+}
+
+void FUnrealMCPWorldResolver::Invalidate()
+{
+    for (TWeakObjectPtr<UWorld>& Slot : Cached)
+    {
+        Slot.Reset();
+    }
+}
+
+void FUnrealMCPWorldResolver::Shutdown()
+{
+    if (bBound)
+    {
+        FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedHandle);
+        FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+        FEditorDelegates::OnMapOpened.Remove(MapOpenedHandle);
+        FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+        bBound = false;
+    }
+    Invalidate();
+}
+
+void FUnrealMCPWorldResolver::BindDelegates()
+{
+    if (bBound)
+    {
+        return;
+    }
+    bBound = true;
+
+    PostPIEStartedHandle = FEditorDelegates::PostPIEStarted.AddRaw(this, &FUnrealMCPWorldResolver::HandlePIEEvent);
+    EndPIEHandle = FEditorDelegates::EndPIE.AddRaw(this, &FUnrealMCPWorldResolver::HandlePIEEvent);
+    MapOpenedHandle = FEditorDelegates::OnMapOpened.AddRaw(this, &FUnrealMCPWorldResolver::HandleMapOpened);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FUnrealMCPWorldResolver::HandleWorldCleanup);
+}
+
+UWorld* FUnrealMCPWorldResolver::FindWorld(EUnrealMCPWorldTarget Target)
+{
+    if (!GEngine)
+    {
+        return nullptr;
+    }
+
+    if (Target == EUnrealMCPWorldTarget::Auto)
+    {
+        for (EUnrealMCPWorldTarget Candidate : { EUnrealMCPWorldTarget::PIE, EUnrealMCPWorldTarget::Game, EUnrealMCPWorldTarget::Editor })
+        {
+            if (UWorld* World = FindWorld(Candidate))
+            {
+                return World;
+            }
+        }
+        return nullptr;
+    }
+
+    if (Target == EUnrealMCPWorldTarget::Editor)
+    {
+        return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    }
+
+    // With several PIE clients the first (normally the listen server) is the stable choice
+    const EWorldType::Type WorldType = Target == EUnrealMCPWorldTarget::PIE ? EWorldType::PIE : EWorldType::Game;
+    UWorld* Best = nullptr;
+    int32 BestInstance = MAX_int32;
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        UWorld* World = Context.World();
+        if (Context.WorldType == WorldType && IsValid(World) && Context.PIEInstance < BestInstance)
+        {
+            Best = World;
+            BestInstance = Context.PIEInstance;
+        }
+    }
+    return Best;
+}
+
+void FUnrealMCPWorldResolver::HandlePIEEvent(bool bIsSimulating)
+{
+    Invalidate();
+}
+
+void FUnrealMCPWorldResolver::HandleMapOpened(const FString& Filename, bool bAsTemplate)
+{
+    Invalidate();
+}
+
+void FUnrealMCPWorldResolver::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    for (TWeakObjectPtr<UWorld>& Slot : Cached)
+    {
+        if (Slot.Get() == World)
+        {
+            // Auto may fall back to another world now, so don't keep any stale answer
+            Invalidate();
+            return;
+        }
+    }
+}
+
+FUnrealMCPWorldResolver::FScopedPin::FScopedPin(EUnrealMCPWorldTarget Target)
+{
+    check(IsInGameThread());
+    FUnrealMCPWorldResolver& Resolver = FUnrealMCPWorldResolver::Get();
+    Previous = Resolver.Pinned;
+    Resolver.Pinned = Target;
+}
+
+FUnrealMCPWorldResolver::FScopedPin::~FScopedPin()
+{
+    FUnrealMCPWorldResolver::Get().Pinned = Previous;
+}
@@ -0,0 +1,35 @@
+#include "MCPBufferPool.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    FCriticalSection PoolLock;
+    TArray<TArray<uint8>> FreeBuffers;
+}
+
+TArray<uint8> FMCPBufferPool::Acquire()
+{
+    FScopeLock Lock(&PoolLock);
+    if (FreeBuffers.Num() == 0)
+    {
+        return TArray<uint8>();
+    }
+    return FreeBuffers.Pop(EAllowShrinking::No);
+}
+
+void FMCPBufferPool::Release(TArray<uint8>&& Buffer)
+{
+    if (Buffer.Max() == 0 || Buffer.Max() > MaxRetainedSize)
+    {
+        return;
+    }
+
+    TArray<uint8> Released = MoveTemp(Buffer);
+    Released.Reset();
+
+    FScopeLock Lock(&PoolLock);
+    if (FreeBuffers.Num() < MaxPooledBuffers)
+    {
+        FreeBuffers.Add(MoveTemp(Released));
+    }
+}
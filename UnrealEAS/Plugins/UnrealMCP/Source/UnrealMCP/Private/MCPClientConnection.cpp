@@ -0,0 +1,913 @@
+#include "MCPClientConnection.h"
+#include "UnrealMCPBridge.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "Commands/UnrealMCPJsonWriter.h"
+#include "Commands/UnrealMCPCbor.h"
+#include "MCPTransport.h"
+#include "MCPBufferPool.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+
+// Minimum and maximum size of a single socket read
+static const int32 ClientBufferSize = 8192;
+static const uint32 MaxReadSize = 1024 * 1024;
+
+// How long a readiness wait may block before re-checking the stop flag.
+// This is an upper bound on shutdown latency, not a polling interval: the wait
+// returns as soon as data arrives.
+static const FTimespan ClientWaitTimeout = FTimespan::FromMilliseconds(250);
+
+// Pipelined requests a single client may have outstanding before we stop reading from it
+static const int32 MaxInFlightRequests = 64;
+
+// A client whose socket takes no bytes for this long is dropped rather than holding the send lock forever
+static const double SendStallTimeoutSeconds = 30.0;
+
+/**
+ * Sends one request's progress messages and final response in the order they were
+ * produced. Writes never happen on the game thread; a background task drains the queue.
+ */
+class FMCPRequestOutbox : public TSharedFromThis<FMCPRequestOutbox, ESPMode::ThreadSafe>
+{
+public:
+    explicit FMCPRequestOutbox(const TSharedRef<FMCPResponseChannel, ESPMode::ThreadSafe>& InChannel)
+        : Channel(InChannel)
+        , bDraining(false)
+    {
+    }
+
+    /** The final message also ends the request on the channel. Returns false once the connection has closed. */
+    bool Post(TArray<uint8> Message, TArray<FUnrealMCPAttachment> Attachments, bool bFinal)
+    {
+        return Enqueue({ MoveTemp(Message), nullptr, MoveTemp(Attachments), bFinal });
+    }
+
+    /** A progress message, encoded only when it is sent since the client may switch encodings meanwhile. */
+    bool PostProgress(FMCPProgressEncoder Encode, TArray<FUnrealMCPAttachment> Attachments)
+    {
+        return Enqueue({ TArray<uint8>(), MoveTemp(Encode), MoveTemp(Attachments), false });
+    }
+
+    bool IsOpen() const
+    {
+        return Channel->IsOpen();
+    }
+
+private:
+    struct FMessage
+    {
+        TArray<uint8> Payload;
+        FMCPProgressEncoder Encode;
+        TArray<FUnrealMCPAttachment> Attachments;
+        bool bFinal = false;
+    };
+
+    bool Enqueue(FMessage&& NewMessage)
+    {
+        {
+            FScopeLock Lock(&QueueLock);
+            Queue.Add(MoveTemp(NewMessage));
+            if (bDraining)
+            {
+                return Channel->IsOpen();
+            }
+            bDraining = true;
+        }
+
+        if (!IsInGameThread())
+        {
+            Drain();
+            return Channel->IsOpen();
+        }
+
+        // Never block the game thread on a socket write
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Outbox = AsShared()]()
+        {
+            Outbox->Drain();
+        });
+        return Channel->IsOpen();
+    }
+
+    void Drain()
+    {
+        for (;;)
+        {
+            FMessage Message;
+            {
+                FScopeLock Lock(&QueueLock);
+                if (Queue.Num() == 0)
+                {
+                    bDraining = false;
+                    return;
+                }
+                Message = MoveTemp(Queue[0]);
+                Queue.RemoveAt(0);
+            }
+
+            if (Message.Encode)
+            {
+                Channel->Send(Message.Encode, Message.Attachments);
+            }
+            else
+            {
+                Channel->Send(Message.Payload, Message.Attachments);
+                FMCPBufferPool::Release(MoveTemp(Message.Payload));
+            }
+            if (Message.bFinal)
+            {
+                Channel->EndRequest();
+            }
+        }
+    }
+
+    TSharedRef<FMCPResponseChannel, ESPMode::ThreadSafe> Channel;
+    FCriticalSection QueueLock;
+    TArray<FMessage> Queue;
+    bool bDraining;
+};
+
+FMCPResponseChannel::FMCPResponseChannel(IMCPStream* InStream)
+    : Stream(InStream)
+    , Mode(EMCPFramingMode::Json)
+    , Encoding(EMCPEncoding::Json)
+    , RingThreshold(FMCPSharedRing::DefaultThreshold)
+    , bOpen(true)
+    , CompletionEvent(FPlatformProcess::GetSynchEventFromPool(false))
+{
+}
+
+FMCPResponseChannel::~FMCPResponseChannel()
+{
+    FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
+    CompletionEvent = nullptr;
+}
+
+bool FMCPResponseChannel::Send(TConstArrayView<uint8> Response)
+{
+    return Send(Response, TArray<FUnrealMCPAttachment>());
+}
+
+bool FMCPResponseChannel::Send(TConstArrayView<uint8> Response, const TArray<FUnrealMCPAttachment>& Attachments)
+{
+    // The response and its attachments go out back to back so pipelined replies never interleave
+    FScopeLock Lock(&SendLock);
+    return bOpen && SendLocked(Response, Attachments);
+}
+
+bool FMCPResponseChannel::Send(TFunctionRef<TArray<uint8>(EMCPEncoding)> Encode, const TArray<FUnrealMCPAttachment>& Attachments)
+{
+    // Encoded under the lock so a set_framing can't switch encodings between encoding and sending
+    FScopeLock Lock(&SendLock);
+    if (!bOpen)
+    {
+        return false;
+    }
+    TArray<uint8> Response = Encode(Encoding);
+    const bool bSent = SendLocked(Response, Attachments);
+    FMCPBufferPool::Release(MoveTemp(Response));
+    return bSent;
+}
+
+bool FMCPResponseChannel::SendLocked(TConstArrayView<uint8> Response, const TArray<FUnrealMCPAttachment>& Attachments)
+{
+    // Refused before anything is written, so the stream stays in sync. The bridge already
+    // turns oversized results into errors; this only catches what slips past it.
+    if (Mode == EMCPFramingMode::LengthPrefixed)
+    {
+        bool bFits = (uint32)Response.Num() <= MCPFraming::MaxFrameLength || Compressor.ShouldCompress(Response.Num());
+        for (const FUnrealMCPAttachment& Attachment : Attachments)
+        {
+            bFits = bFits && Attachment.Data->Num() <= MCPFraming::MaxFrameLength;
+        }
+        if (!bFits)
+        {
+            UE_LOG(LogTemp, Error, TEXT("MCPResponseChannel: Dropping a response that doesn't fit in a frame (limit %u bytes)"), MCPFraming::MaxFrameLength);
+            return false;
+        }
+    }
+
+    bool bSent = true;
+    if (TrySendThroughRing(Response.GetData(), Response.Num(), bSent))
+    {
+        if (!bSent)
+        {
+            return false;
+        }
+    }
+    else if (Mode == EMCPFramingMode::LengthPrefixed && Compressor.ShouldCompress(Response.Num()))
+    {
+        // Each block is written as soon as it is compressed
+        bSent = Compressor.Compress(Response, [this](TConstArrayView<uint8> Block)
+        {
+            TConstArrayView64<uint8> Parts[] = { Block };
+            return SendParts(Parts);
+        });
+        if (!bSent)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // Header, payload and trailer go out in one gather write, straight from the serialized buffer
+        uint8 Header[MCPFraming::LengthHeaderSize];
+        TConstArrayView64<uint8> Parts[3];
+        int32 NumParts = 0;
+        if (Mode == EMCPFramingMode::LengthPrefixed)
+        {
+            MCPFraming::WriteLengthHeader((uint32)Response.Num(), Header);
+            Parts[NumParts++] = TConstArrayView64<uint8>(Header, MCPFraming::LengthHeaderSize);
+        }
+        Parts[NumParts++] = TConstArrayView64<uint8>(Response.GetData(), Response.Num());
+        if (Mode == EMCPFramingMode::Newline)
+        {
+            static const uint8 Newline = '\n';
+            Parts[NumParts++] = TConstArrayView64<uint8>(&Newline, 1);
+        }
+        if (!SendParts(TArrayView<TConstArrayView64<uint8>>(Parts, NumParts)))
+        {
+            return false;
+        }
+    }
+
+    for (const FUnrealMCPAttachment& Attachment : Attachments)
+    {
+        if (TrySendThroughRing(Attachment.Data->GetData(), Attachment.Data->Num(), bSent))
+        {
+            if (!bSent)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        // Attachment bytes are sent straight from the producer's buffer
+        uint8 Header[MCPFraming::LengthHeaderSize];
+        TConstArrayView64<uint8> Parts[2];
+        int32 NumParts = 0;
+        if (Mode == EMCPFramingMode::LengthPrefixed)
+        {
+            MCPFraming::WriteLengthHeader((uint32)Attachment.Data->Num(), Header);
+            Parts[NumParts++] = TConstArrayView64<uint8>(Header, MCPFraming::LengthHeaderSize);
+        }
+        Parts[NumParts++] = TConstArrayView64<uint8>(Attachment.Data->GetData(), Attachment.Data->Num());
+        if (!SendParts(TArrayView<TConstArrayView64<uint8>>(Parts, NumParts)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FMCPResponseChannel::SendParts(TArrayView<TConstArrayView64<uint8>> Parts)
+{
+    int32 First = 0;
+    double LastProgress = FPlatformTime::Seconds();
+    for (;;)
+    {
+        while (First < Parts.Num() && Parts[First].Num() == 0)
+        {
+            ++First;
+        }
+        if (First == Parts.Num())
+        {
+            return true;
+        }
+
+        int64 Offered = 0;
+        for (int32 Index = First; Index < Parts.Num(); ++Index)
+        {
+            Offered += Parts[Index].Num();
+        }
+
+        // Stream is null once Close has run; bOpen is cleared first so a waiting sender notices
+        int32 BytesSent = 0;
+        const EMCPStreamResult Result = bOpen && Stream ? Stream->SendGather(Parts.RightChop(First), BytesSent) : EMCPStreamResult::Closed;
+        if (Result == EMCPStreamResult::Ok && BytesSent > 0)
+        {
+            ++SendStats.Writes;
+            SendStats.BytesSent += BytesSent;
+            if (BytesSent < Offered)
+            {
+                ++SendStats.PartialWrites;
+            }
+
+            // Drop what went out from the front of the parts
+            int64 Remaining = BytesSent;
+            while (Remaining > 0)
+            {
+                const int64 Taken = FMath::Min<int64>(Remaining, Parts[First].Num());
+                Parts[First] = Parts[First].RightChop(Taken);
+                Remaining -= Taken;
+                if (Parts[First].Num() == 0)
+                {
+                    ++First;
+                }
+            }
+            LastProgress = FPlatformTime::Seconds();
+            continue;
+        }
+
+        if (Result == EMCPStreamResult::Ok || Result == EMCPStreamResult::Retry)
+        {
+            if (FPlatformTime::Seconds() - LastProgress < SendStallTimeoutSeconds)
+            {
+                ++SendStats.WouldBlockWaits;
+                Stream->WaitForWrite(ClientWaitTimeout);
+                continue;
+            }
+            UE_LOG(LogTemp, Warning, TEXT("MCPResponseChannel: Client took no data for %.0f seconds, dropping the connection"), SendStallTimeoutSeconds);
+        }
+        else if (Result == EMCPStreamResult::Error && bOpen)
+        {
+            UE_LOG(LogTemp, Display, TEXT("MCPResponseChannel: Send failed. Last error code: %d"), Stream->GetLastErrorCode());
+        }
+
+        // A partly written frame leaves the stream unreadable; nothing more can go out
+        bOpen = false;
+        return false;
+    }
+}
+
+bool FMCPResponseChannel::TrySendThroughRing(const uint8* Data, int64 Num, bool& bOutSent)
+{
+    uint64 Position = 0;
+    if (!Ring || Mode != EMCPFramingMode::LengthPrefixed || Num < RingThreshold || !Ring->TryWrite(Data, Num, Position))
+    {
+        return false;
+    }
+
+    uint8 Frame[4 + FMCPSharedRing::DescriptorSize];
+    const uint32 Header = (uint32)FMCPSharedRing::DescriptorSize | FMCPSharedRing::FrameFlag;
+    for (int32 Index = 0; Index < 4; ++Index)
+    {
+        Frame[Index] = (uint8)(Header >> (24 - Index * 8));
+    }
+    for (int32 Index = 0; Index < 8; ++Index)
+    {
+        Frame[4 + Index] = (uint8)(Position >> (56 - Index * 8));
+        Frame[12 + Index] = (uint8)((uint64)Num >> (56 - Index * 8));
+    }
+    TConstArrayView64<uint8> Parts[] = { TConstArrayView64<uint8>(Frame, sizeof(Frame)) };
+    bOutSent = SendParts(Parts);
+    return true;
+}
+
+void FMCPResponseChannel::Close()
+{
+    // Wake a sender waiting on a full socket without waiting for the send lock it holds;
+    // it sees the failure and bOpen cleared, and gives up. Stream only changes below.
+    if (bOpen.AtomicSet(false) && Stream)
+    {
+        Stream->Interrupt();
+    }
+    FScopeLock Lock(&SendLock);
+    Stream = nullptr;
+    Ring.Reset();
+}
+
+void FMCPResponseChannel::SetMode(EMCPFramingMode NewMode, EMCPEncoding NewEncoding)
+{
+    FScopeLock Lock(&SendLock);
+    Mode = NewMode;
+    Encoding = NewEncoding;
+}
+
+void FMCPResponseChannel::SetCompression(EMCPCompression NewCompression, int32 Threshold)
+{
+    FScopeLock Lock(&SendLock);
+    Compressor.Configure(NewCompression, Threshold);
+}
+
+void FMCPResponseChannel::GetCompression(EMCPCompression& OutCompression, int32& OutThreshold, FMCPCompressionStats& OutStats)
+{
+    FScopeLock Lock(&SendLock);
+    OutCompression = Compressor.GetCompression();
+    OutThreshold = Compressor.GetThreshold();
+    OutStats = Compressor.GetStats();
+}
+
+FMCPSendStats FMCPResponseChannel::GetSendStats()
+{
+    FScopeLock Lock(&SendLock);
+    return SendStats;
+}
+
+void FMCPResponseChannel::SetSharedRing(TUniquePtr<FMCPSharedRing> NewRing, int32 Threshold)
+{
+    FScopeLock Lock(&SendLock);
+    Ring = MoveTemp(NewRing);
+    RingThreshold = Threshold;
+}
+
+void FMCPResponseChannel::VisitSharedRing(TFunctionRef<void(const FMCPSharedRing*, int32)> Visitor)
+{
+    FScopeLock Lock(&SendLock);
+    Visitor(Ring.Get(), RingThreshold);
+}
+
+void FMCPResponseChannel::BeginRequest()
+{
+    InFlight.Increment();
+}
+
+void FMCPResponseChannel::EndRequest()
+{
+    InFlight.Decrement();
+    CompletionEvent->Trigger();
+}
+
+void FMCPResponseChannel::WaitForCompletion(const FTimespan& Timeout)
+{
+    CompletionEvent->Wait(Timeout);
+}
+
+FMCPClientConnection::FMCPClientConnection(UUnrealMCPBridge* InBridge, TUniquePtr<IMCPStream> InStream, int32 InClientId)
+    : Bridge(InBridge)
+    , Stream(MoveTemp(InStream))
+    , Thread(nullptr)
+    , ClientId(InClientId)
+    , Channel(MakeShared<FMCPResponseChannel, ESPMode::ThreadSafe>(Stream.Get()))
+    , Encoding(EMCPEncoding::Json)
+    , RingCount(0)
+    , bRunning(true)
+    , bFinished(false)
+{
+}
+
+FMCPClientConnection::~FMCPClientConnection()
+{
+    Stop();
+
+    if (Thread)
+    {
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    // Requests still running after a forced stop will find the channel closed
+    Channel->Close();
+
+    Stream.Reset();
+}
+
+bool FMCPClientConnection::Start()
+{
+    const FString ThreadName = FString::Printf(TEXT("UnrealMCPClient_%d"), ClientId);
+    Thread = FRunnableThread::Create(this, *ThreadName, 0, TPri_Normal);
+    if (!Thread)
+    {
+        bFinished = true;
+        return false;
+    }
+    return true;
+}
+
+bool FMCPClientConnection::Init()
+{
+    // Streams come up non-blocking: Recv is only called once WaitForRead reports data, and
+    // the channel finishes short writes itself, dropping a client that stalls for too long.
+    return true;
+}
+
+uint32 FMCPClientConnection::Run()
+{
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client connected"), ClientId);
+
+    // Once a send gives up the client can't hear back, so nothing more is read or run
+    while (bRunning && Channel->IsOpen())
+    {
+        if (!Stream->WaitForRead(ClientWaitTimeout))
+        {
+            if (!Stream->IsConnected())
+            {
+                UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Connection lost"), ClientId);
+                break;
+            }
+            continue;
+        }
+
+        // Read whatever is queued (at least one chunk) straight into the decoder
+        const uint32 PendingSize = Stream->GetPendingBytes();
+        const int32 ReadSize = FMath::Max<int32>(ClientBufferSize, (int32)FMath::Min<uint32>(PendingSize, MaxReadSize));
+
+        int32 BytesRead = 0;
+        const EMCPStreamResult Result = Stream->Recv(Decoder.GetWriteBuffer(ReadSize), ReadSize, BytesRead);
+        if (Result == EMCPStreamResult::Retry)
+        {
+            continue;
+        }
+        if (Result == EMCPStreamResult::Error)
+        {
+            UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client disconnected. Last error code: %d"), ClientId, Stream->GetLastErrorCode());
+            break;
+        }
+        if (Result == EMCPStreamResult::Closed)
+        {
+            UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client disconnected (zero bytes)"), ClientId);
+            break;
+        }
+        Decoder.CommitWrite(BytesRead);
+
+        // A single read may carry several messages, or only part of one
+        TConstArrayView<uint8> Message;
+        while (bRunning && Channel->IsOpen() && Decoder.NextMessageView(Message))
+        {
+            ProcessMessage(Message);
+        }
+
+        if (Decoder.HasError())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Protocol error: %s"), ClientId, *Decoder.GetError());
+            SendError(Decoder.GetError());
+            break;
+        }
+    }
+
+    if (bRunning && !Channel->IsOpen())
+    {
+        UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Responses can no longer be sent, closing"), ClientId);
+    }
+
+    // Stop reading, but let requests that are already queued finish and reply
+    WaitForInFlight(0);
+    bFinished = true;
+    return 0;
+}
+
+void FMCPClientConnection::Stop()
+{
+    bRunning = false;
+}
+
+void FMCPClientConnection::Exit()
+{
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Connection closed"), ClientId);
+}
+
+void FMCPClientConnection::WaitForInFlight(int32 MaxInFlight)
+{
+    while (bRunning && Channel->GetInFlight() > MaxInFlight)
+    {
+        Channel->WaitForCompletion(ClientWaitTimeout);
+    }
+}
+
+void FMCPClientConnection::ProcessMessage(TConstArrayView<uint8> Message)
+{
+    TSharedPtr<FJsonObject> JsonMessage;
+    if (Encoding == EMCPEncoding::Cbor)
+    {
+        FString CborError;
+        if (!FUnrealMCPCborReader::ReadObject(Message, JsonMessage, CborError))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Failed to parse CBOR message (%d bytes): %s"), ClientId, Message.Num(), *CborError);
+            SendError(FString::Printf(TEXT("Failed to parse CBOR message: %s"), *CborError));
+            return;
+        }
+    }
+    else
+    {
+        FUTF8ToTCHAR Converted((const ANSICHAR*)Message.GetData(), Message.Num());
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+        if (!FJsonSerializer::Deserialize(Reader, JsonMessage) || !JsonMessage.IsValid())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Failed to parse JSON message (%d bytes)"), ClientId, Message.Num());
+            SendError(TEXT("Failed to parse JSON message"));
+            return;
+        }
+    }
+
+    // Optional client-chosen id (string or number), echoed back in the response
+    TSharedPtr<FJsonValue> RequestId = JsonMessage->TryGetField(TEXT("id"));
+    if (RequestId.IsValid() && RequestId->Type != EJson::String && RequestId->Type != EJson::Number)
+    {
+        RequestId.Reset();
+    }
+
+    // Accept both the Unity-style {"type": ...} and MCP-style {"command": ...} shapes
+    FString CommandType;
+    if (!JsonMessage->TryGetStringField(TEXT("type"), CommandType) &&
+        !JsonMessage->TryGetStringField(TEXT("command"), CommandType))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Missing 'type' field in command"), ClientId);
+        SendError(TEXT("Missing 'type' or 'command' field"), RequestId);
+        return;
+    }
+
+    // Parameters are optional
+    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (JsonMessage->TryGetObjectField(TEXT("params"), ParamsObject))
+    {
+        Params = *ParamsObject;
+    }
+
+    if (CommandType == TEXT("set_framing"))
+    {
+        // Responses still in flight must go out in the framing they were requested with
+        WaitForInFlight(0);
+        HandleSetFraming(Params, RequestId);
+        return;
+    }
+    if (CommandType == TEXT("get_connection_stats"))
+    {
+        HandleGetConnectionStats(RequestId);
+        return;
+    }
+    if (CommandType == TEXT("open_shared_ring") || CommandType == TEXT("close_shared_ring"))
+    {
+        // Payloads already in flight must reach the client before its ring changes
+        WaitForInFlight(0);
+        if (CommandType == TEXT("open_shared_ring"))
+        {
+            HandleOpenSharedRing(Params, RequestId);
+        }
+        else
+        {
+            HandleCloseSharedRing(RequestId);
+        }
+        return;
+    }
+
+    const bool bPipelined = RequestId.IsValid();
+    if (bPipelined && !Bridge->IsReadOnlyCommand(CommandType))
+    {
+        // Mutations are a barrier: they start only after every earlier request has replied
+        WaitForInFlight(0);
+    }
+    else
+    {
+        // Bound the pipeline depth; the socket is not read again until a slot frees up
+        WaitForInFlight(MaxInFlightRequests - 1);
+    }
+
+    if (!bRunning)
+    {
+        return;
+    }
+
+    Channel->BeginRequest();
+    TSharedRef<FMCPRequestOutbox, ESPMode::ThreadSafe> Outbox = MakeShared<FMCPRequestOutbox, ESPMode::ThreadSafe>(Channel.ToSharedRef());
+
+    // Only clients that match replies by id can tell progress messages from the final response
+    TFunction<bool(FMCPProgressEncoder, TArray<FUnrealMCPAttachment>)> OnProgress;
+    if (bPipelined)
+    {
+        OnProgress = [Outbox](FMCPProgressEncoder Encode, TArray<FUnrealMCPAttachment> Attachments)
+        {
+            return Encode ? Outbox->PostProgress(MoveTemp(Encode), MoveTemp(Attachments)) : Outbox->IsOpen();
+        };
+    }
+
+    Bridge->ExecuteCommandAsync(CommandType, Params, RequestId, [Outbox](TArray<uint8> Response, TArray<FUnrealMCPAttachment> Attachments)
+    {
+        Outbox->Post(MoveTemp(Response), MoveTemp(Attachments), true);
+    }, MoveTemp(OnProgress), Encoding, ClientId);
+
+    if (!bPipelined)
+    {
+        // Clients that don't send ids expect exactly one reply per request, in order
+        WaitForInFlight(0);
+    }
+}
+
+void FMCPClientConnection::HandleSetFraming(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId)
+{
+    FString ModeName;
+    EMCPFramingMode NewMode;
+    if (!Params->TryGetStringField(TEXT("mode"), ModeName) || !MCPFraming::ParseMode(ModeName, NewMode))
+    {
+        SendError(TEXT("set_framing requires 'mode' of 'json', 'newline' or 'length_prefixed'"), RequestId);
+        return;
+    }
+
+    // Encoding is optional and switches back to JSON when left out
+    FString EncodingName;
+    EMCPEncoding NewEncoding = EMCPEncoding::Json;
+    if (Params->TryGetStringField(TEXT("encoding"), EncodingName) && !MCPFraming::ParseEncoding(EncodingName, NewEncoding))
+    {
+        SendError(TEXT("set_framing 'encoding' must be 'json' or 'cbor'"), RequestId);
+        return;
+    }
+    if (NewEncoding == EMCPEncoding::Cbor && NewMode != EMCPFramingMode::LengthPrefixed)
+    {
+        // Binary messages can't be delimited by scanning for brackets or newlines
+        SendError(TEXT("'cbor' encoding needs 'length_prefixed' framing"), RequestId);
+        return;
+    }
+
+    // Compression is optional too and turns off when left out
+    FString CompressionName;
+    EMCPCompression NewCompression = EMCPCompression::None;
+    if (Params->TryGetStringField(TEXT("compression"), CompressionName) && !MCPFraming::ParseCompression(CompressionName, NewCompression))
+    {
+        SendError(TEXT("set_framing 'compression' must be 'none', 'lz4' or 'zlib'"), RequestId);
+        return;
+    }
+    if (NewCompression != EMCPCompression::None && NewMode != EMCPFramingMode::LengthPrefixed)
+    {
+        SendError(TEXT("compression needs 'length_prefixed' framing"), RequestId);
+        return;
+    }
+    int32 Threshold = FMCPFrameCompressor::DefaultThreshold;
+    Params->TryGetNumberField(TEXT("compression_threshold"), Threshold);
+    Threshold = FMath::Max(0, Threshold);
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetStringField(TEXT("mode"), MCPFraming::ModeToString(NewMode));
+    ResultJson->SetStringField(TEXT("previous_mode"), MCPFraming::ModeToString(Decoder.GetMode()));
+    ResultJson->SetStringField(TEXT("encoding"), MCPFraming::EncodingToString(NewEncoding));
+    ResultJson->SetStringField(TEXT("previous_encoding"), MCPFraming::EncodingToString(Encoding));
+    ResultJson->SetStringField(TEXT("compression"), MCPFraming::CompressionToString(NewCompression));
+    if (NewCompression != EMCPCompression::None)
+    {
+        ResultJson->SetNumberField(TEXT("compression_threshold"), Threshold);
+        ResultJson->SetNumberField(TEXT("compression_block_size"), FMCPFrameCompressor::BlockSize);
+    }
+    SendResult(ResultJson, RequestId);
+
+    // Everything after the set_framing message, in both directions, uses the new mode and encoding
+    Decoder.SetMode(NewMode);
+    Channel->SetMode(NewMode, NewEncoding);
+    Channel->SetCompression(NewCompression, Threshold);
+    Encoding = NewEncoding;
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Framing set to %s, encoding %s, compression %s"), ClientId,
+           MCPFraming::ModeToString(NewMode), MCPFraming::EncodingToString(NewEncoding), MCPFraming::CompressionToString(NewCompression));
+}
+
+void FMCPClientConnection::HandleGetConnectionStats(const TSharedPtr<FJsonValue>& RequestId)
+{
+    EMCPCompression Compression;
+    int32 Threshold;
+    FMCPCompressionStats Stats;
+    Channel->GetCompression(Compression, Threshold, Stats);
+
+    TSharedPtr<FJsonObject> CompressionJson = MakeShared<FJsonObject>();
+    CompressionJson->SetStringField(TEXT("codec"), MCPFraming::CompressionToString(Compression));
+    CompressionJson->SetNumberField(TEXT("threshold"), Threshold);
+    CompressionJson->SetNumberField(TEXT("messages_compressed"), (double)Stats.MessagesCompressed);
+    CompressionJson->SetNumberField(TEXT("messages_below_threshold"), (double)Stats.MessagesBelowThreshold);
+    CompressionJson->SetNumberField(TEXT("blocks_stored"), (double)Stats.BlocksStored);
+    CompressionJson->SetNumberField(TEXT("bytes_in"), (double)Stats.BytesIn);
+    CompressionJson->SetNumberField(TEXT("bytes_out"), (double)Stats.BytesOut);
+    CompressionJson->SetNumberField(TEXT("ratio"), Stats.BytesOut > 0 ? (double)Stats.BytesIn / (double)Stats.BytesOut : 1.0);
+    CompressionJson->SetNumberField(TEXT("compress_ms"), Stats.CompressSeconds * 1000.0);
+    CompressionJson->SetNumberField(TEXT("mb_per_s"), Stats.CompressSeconds > 0.0 ? (double)Stats.BytesIn / (1024.0 * 1024.0) / Stats.CompressSeconds : 0.0);
+
+    const FMCPSendStats SendStats = Channel->GetSendStats();
+    TSharedPtr<FJsonObject> SendJson = MakeShared<FJsonObject>();
+    SendJson->SetNumberField(TEXT("writes"), (double)SendStats.Writes);
+    SendJson->SetNumberField(TEXT("partial_writes"), (double)SendStats.PartialWrites);
+    SendJson->SetNumberField(TEXT("would_block_waits"), (double)SendStats.WouldBlockWaits);
+    SendJson->SetNumberField(TEXT("bytes_sent"), (double)SendStats.BytesSent);
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetNumberField(TEXT("client_id"), ClientId);
+    ResultJson->SetStringField(TEXT("mode"), MCPFraming::ModeToString(Decoder.GetMode()));
+    ResultJson->SetStringField(TEXT("encoding"), MCPFraming::EncodingToString(Encoding));
+    ResultJson->SetNumberField(TEXT("in_flight"), Channel->GetInFlight());
+    ResultJson->SetObjectField(TEXT("compression"), CompressionJson);
+    ResultJson->SetObjectField(TEXT("send"), SendJson);
+
+    // Scheduler lanes are shared by every client; queued_for_client is this connection's part
+    const FMCPCommandScheduler& Scheduler = Bridge->GetScheduler();
+    TSharedPtr<FJsonObject> SchedulerJson = MakeShared<FJsonObject>();
+    for (int32 LaneIndex = 0; LaneIndex < FMCPCommandScheduler::NumLanes; ++LaneIndex)
+    {
+        const EMCPRequestLane Lane = (EMCPRequestLane)LaneIndex;
+        const FMCPSchedulerLaneStats LaneStats = Scheduler.GetLaneStats(Lane);
+        TSharedPtr<FJsonObject> LaneJson = MakeShared<FJsonObject>();
+        LaneJson->SetNumberField(TEXT("depth"), LaneStats.Depth);
+        LaneJson->SetNumberField(TEXT("max_depth"), LaneStats.MaxDepth);
+        LaneJson->SetNumberField(TEXT("capacity"), LaneStats.Capacity);
+        LaneJson->SetNumberField(TEXT("per_client_limit"), LaneStats.PerClientLimit);
+        LaneJson->SetNumberField(TEXT("queued_for_client"), Scheduler.GetClientDepth(Lane, ClientId));
+        LaneJson->SetNumberField(TEXT("admitted"), (double)LaneStats.Admitted);
+        LaneJson->SetNumberField(TEXT("rejected"), (double)LaneStats.Rejected);
+        LaneJson->SetNumberField(TEXT("dispatched"), (double)LaneStats.Dispatched);
+        LaneJson->SetNumberField(TEXT("wait_ms_avg"), LaneStats.AverageWaitMs);
+        LaneJson->SetNumberField(TEXT("wait_ms_p50"), LaneStats.P50WaitMs);
+        LaneJson->SetNumberField(TEXT("wait_ms_p95"), LaneStats.P95WaitMs);
+        LaneJson->SetNumberField(TEXT("wait_ms_max"), LaneStats.MaxWaitMs);
+        SchedulerJson->SetObjectField(FMCPCommandScheduler::LaneToString(Lane), LaneJson);
+    }
+    ResultJson->SetObjectField(TEXT("scheduler"), SchedulerJson);
+
+    Channel->VisitSharedRing([&ResultJson](const FMCPSharedRing* Ring, int32 Threshold)
+    {
+        if (Ring)
+        {
+            TSharedPtr<FJsonObject> RingJson = MakeShared<FJsonObject>();
+            RingJson->SetStringField(TEXT("name"), Ring->GetName());
+            RingJson->SetNumberField(TEXT("capacity"), (double)Ring->GetCapacity());
+            RingJson->SetNumberField(TEXT("threshold"), Threshold);
+            RingJson->SetNumberField(TEXT("writes"), (double)Ring->GetWrites());
+            RingJson->SetNumberField(TEXT("bytes_written"), (double)Ring->GetBytesWritten());
+            RingJson->SetNumberField(TEXT("fallbacks"), (double)Ring->GetFallbacks());
+            ResultJson->SetObjectField(TEXT("shared_ring"), RingJson);
+        }
+    });
+    SendResult(ResultJson, RequestId);
+}
+
+void FMCPClientConnection::HandleOpenSharedRing(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId)
+{
+    if (Decoder.GetMode() != EMCPFramingMode::LengthPrefixed)
+    {
+        // Descriptors are told apart from payloads by a flag in the length header
+        SendError(TEXT("open_shared_ring needs 'length_prefixed' framing"), RequestId);
+        return;
+    }
+
+    double Size = 64.0 * 1024 * 1024;
+    Params->TryGetNumberField(TEXT("size"), Size);
+    int32 Threshold = FMCPSharedRing::DefaultThreshold;
+    Params->TryGetNumberField(TEXT("threshold"), Threshold);
+
+    const FString Name = FString::Printf(TEXT("UnrealMCP_%u_ring_%d_%d"), FPlatformProcess::GetCurrentProcessId(), ClientId, ++RingCount);
+    FString Error;
+    TUniquePtr<FMCPSharedRing> Ring = FMCPSharedRing::Create(Name, (int64)Size, Error);
+    if (!Ring)
+    {
+        SendError(Error, RequestId);
+        return;
+    }
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetStringField(TEXT("name"), Name);
+    ResultJson->SetNumberField(TEXT("region_size"), (double)Ring->GetRegionSize());
+    ResultJson->SetNumberField(TEXT("header_size"), FMCPSharedRing::HeaderSize);
+    ResultJson->SetNumberField(TEXT("capacity"), (double)Ring->GetCapacity());
+    ResultJson->SetNumberField(TEXT("threshold"), FMath::Max(0, Threshold));
+
+    // The reply itself always goes over the socket; the ring is used from the next payload on
+    SendResult(ResultJson, RequestId);
+    Channel->SetSharedRing(MoveTemp(Ring), FMath::Max(0, Threshold));
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Shared ring %s opened (%lld bytes)"), ClientId, *Name, (int64)Size);
+}
+
+void FMCPClientConnection::HandleCloseSharedRing(const TSharedPtr<FJsonValue>& RequestId)
+{
+    bool bWasOpen = false;
+    Channel->VisitSharedRing([&bWasOpen](const FMCPSharedRing* Ring, int32 Threshold)
+    {
+        bWasOpen = Ring != nullptr;
+    });
+    Channel->SetSharedRing(nullptr, FMCPSharedRing::DefaultThreshold);
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetBoolField(TEXT("closed"), bWasOpen);
+    SendResult(ResultJson, RequestId);
+}
+
+bool FMCPClientConnection::SendError(const FString& ErrorMessage, const TSharedPtr<FJsonValue>& RequestId)
+{
+    TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+    if (RequestId.IsValid())
+    {
+        ResponseJson->SetField(TEXT("id"), RequestId);
+    }
+    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+    ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+    return SendObject(ResponseJson);
+}
+
+bool FMCPClientConnection::SendResult(const TSharedPtr<FJsonObject>& ResultJson, const TSharedPtr<FJsonValue>& RequestId)
+{
+    TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+    if (RequestId.IsValid())
+    {
+        ResponseJson->SetField(TEXT("id"), RequestId);
+    }
+    ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+    ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+    return SendObject(ResponseJson);
+}
+
+bool FMCPClientConnection::SendObject(const TSharedPtr<FJsonObject>& ResponseJson)
+{
+    TArray<uint8> Payload = FMCPBufferPool::Acquire();
+    if (Encoding == EMCPEncoding::Cbor)
+    {
+        FUnrealMCPCborWriter Writer(Payload);
+        Writer.WriteJsonObject(ResponseJson);
+    }
+    else
+    {
+        FUnrealMCPJsonWriter Writer(Payload);
+        Writer.WriteJsonObject(ResponseJson);
+    }
+    const bool bSent = Channel->Send(Payload);
+    FMCPBufferPool::Release(MoveTemp(Payload));
+    return bSent;
+}
@@ -0,0 +1,331 @@
+#include "MCPCommandScheduler.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    // Interactive reads are cheap and numerous; heavy commands each hold the game thread for a while
+    constexpr int32 LaneCapacity[FMCPCommandScheduler::NumLanes] = { 256, 64, 16 };
+
+    // No single client may fill more than this share of a lane
+    constexpr int32 ClientShareDivisor = 4;
+
+    // Bounds of the back-off suggested in a "busy" response
+    constexpr int32 MinRetryAfterMs = 50;
+    constexpr int32 MaxRetryAfterMs = 5000;
+}
+
+FMCPCommandScheduler::FMCPCommandScheduler()
+    : QueuedEntries(0)
+    , bPumpScheduled(false)
+    , bShutdown(false)
+{
+    for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+    {
+        Lanes[LaneIndex].Capacity = LaneCapacity[LaneIndex];
+        Lanes[LaneIndex].PerClientLimit = FMath::Max(1, LaneCapacity[LaneIndex] / ClientShareDivisor);
+    }
+}
+
+EMCPRequestLane FMCPCommandScheduler::LaneFor(const FUnrealMCPCommandInfo& Command)
+{
+    if (Command.Cost == EUnrealMCPCommandCost::High)
+    {
+        return EMCPRequestLane::Heavy;
+    }
+    return Command.IsReadOnly() ? EMCPRequestLane::Interactive : EMCPRequestLane::Mutation;
+}
+
+const TCHAR* FMCPCommandScheduler::LaneToString(EMCPRequestLane Lane)
+{
+    switch (Lane)
+    {
+    case EMCPRequestLane::Mutation:
+        return TEXT("mutation");
+    case EMCPRequestLane::Heavy:
+        return TEXT("heavy");
+    default:
+        return TEXT("interactive");
+    }
+}
+
+bool FMCPCommandScheduler::TryAdmit(EMCPRequestLane Lane, int32 ClientId, int32& OutRetryAfterMs)
+{
+    FScopeLock ScopeLock(&Lock);
+    FLane& LaneState = Lanes[(int32)Lane];
+
+    int32 ClientIndex = FindClient(ClientId);
+    const int32 ClientDepth = ClientIndex != INDEX_NONE ? Clients[ClientIndex].Depth[(int32)Lane] : 0;
+    if (bShutdown || LaneState.Depth >= LaneState.Capacity || ClientDepth >= LaneState.PerClientLimit)
+    {
+        ++LaneState.Rejected;
+        OutRetryAfterMs = FMath::Clamp((int32)(GetAverageWaitSeconds(LaneState) * 1000.0), MinRetryAfterMs, MaxRetryAfterMs);
+        return false;
+    }
+
+    if (ClientIndex == INDEX_NONE)
+    {
+        ClientIndex = Clients.AddDefaulted();
+        Clients[ClientIndex].ClientId = ClientId;
+    }
+    ++Clients[ClientIndex].Depth[(int32)Lane];
+    ++LaneState.Depth;
+    ++LaneState.Admitted;
+    LaneState.MaxDepth = FMath::Max(LaneState.MaxDepth, LaneState.Depth);
+    return true;
+}
+
+void FMCPCommandScheduler::Submit(EMCPRequestLane Lane, int32 ClientId, bool bReadOnly, FTask Task)
+{
+    FScopeLock ScopeLock(&Lock);
+    const int32 ClientIndex = FindClient(ClientId);
+    if (bShutdown || ClientIndex == INDEX_NONE)
+    {
+        // Shutdown already released every slot; the task only answers its request
+        ScopeLock.Unlock();
+        Task(false);
+        return;
+    }
+
+    FClientQueue& Client = Clients[ClientIndex];
+    FEntry& Entry = Client.Entries[(int32)Lane].AddDefaulted_GetRef();
+    Entry.Task = MoveTemp(Task);
+    Entry.Sequence = Client.NextSequence++;
+    Entry.EnqueueTime = FPlatformTime::Seconds();
+    Entry.bReadOnly = bReadOnly;
+    ++QueuedEntries;
+
+    SchedulePump(false);
+}
+
+void FMCPCommandScheduler::Shutdown()
+{
+    TArray<FClientQueue> Dropped;
+    {
+        FScopeLock ScopeLock(&Lock);
+        bShutdown = true;
+        Dropped = MoveTemp(Clients);
+        QueuedEntries = 0;
+        for (FLane& LaneState : Lanes)
+        {
+            LaneState.Depth = 0;
+            LaneState.Cursor = 0;
+        }
+    }
+    // Outside the lock, since completions may send or submit
+    for (FClientQueue& Client : Dropped)
+    {
+        for (TArray<FEntry>& Entries : Client.Entries)
+        {
+            for (FEntry& Entry : Entries)
+            {
+                Entry.Task(false);
+            }
+        }
+    }
+}
+
+void FMCPCommandScheduler::SchedulePump(bool bNextFrame)
+{
+    if (bPumpScheduled || bShutdown)
+    {
+        return;
+    }
+    bPumpScheduled = true;
+
+    TSharedRef<FMCPCommandScheduler, ESPMode::ThreadSafe> Self = AsShared();
+    if (bNextFrame)
+    {
+        // The budget is spent: let the editor tick before running more
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Self](float DeltaTime)
+        {
+            Self->Pump();
+            return false;
+        }));
+    }
+    else
+    {
+        AsyncTask(ENamedThreads::GameThread, [Self]()
+        {
+            Self->Pump();
+        });
+    }
+}
+
+void FMCPCommandScheduler::Pump()
+{
+    check(IsInGameThread());
+
+    auto RunNext = [this](EMCPRequestLane Lane)
+    {
+        FEntry Entry;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (bShutdown || !PopNext(Lane, Entry))
+            {
+                return false;
+            }
+        }
+        Entry.Task(true);
+        return true;
+    };
+
+    const double Start = FPlatformTime::Seconds();
+
+    // Every lane with work gets one turn, highest priority first, so heavy commands can't starve
+    for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+    {
+        RunNext((EMCPRequestLane)LaneIndex);
+    }
+
+    // The rest of the budget goes to interactive commands, then mutations
+    while (FPlatformTime::Seconds() - Start < PumpBudgetSeconds
+        && (RunNext(EMCPRequestLane::Interactive) || RunNext(EMCPRequestLane::Mutation)))
+    {
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    bPumpScheduled = false;
+    if (QueuedEntries > 0)
+    {
+        SchedulePump(true);
+    }
+}
+
+bool FMCPCommandScheduler::PopNext(EMCPRequestLane Lane, FEntry& OutEntry)
+{
+    FLane& LaneState = Lanes[(int32)Lane];
+    const int32 NumClients = Clients.Num();
+    for (int32 Offset = 0; Offset < NumClients; ++Offset)
+    {
+        const int32 ClientIndex = (LaneState.Cursor + Offset) % NumClients;
+        FClientQueue& Client = Clients[ClientIndex];
+        TArray<FEntry>& Entries = Client.Entries[(int32)Lane];
+        if (Entries.Num() == 0)
+        {
+            continue;
+        }
+
+        // A read waits for the client's earlier mutations, whichever lane they are in
+        bool bBlocked = false;
+        if (Entries[0].bReadOnly)
+        {
+            for (const TArray<FEntry>& Other : Client.Entries)
+            {
+                const FEntry* FirstMutation = Other.FindByPredicate([](const FEntry& Entry) { return !Entry.bReadOnly; });
+                if (FirstMutation && FirstMutation->Sequence < Entries[0].Sequence)
+                {
+                    bBlocked = true;
+                    break;
+                }
+            }
+        }
+        if (bBlocked)
+        {
+            continue;
+        }
+
+        OutEntry = MoveTemp(Entries[0]);
+        Entries.RemoveAt(0);
+        --QueuedEntries;
+
+        const double Wait = FPlatformTime::Seconds() - OutEntry.EnqueueTime;
+        LaneState.MaxWaitSeconds = FMath::Max(LaneState.MaxWaitSeconds, Wait);
+        if (LaneState.WaitSamples.Num() < WaitSampleCount)
+        {
+            LaneState.WaitSamples.Add((float)Wait);
+        }
+        else
+        {
+            LaneState.WaitSamples[LaneState.NextWaitSample] = (float)Wait;
+        }
+        LaneState.NextWaitSample = (LaneState.NextWaitSample + 1) % WaitSampleCount;
+        ++LaneState.Dispatched;
+
+        LaneState.Cursor = ClientIndex + 1;
+        ReleaseSlot(ClientIndex, Lane);
+        return true;
+    }
+    return false;
+}
+
+void FMCPCommandScheduler::ReleaseSlot(int32 ClientIndex, EMCPRequestLane Lane)
+{
+    FClientQueue& Client = Clients[ClientIndex];
+    --Client.Depth[(int32)Lane];
+    --Lanes[(int32)Lane].Depth;
+
+    for (int32 Depth : Client.Depth)
+    {
+        if (Depth > 0)
+        {
+            return;
+        }
+    }
+
+    // Idle clients leave the rotation; keep every lane's cursor on the same next client
+    Clients.RemoveAt(ClientIndex);
+    for (FLane& LaneState : Lanes)
+    {
+        if (LaneState.Cursor > ClientIndex)
+        {
+            --LaneState.Cursor;
+        }
+    }
+}
+
+int32 FMCPCommandScheduler::FindClient(int32 ClientId) const
+{
+    return Clients.IndexOfByPredicate([ClientId](const FClientQueue& Client) { return Client.ClientId == ClientId; });
+}
+
+double FMCPCommandScheduler::GetAverageWaitSeconds(const FLane& LaneState) const
+{
+    if (LaneState.WaitSamples.Num() == 0)
+    {
+        return 0.0;
+    }
+    double Total = 0.0;
+    for (float Sample : LaneState.WaitSamples)
+    {
+        Total += Sample;
+    }
+    return Total / LaneState.WaitSamples.Num();
+}
+
+FMCPSchedulerLaneStats FMCPCommandScheduler::GetLaneStats(EMCPRequestLane Lane) const
+{
+    TArray<float> Samples;
+    FMCPSchedulerLaneStats Stats;
+    {
+        FScopeLock ScopeLock(&Lock);
+        const FLane& LaneState = Lanes[(int32)Lane];
+        Stats.Depth = LaneState.Depth;
+        Stats.MaxDepth = LaneState.MaxDepth;
+        Stats.Capacity = LaneState.Capacity;
+        Stats.PerClientLimit = LaneState.PerClientLimit;
+        Stats.Admitted = LaneState.Admitted;
+        Stats.Rejected = LaneState.Rejected;
+        Stats.Dispatched = LaneState.Dispatched;
+        Stats.AverageWaitMs = GetAverageWaitSeconds(LaneState) * 1000.0;
+        Stats.MaxWaitMs = LaneState.MaxWaitSeconds * 1000.0;
+        Samples = LaneState.WaitSamples;
+    }
+
+    if (Samples.Num() > 0)
+    {
+        Samples.Sort();
+        Stats.P50WaitMs = Samples[(Samples.Num() - 1) / 2] * 1000.0;
+        Stats.P95WaitMs = Samples[(Samples.Num() - 1) * 95 / 100] * 1000.0;
+    }
+    return Stats;
+}
+
+int32 FMCPCommandScheduler::GetClientDepth(EMCPRequestLane Lane, int32 ClientId) const
+{
+    FScopeLock ScopeLock(&Lock);
+    const int32 ClientIndex = FindClient(ClientId);
+    return ClientIndex != INDEX_NONE ? Clients[ClientIndex].Depth[(int32)Lane] : 0;
+}
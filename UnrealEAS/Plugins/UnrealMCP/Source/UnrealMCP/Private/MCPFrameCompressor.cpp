@@ -0,0 +1,83 @@
+#include "MCPFrameCompressor.h"
+#include "Misc/Compression.h"
+
+static const int32 BlockHeaderSize = 8;
+
+static FName GetFormatName(EMCPCompression Compression)
+{
+    return Compression == EMCPCompression::Zlib ? NAME_Zlib : NAME_LZ4;
+}
+
+static void WriteBigEndian(uint8* Out, uint32 Value)
+{
+    Out[0] = (uint8)((Value >> 24) & 0xFF);
+    Out[1] = (uint8)((Value >> 16) & 0xFF);
+    Out[2] = (uint8)((Value >> 8) & 0xFF);
+    Out[3] = (uint8)(Value & 0xFF);
+}
+
+void FMCPFrameCompressor::Configure(EMCPCompression InCompression, int32 InThreshold)
+{
+    Compression = InCompression;
+    Threshold = FMath::Max(0, InThreshold);
+    if (Compression == EMCPCompression::None)
+    {
+        Scratch.Empty();
+    }
+}
+
+bool FMCPFrameCompressor::ShouldCompress(int32 PayloadSize)
+{
+    if (Compression == EMCPCompression::None)
+    {
+        return false;
+    }
+    if (PayloadSize == 0 || PayloadSize < Threshold)
+    {
+        ++Stats.MessagesBelowThreshold;
+        return false;
+    }
+    return true;
+}
+
+bool FMCPFrameCompressor::Compress(TConstArrayView<uint8> Payload, TFunctionRef<bool(TConstArrayView<uint8>)> Emit)
+{
+    const FName Format = GetFormatName(Compression);
+    ++Stats.MessagesCompressed;
+    Stats.BytesIn += Payload.Num();
+
+    for (int32 Offset = 0; Offset < Payload.Num(); Offset += BlockSize)
+    {
+        const uint8* Block = Payload.GetData() + Offset;
+        const int32 BlockLength = FMath::Min(BlockSize, Payload.Num() - Offset);
+        const int32 Bound = FCompression::CompressMemoryBound(Format, BlockLength);
+        Scratch.SetNumUninitialized(BlockHeaderSize + FMath::Max(Bound, BlockLength), EAllowShrinking::No);
+
+        // Only the codec is timed; the socket write happens in Emit
+        const double StartTime = FPlatformTime::Seconds();
+        int32 CompressedLength = Bound;
+        const bool bCompressed = FCompression::CompressMemory(Format, Scratch.GetData() + BlockHeaderSize, CompressedLength, Block, BlockLength, COMPRESS_BiasSpeed)
+            && CompressedLength < BlockLength;
+        Stats.CompressSeconds += FPlatformTime::Seconds() - StartTime;
+
+        if (!bCompressed)
+        {
+            // Already dense (or the codec failed): send the block as is
+            FMemory::Memcpy(Scratch.GetData() + BlockHeaderSize, Block, BlockLength);
+            CompressedLength = BlockLength;
+            ++Stats.BlocksStored;
+        }
+
+        const bool bMore = Offset + BlockLength < Payload.Num();
+        WriteBigEndian(Scratch.GetData(), (uint32)(4 + CompressedLength) | CompressedFlag | (bMore ? MoreFlag : 0u));
+        WriteBigEndian(Scratch.GetData() + 4, (uint32)BlockLength);
+
+        const int32 FrameLength = BlockHeaderSize + CompressedLength;
+        Stats.BytesOut += FrameLength;
+        if (!Emit(TConstArrayView<uint8>(Scratch.GetData(), FrameLength)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,333 @@
+#include "MCPMessageFraming.h"
+#include "Containers/StringConv.h"
+
+bool MCPFraming::ParseMode(const FString& ModeName, EMCPFramingMode& OutMode)
+{
+    if (ModeName == TEXT("json"))
+    {
+        OutMode = EMCPFramingMode::Json;
+        return true;
+    }
+    else if (ModeName == TEXT("newline"))
+    {
+        OutMode = EMCPFramingMode::Newline;
+        return true;
+    }
+    else if (ModeName == TEXT("length_prefixed"))
+    {
+        OutMode = EMCPFramingMode::LengthPrefixed;
+        return true;
+    }
+    return false;
+}
+
+const TCHAR* MCPFraming::ModeToString(EMCPFramingMode Mode)
+{
+    switch (Mode)
+    {
+    case EMCPFramingMode::Newline:
+        return TEXT("newline");
+    case EMCPFramingMode::LengthPrefixed:
+        return TEXT("length_prefixed");
+    default:
+        return TEXT("json");
+    }
+}
+
+bool MCPFraming::ParseEncoding(const FString& EncodingName, EMCPEncoding& OutEncoding)
+{
+    if (EncodingName == TEXT("json"))
+    {
+        OutEncoding = EMCPEncoding::Json;
+        return true;
+    }
+    else if (EncodingName == TEXT("cbor"))
+    {
+        OutEncoding = EMCPEncoding::Cbor;
+        return true;
+    }
+    return false;
+}
+
+const TCHAR* MCPFraming::EncodingToString(EMCPEncoding Encoding)
+{
+    return Encoding == EMCPEncoding::Cbor ? TEXT("cbor") : TEXT("json");
+}
+
+bool MCPFraming::ParseCompression(const FString& CompressionName, EMCPCompression& OutCompression)
+{
+    if (CompressionName == TEXT("none"))
+    {
+        OutCompression = EMCPCompression::None;
+        return true;
+    }
+    else if (CompressionName == TEXT("lz4"))
+    {
+        OutCompression = EMCPCompression::LZ4;
+        return true;
+    }
+    else if (CompressionName == TEXT("zlib"))
+    {
+        OutCompression = EMCPCompression::Zlib;
+        return true;
+    }
+    return false;
+}
+
+const TCHAR* MCPFraming::CompressionToString(EMCPCompression Compression)
+{
+    switch (Compression)
+    {
+    case EMCPCompression::LZ4:
+        return TEXT("lz4");
+    case EMCPCompression::Zlib:
+        return TEXT("zlib");
+    default:
+        return TEXT("none");
+    }
+}
+
+void MCPFraming::WriteLengthHeader(uint32 Length, uint8* OutHeader)
+{
+    check(Length <= MaxFrameLength);
+    OutHeader[0] = (uint8)((Length >> 24) & 0xFF);
+    OutHeader[1] = (uint8)((Length >> 16) & 0xFF);
+    OutHeader[2] = (uint8)((Length >> 8) & 0xFF);
+    OutHeader[3] = (uint8)(Length & 0xFF);
+}
+
+FMCPMessageDecoder::FMCPMessageDecoder(EMCPFramingMode InMode, int32 InMaxMessageSize)
+    : Mode(InMode)
+    , MaxMessageSize(InMaxMessageSize)
+    , ReadOffset(0)
+    , DataEnd(0)
+{
+    ResetScanState();
+}
+
+void FMCPMessageDecoder::SetMode(EMCPFramingMode NewMode)
+{
+    Mode = NewMode;
+    ResetScanState();
+}
+
+void FMCPMessageDecoder::ResetScanState()
+{
+    ScanOffset = ReadOffset;
+    MessageStart = INDEX_NONE;
+    Depth = 0;
+    bInString = false;
+    bEscape = false;
+}
+
+void FMCPMessageDecoder::Compact()
+{
+    if (ReadOffset == 0)
+    {
+        return;
+    }
+
+    const int32 Remaining = DataEnd - ReadOffset;
+    if (Remaining > 0)
+    {
+        FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + ReadOffset, Remaining);
+    }
+
+    ScanOffset -= ReadOffset;
+    if (MessageStart != INDEX_NONE)
+    {
+        MessageStart -= ReadOffset;
+    }
+    DataEnd = Remaining;
+    ReadOffset = 0;
+}
+
+uint8* FMCPMessageDecoder::GetWriteBuffer(int32 MinFree)
+{
+    // Only move data when the consumed prefix dominates the buffer, so each
+    // byte is copied at most a constant number of times on average.
+    if (ReadOffset > 0 && (ReadOffset == DataEnd || ReadOffset >= (DataEnd - ReadOffset)))
+    {
+        Compact();
+    }
+
+    const int32 Required = DataEnd + MinFree;
+    if (Buffer.Num() < Required)
+    {
+        Buffer.SetNumUninitialized(FMath::Max(Required, Buffer.Num() * 2));
+    }
+    return Buffer.GetData() + DataEnd;
+}
+
+void FMCPMessageDecoder::CommitWrite(int32 BytesWritten)
+{
+    check(BytesWritten >= 0 && DataEnd + BytesWritten <= Buffer.Num());
+    DataEnd += BytesWritten;
+}
+
+void FMCPMessageDecoder::Append(const uint8* Data, int32 Num)
+{
+    if (Num <= 0)
+    {
+        return;
+    }
+    FMemory::Memcpy(GetWriteBuffer(Num), Data, Num);
+    CommitWrite(Num);
+}
+
+bool FMCPMessageDecoder::NextMessageView(TConstArrayView<uint8>& OutMessage)
+{
+    if (HasError())
+    {
+        return false;
+    }
+
+    int32 Start = 0;
+    int32 Length = 0;
+    bool bFound = false;
+
+    switch (Mode)
+    {
+    case EMCPFramingMode::Newline:
+        bFound = NextNewlineMessage(Start, Length);
+        break;
+    case EMCPFramingMode::LengthPrefixed:
+        bFound = NextLengthPrefixedMessage(Start, Length);
+        break;
+    default:
+        bFound = NextJsonMessage(Start, Length);
+        break;
+    }
+
+    if (!bFound)
+    {
+        if (!HasError() && DataEnd - ReadOffset > MaxMessageSize)
+        {
+            Error = FString::Printf(TEXT("Message exceeds maximum size of %d bytes"), MaxMessageSize);
+        }
+        return false;
+    }
+
+    OutMessage = TConstArrayView<uint8>(Buffer.GetData() + Start, Length);
+    return true;
+}
+
+bool FMCPMessageDecoder::NextJsonMessage(int32& OutStart, int32& OutLength)
+{
+    const uint8* Data = Buffer.GetData();
+
+    while (ScanOffset < DataEnd)
+    {
+        const uint8 Char = Data[ScanOffset++];
+
+        if (MessageStart == INDEX_NONE)
+        {
+            // Between documents: skip whitespace, delimiters and keep-alive bytes
+            if (Char == '{' || Char == '[')
+            {
+                MessageStart = ScanOffset - 1;
+                Depth = 1;
+            }
+            ReadOffset = (MessageStart == INDEX_NONE) ? ScanOffset : MessageStart;
+            continue;
+        }
+
+        if (bInString)
+        {
+            if (bEscape)
+            {
+                bEscape = false;
+            }
+            else if (Char == '\\')
+            {
+                bEscape = true;
+            }
+            else if (Char == '"')
+            {
+                bInString = false;
+            }
+            continue;
+        }
+
+        if (Char == '"')
+        {
+            bInString = true;
+        }
+        else if (Char == '{' || Char == '[')
+        {
+            ++Depth;
+        }
+        else if (Char == '}' || Char == ']')
+        {
+            if (--Depth == 0)
+            {
+                OutStart = MessageStart;
+                OutLength = ScanOffset - MessageStart;
+                ReadOffset = ScanOffset;
+                MessageStart = INDEX_NONE;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool FMCPMessageDecoder::NextNewlineMessage(int32& OutStart, int32& OutLength)
+{
+    const uint8* Data = Buffer.GetData();
+
+    while (ScanOffset < DataEnd)
+    {
+        if (Data[ScanOffset++] != '\n')
+        {
+            continue;
+        }
+
+        int32 Start = ReadOffset;
+        int32 End = ScanOffset - 1;
+        ReadOffset = ScanOffset;
+
+        // Tolerate CRLF and blank keep-alive lines
+        if (End > Start && Data[End - 1] == '\r')
+        {
+            --End;
+        }
+        if (End > Start)
+        {
+            OutStart = Start;
+            OutLength = End - Start;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FMCPMessageDecoder::NextLengthPrefixedMessage(int32& OutStart, int32& OutLength)
+{
+    const int32 Available = DataEnd - ReadOffset;
+    if (Available < 4)
+    {
+        return false;
+    }
+
+    const uint8* Header = Buffer.GetData() + ReadOffset;
+    const uint32 PayloadLength = ((uint32)Header[0] << 24) | ((uint32)Header[1] << 16) | ((uint32)Header[2] << 8) | (uint32)Header[3];
+    if (PayloadLength > (uint32)MaxMessageSize)
+    {
+        Error = FString::Printf(TEXT("Frame length %u exceeds maximum size of %d bytes"), PayloadLength, MaxMessageSize);
+        return false;
+    }
+
+    if (Available - 4 < (int32)PayloadLength)
+    {
+        return false;
+    }
+
+    OutStart = ReadOffset + 4;
+    OutLength = (int32)PayloadLength;
+    ReadOffset = OutStart + OutLength;
+    ScanOffset = ReadOffset;
+    return true;
+}
@@ -0,0 +1,74 @@
+#include "MCPSharedRing.h"
+#include "HAL/PlatformAtomics.h"
+
+TUniquePtr<FMCPSharedRing> FMCPSharedRing::Create(const FString& Name, int64 Capacity, FString& OutError)
+{
+    if (Capacity < MinCapacity || Capacity > MaxCapacity)
+    {
+        OutError = FString::Printf(TEXT("Ring size must be between %lld and %lld bytes"), MinCapacity, MaxCapacity);
+        return nullptr;
+    }
+
+    FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(
+        Name, true, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, (SIZE_T)(HeaderSize + Capacity));
+    if (!Region)
+    {
+        OutError = FString::Printf(TEXT("Failed to create shared memory region '%s' (%lld bytes)"), *Name, HeaderSize + Capacity);
+        return nullptr;
+    }
+    return TUniquePtr<FMCPSharedRing>(new FMCPSharedRing(Name, Region, Capacity));
+}
+
+FMCPSharedRing::FMCPSharedRing(const FString& InName, FPlatformMemory::FSharedMemoryRegion* InRegion, int64 InCapacity)
+    : Name(InName)
+    , Region(InRegion)
+    , Data((uint8*)InRegion->GetAddress())
+    , Capacity(InCapacity)
+    , Head(0)
+    , Writes(0)
+    , Fallbacks(0)
+{
+    FMemory::Memzero(Data, HeaderSize);
+    const uint32 HeaderSize32 = HeaderSize;
+    FMemory::Memcpy(Data, &Magic, 4);
+    FMemory::Memcpy(Data + 4, &HeaderSize32, 4);
+    FMemory::Memcpy(Data + 8, &Capacity, 8);
+}
+
+FMCPSharedRing::~FMCPSharedRing()
+{
+    FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+uint64* FMCPSharedRing::HeadPtr() const
+{
+    return (uint64*)(Data + HeadOffset);
+}
+
+uint64* FMCPSharedRing::TailPtr() const
+{
+    return (uint64*)(Data + TailOffset);
+}
+
+bool FMCPSharedRing::TryWrite(const uint8* Payload, int64 Num, uint64& OutPosition)
+{
+    // The client only ever moves the tail forward, so a stale read just means less free space
+    const uint64 Tail = (uint64)FPlatformAtomics::AtomicRead((volatile int64*)TailPtr());
+    if (Tail > Head || Num > Capacity - (int64)(Head - Tail))
+    {
+        ++Fallbacks;
+        return false;
+    }
+
+    uint8* Ring = Data + HeaderSize;
+    const int64 Start = (int64)(Head % (uint64)Capacity);
+    const int64 FirstPart = FMath::Min(Num, Capacity - Start);
+    FMemory::Memcpy(Ring + Start, Payload, FirstPart);
+    FMemory::Memcpy(Ring, Payload + FirstPart, Num - FirstPart);
+
+    OutPosition = Head;
+    Head += Num;
+    ++Writes;
+    FPlatformAtomics::AtomicStore((volatile int64*)HeadPtr(), (int64)Head);
+    return true;
+}
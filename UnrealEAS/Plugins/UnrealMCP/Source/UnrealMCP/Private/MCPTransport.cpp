@@ -0,0 +1,529 @@
+#include "MCPTransport.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#define MCP_HAS_UNIX_SOCKETS 1
+#else
+#define MCP_HAS_UNIX_SOCKETS 0
+#endif
+
+// Kernel buffer size requested for every client stream
+static const int32 StreamBufferSize = 65536;
+
+EMCPStreamResult IMCPStream::SendGather(TConstArrayView<TConstArrayView64<uint8>> Buffers, int32& OutBytesSent)
+{
+    OutBytesSent = 0;
+    int32 First = 0;
+    while (First < Buffers.Num() && Buffers[First].Num() == 0)
+    {
+        ++First;
+    }
+    if (First == Buffers.Num())
+    {
+        return EMCPStreamResult::Ok;
+    }
+
+    const TConstArrayView64<uint8>& Leading = Buffers[First];
+    if (First == Buffers.Num() - 1 || Leading.Num() >= GatherStagingSize)
+    {
+        return Send(Leading.GetData(), (int32)FMath::Min<int64>(Leading.Num(), MAX_int32), OutBytesSent);
+    }
+
+    // Copies at most one staging buffer's worth; whatever isn't sent is restaged next call
+    static thread_local TArray<uint8> Staging;
+    Staging.Reset(GatherStagingSize);
+    for (int32 Index = First; Index < Buffers.Num() && Staging.Num() < GatherStagingSize; ++Index)
+    {
+        const int64 Take = FMath::Min<int64>(Buffers[Index].Num(), GatherStagingSize - Staging.Num());
+        Staging.Append(Buffers[Index].GetData(), (int32)Take);
+    }
+    return Send(Staging.GetData(), Staging.Num(), OutBytesSent);
+}
+
+namespace
+{
+    class FMCPSocketStream : public IMCPStream
+    {
+    public:
+        explicit FMCPSocketStream(FSocket* InSocket)
+            : Socket(InSocket)
+        {
+            // Reads wait on readiness first; a send to a client that stops reading returns
+            // instead of blocking, so the channel can time it out and Close can wake it
+            int32 ActualSize = 0;
+            Socket->SetNonBlocking(true);
+            Socket->SetNoDelay(true);
+            Socket->SetSendBufferSize(StreamBufferSize, ActualSize);
+            Socket->SetReceiveBufferSize(StreamBufferSize, ActualSize);
+        }
+
+        virtual ~FMCPSocketStream() override
+        {
+            Close();
+        }
+
+        virtual bool WaitForRead(const FTimespan& Timeout) override
+        {
+            return Socket->Wait(ESocketWaitConditions::WaitForRead, Timeout);
+        }
+
+        virtual bool IsConnected() override
+        {
+            return Socket->GetConnectionState() == SCS_Connected;
+        }
+
+        virtual uint32 GetPendingBytes() override
+        {
+            uint32 PendingSize = 0;
+            Socket->HasPendingData(PendingSize);
+            return PendingSize;
+        }
+
+        virtual EMCPStreamResult Recv(uint8* Data, int32 Size, int32& OutBytesRead) override
+        {
+            OutBytesRead = 0;
+            if (!Socket->Recv(Data, Size, OutBytesRead))
+            {
+                const int32 LastError = GetLastErrorCode();
+                return LastError == SE_EWOULDBLOCK || LastError == SE_EINTR ? EMCPStreamResult::Retry : EMCPStreamResult::Error;
+            }
+            return OutBytesRead > 0 ? EMCPStreamResult::Ok : EMCPStreamResult::Closed;
+        }
+
+        virtual bool WaitForWrite(const FTimespan& Timeout) override
+        {
+            return Socket->Wait(ESocketWaitConditions::WaitForWrite, Timeout);
+        }
+
+        virtual EMCPStreamResult Send(const uint8* Data, int32 Size, int32& OutBytesSent) override
+        {
+            OutBytesSent = 0;
+            if (!Socket->Send(Data, Size, OutBytesSent))
+            {
+                const int32 LastError = GetLastErrorCode();
+                return LastError == SE_EWOULDBLOCK || LastError == SE_EINTR ? EMCPStreamResult::Retry : EMCPStreamResult::Error;
+            }
+            return OutBytesSent > 0 ? EMCPStreamResult::Ok : EMCPStreamResult::Retry;
+        }
+
+        virtual int32 GetLastErrorCode() override
+        {
+            return (int32)ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+        }
+
+        virtual void Interrupt() override
+        {
+            if (Socket)
+            {
+                Socket->Shutdown(ESocketShutdownMode::ReadWrite);
+            }
+        }
+
+        virtual void Close() override
+        {
+            if (Socket)
+            {
+                Socket->Close();
+                ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+                Socket = nullptr;
+            }
+        }
+
+    private:
+        FSocket* Socket;
+    };
+
+    class FMCPSocketListener : public IMCPListener
+    {
+    public:
+        FMCPSocketListener(FSocket* InSocket, const FString& InDescription)
+            : Socket(InSocket)
+            , Description(InDescription)
+        {
+        }
+
+        virtual ~FMCPSocketListener() override
+        {
+            ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        }
+
+        virtual bool WaitForPendingConnection(const FTimespan& Timeout) override
+        {
+            bool bPending = false;
+            return Socket->WaitForPendingConnection(bPending, Timeout) && bPending;
+        }
+
+        virtual TUniquePtr<IMCPStream> Accept() override
+        {
+            bool bPending = false;
+            if (!Socket->HasPendingConnection(bPending) || !bPending)
+            {
+                return nullptr;
+            }
+
+            FSocket* ClientSocket = Socket->Accept(TEXT("MCPClient"));
+            if (!ClientSocket)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("MCPTransport: Failed to accept client on %s"), *Description);
+                return nullptr;
+            }
+            return MakeUnique<FMCPSocketStream>(ClientSocket);
+        }
+
+        virtual FString Describe() const override
+        {
+            return Description;
+        }
+
+    private:
+        FSocket* Socket;
+        FString Description;
+    };
+
+#if MCP_HAS_UNIX_SOCKETS
+    class FMCPUnixStream : public IMCPStream
+    {
+    public:
+        explicit FMCPUnixStream(int InFd)
+            : Fd(InFd)
+            , LastError(0)
+        {
+            int BufferSize = StreamBufferSize;
+            setsockopt(Fd, SOL_SOCKET, SO_SNDBUF, &BufferSize, sizeof(BufferSize));
+            setsockopt(Fd, SOL_SOCKET, SO_RCVBUF, &BufferSize, sizeof(BufferSize));
+#if PLATFORM_MAC
+            // A client that disconnects mid-response must not raise SIGPIPE in the editor
+            int NoSigPipe = 1;
+            setsockopt(Fd, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+        }
+
+        virtual ~FMCPUnixStream() override
+        {
+            Close();
+        }
+
+        virtual bool WaitForRead(const FTimespan& Timeout) override
+        {
+            pollfd PollFd = { Fd, POLLIN, 0 };
+            // A hang-up also reports readable, so the following Recv sees the close
+            return poll(&PollFd, 1, (int)Timeout.GetTotalMilliseconds()) > 0;
+        }
+
+        virtual bool IsConnected() override
+        {
+            return Fd >= 0;
+        }
+
+        virtual uint32 GetPendingBytes() override
+        {
+            int PendingSize = 0;
+            return ioctl(Fd, FIONREAD, &PendingSize) == 0 ? (uint32)FMath::Max(PendingSize, 0) : 0;
+        }
+
+        virtual EMCPStreamResult Recv(uint8* Data, int32 Size, int32& OutBytesRead) override
+        {
+            OutBytesRead = 0;
+            const ssize_t Result = recv(Fd, Data, Size, 0);
+            if (Result < 0)
+            {
+                LastError = errno;
+                return LastError == EINTR || LastError == EAGAIN || LastError == EWOULDBLOCK ? EMCPStreamResult::Retry : EMCPStreamResult::Error;
+            }
+            OutBytesRead = (int32)Result;
+            return Result > 0 ? EMCPStreamResult::Ok : EMCPStreamResult::Closed;
+        }
+
+        virtual bool WaitForWrite(const FTimespan& Timeout) override
+        {
+            pollfd PollFd = { Fd, POLLOUT, 0 };
+            return poll(&PollFd, 1, (int)Timeout.GetTotalMilliseconds()) > 0;
+        }
+
+        virtual EMCPStreamResult Send(const uint8* Data, int32 Size, int32& OutBytesSent) override
+        {
+            const TConstArrayView64<uint8> Buffer(Data, Size);
+            return SendGather(MakeArrayView(&Buffer, 1), OutBytesSent);
+        }
+
+        virtual EMCPStreamResult SendGather(TConstArrayView<TConstArrayView64<uint8>> Buffers, int32& OutBytesSent) override
+        {
+            iovec Vectors[MaxVectors];
+            int32 NumVectors = 0;
+            int64 Total = 0;
+            for (const TConstArrayView64<uint8>& Buffer : Buffers)
+            {
+                if (Buffer.Num() == 0)
+                {
+                    continue;
+                }
+                if (NumVectors == MaxVectors || Total >= MAX_int32)
+                {
+                    break;
+                }
+                // Keep the total within what OutBytesSent can report
+                const int64 Length = FMath::Min<int64>(Buffer.Num(), MAX_int32 - Total);
+                Vectors[NumVectors].iov_base = (void*)Buffer.GetData();
+                Vectors[NumVectors].iov_len = (size_t)Length;
+                ++NumVectors;
+                Total += Length;
+            }
+
+            OutBytesSent = 0;
+            if (NumVectors == 0)
+            {
+                return EMCPStreamResult::Ok;
+            }
+
+            msghdr Message = {};
+            Message.msg_iov = Vectors;
+            Message.msg_iovlen = NumVectors;
+#if PLATFORM_MAC
+            const int Flags = 0;
+#else
+            const int Flags = MSG_NOSIGNAL;
+#endif
+            const ssize_t Result = sendmsg(Fd, &Message, Flags);
+            if (Result < 0)
+            {
+                LastError = errno;
+                return LastError == EINTR || LastError == EAGAIN || LastError == EWOULDBLOCK ? EMCPStreamResult::Retry : EMCPStreamResult::Error;
+            }
+            OutBytesSent = (int32)Result;
+            return EMCPStreamResult::Ok;
+        }
+
+        virtual int32 GetLastErrorCode() override
+        {
+            return LastError;
+        }
+
+        virtual void Interrupt() override
+        {
+            if (Fd >= 0)
+            {
+                shutdown(Fd, SHUT_RDWR);
+            }
+        }
+
+        virtual void Close() override
+        {
+            if (Fd >= 0)
+            {
+                shutdown(Fd, SHUT_RDWR);
+                close(Fd);
+                Fd = -1;
+            }
+        }
+
+    private:
+        static constexpr int32 MaxVectors = 16;
+
+        int Fd;
+        int32 LastError;
+    };
+
+    class FMCPUnixListener : public IMCPListener
+    {
+    public:
+        FMCPUnixListener(int InFd, const FString& InPath)
+            : Fd(InFd)
+            , Path(InPath)
+        {
+        }
+
+        virtual ~FMCPUnixListener() override
+        {
+            close(Fd);
+            unlink(TCHAR_TO_UTF8(*Path));
+        }
+
+        virtual bool WaitForPendingConnection(const FTimespan& Timeout) override
+        {
+            pollfd PollFd = { Fd, POLLIN, 0 };
+            return poll(&PollFd, 1, (int)Timeout.GetTotalMilliseconds()) > 0;
+        }
+
+        virtual TUniquePtr<IMCPStream> Accept() override
+        {
+            const int ClientFd = accept(Fd, nullptr, nullptr);
+            if (ClientFd < 0)
+            {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("MCPTransport: Failed to accept client on %s (errno %d)"), *Path, errno);
+                }
+                return nullptr;
+            }
+
+            // Not every platform hands out accepted sockets with the listener's O_NONBLOCK
+            fcntl(ClientFd, F_SETFL, fcntl(ClientFd, F_GETFL) | O_NONBLOCK);
+            fcntl(ClientFd, F_SETFD, FD_CLOEXEC);
+            return MakeUnique<FMCPUnixStream>(ClientFd);
+        }
+
+        virtual FString Describe() const override
+        {
+            return Path;
+        }
+
+    private:
+        int Fd;
+        FString Path;
+    };
+#endif
+}
+
+TUniquePtr<IMCPListener> MCPTransport::ListenTcp(const FIPv4Address& Address, uint16 Port)
+{
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (!SocketSubsystem)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Failed to get socket subsystem"));
+        return nullptr;
+    }
+
+    FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false);
+    if (!Socket)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Failed to create listener socket"));
+        return nullptr;
+    }
+
+    // Allow address reuse for quick restarts
+    Socket->SetReuseAddr(true);
+    Socket->SetNonBlocking(true);
+
+    const FIPv4Endpoint Endpoint(Address, Port);
+    if (!Socket->Bind(*Endpoint.ToInternetAddr()) || !Socket->Listen(5))
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Failed to listen on %s"), *Endpoint.ToString());
+        SocketSubsystem->DestroySocket(Socket);
+        return nullptr;
+    }
+    return MakeUnique<FMCPSocketListener>(Socket, Endpoint.ToString());
+}
+
+#if MCP_HAS_UNIX_SOCKETS
+// Creates Directory owner-only if it is missing, then checks that it is a real directory
+// owned by this user with no group or other access
+static bool EnsurePrivateDirectory(const FString& Directory)
+{
+    FTCHARToUTF8 Utf8Directory(*Directory);
+    if (mkdir(Utf8Directory.Get(), S_IRWXU) != 0 && errno != EEXIST)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Failed to create %s (errno %d)"), *Directory, errno);
+        return false;
+    }
+
+    struct stat Info;
+    if (lstat(Utf8Directory.Get(), &Info) != 0 || !S_ISDIR(Info.st_mode) || Info.st_uid != geteuid() || (Info.st_mode & (S_IRWXG | S_IRWXO)) != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: %s must be a directory only this user can access; Unix socket not opened"), *Directory);
+        return false;
+    }
+    return true;
+}
+#endif
+
+FString MCPTransport::DefaultUnixSocketPath(uint16 Port)
+{
+#if MCP_HAS_UNIX_SOCKETS
+    FString Directory = FPlatformMisc::GetEnvironmentVariable(TEXT("XDG_RUNTIME_DIR"));
+    if (Directory.IsEmpty())
+    {
+        // The shared temp directory is world-writable; the per-user directory below it isn't
+        Directory = FPaths::Combine(FPlatformProcess::UserTempDir(), FString::Printf(TEXT("unreal-mcp-%u"), (uint32)geteuid()));
+    }
+    return FPaths::Combine(Directory, FString::Printf(TEXT("unreal-mcp-%d.sock"), Port));
+#else
+    return FString();
+#endif
+}
+
+TUniquePtr<IMCPListener> MCPTransport::ListenUnix(const FString& Path)
+{
+#if MCP_HAS_UNIX_SOCKETS
+    sockaddr_un Address = {};
+    Address.sun_family = AF_UNIX;
+    FTCHARToUTF8 Utf8Path(*Path);
+    if (Utf8Path.Length() == 0 || Utf8Path.Length() >= (int32)sizeof(Address.sun_path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Unix socket path '%s' is empty or too long"), *Path);
+        return nullptr;
+    }
+    FMemory::Memcpy(Address.sun_path, Utf8Path.Get(), Utf8Path.Length());
+
+    // Anyone who can write to the directory could plant or replace the socket
+    if (!EnsurePrivateDirectory(FPaths::GetPath(Path)))
+    {
+        return nullptr;
+    }
+
+    // Only replace what a crashed editor left behind: never a live socket or an unrelated file.
+    // The probe uses its own socket; one that failed to connect isn't reliably bindable.
+    struct stat Existing;
+    if (lstat(Address.sun_path, &Existing) == 0)
+    {
+        bool bInUse = !S_ISSOCK(Existing.st_mode);
+        if (!bInUse)
+        {
+            const int ProbeFd = socket(AF_UNIX, SOCK_STREAM, 0);
+            bInUse = ProbeFd >= 0 && connect(ProbeFd, (const sockaddr*)&Address, sizeof(Address)) == 0;
+            if (ProbeFd >= 0)
+            {
+                close(ProbeFd);
+            }
+        }
+        if (bInUse)
+        {
+            UE_LOG(LogTemp, Error, TEXT("MCPTransport: %s is in use"), *Path);
+            return nullptr;
+        }
+        unlink(Address.sun_path);
+    }
+
+    const int Fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (Fd < 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Failed to create Unix socket (errno %d)"), errno);
+        return nullptr;
+    }
+
+    // Nobody else can reach into the private directory, so the socket's own mode doesn't matter
+    if (bind(Fd, (const sockaddr*)&Address, sizeof(Address)) != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Failed to bind %s (errno %d)"), *Path, errno);
+        close(Fd);
+        return nullptr;
+    }
+    fcntl(Fd, F_SETFL, fcntl(Fd, F_GETFL) | O_NONBLOCK);
+    fcntl(Fd, F_SETFD, FD_CLOEXEC);
+
+    if (listen(Fd, 16) != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPTransport: Failed to listen on %s (errno %d)"), *Path, errno);
+        close(Fd);
+        unlink(Address.sun_path);
+        return nullptr;
+    }
+    return MakeUnique<FMCPUnixListener>(Fd, Path);
+#else
+    UE_LOG(LogTemp, Display, TEXT("MCPTransport: Unix domain sockets aren't supported on this platform; %s not opened"), *Path);
+    return nullptr;
+#endif
+}
@@ -1,5 +1,6 @@
 #include "UnrealMCPBridge.h"
 #include "MCPServerRunnable.h"
+#include "MCPTransport.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "HAL/RunnableThread.h"
@@ -10,6 +11,7 @@
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/DirectionalLight.h"
 #include "Engine/PointLight.h"
@@ -22,6 +24,8 @@
 #include "Engine/Selection.h"
 #include "Kismet/GameplayStatics.h"
 #include "Async/Async.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/Paths.h"
 // Add Blueprint related includes
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -57,6 +61,19 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPRenderingCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPCommandContext.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "Commands/UnrealMCPImageDelivery.h"
+#include "Commands/UnrealMCPViewportReadback.h"
+#include "Commands/UnrealMCPWorldResolver.h"
+#include "Commands/UnrealMCPPropertyBindings.h"
+#include "Commands/UnrealMCPConstructionScripts.h"
+#include "Commands/UnrealMCPPropertyAnimator.h"
+#include "Commands/UnrealMCPSubscriptions.h"
+#include "Commands/UnrealMCPJsonWriter.h"
+#include "Commands/UnrealMCPCbor.h"
+#include "MCPBufferPool.h"
+#include "MCPCommandScheduler.h"
 
 // Default settings
 #define MCP_SERVER_HOST "127.0.0.1"
@@ -68,28 +85,81 @@ void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Initializing"));
     
     bIsRunning = false;
-    ListenerSocket = nullptr;
-    ConnectionSocket = nullptr;
-    ServerThread = nullptr;
     Port = MCP_SERVER_PORT;
     FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
 
+    // The same variables the Python server reads, so both ends move together
+    const FString HostOverride = FPlatformMisc::GetEnvironmentVariable(TEXT("UNREAL_TCP_HOST"));
+    if (!HostOverride.IsEmpty() && !FIPv4Address::Parse(HostOverride, ServerAddress))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Ignoring invalid UNREAL_TCP_HOST '%s'"), *HostOverride);
+        FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
+    }
+    const int32 PortOverride = FCString::Atoi(*FPlatformMisc::GetEnvironmentVariable(TEXT("UNREAL_TCP_PORT")));
+    if (PortOverride > 0 && PortOverride <= MAX_uint16)
+    {
+        Port = (uint16)PortOverride;
+    }
+
+    // Same-host clients can skip the TCP stack; "off" disables the Unix domain socket
+    UnixSocketPath = FPlatformMisc::GetEnvironmentVariable(TEXT("UNREAL_MCP_UNIX_SOCKET"));
+    if (UnixSocketPath.IsEmpty())
+    {
+        UnixSocketPath = MCPTransport::DefaultUnixSocketPath(Port);
+    }
+    else if (UnixSocketPath == TEXT("off"))
+    {
+        UnixSocketPath.Reset();
+    }
+
     // Create command handlers
     ActorCommands = MakeShared<FUnrealMCPActorCommands>();
     EditorCommands = MakeShared<FUnrealMCPEditorCommands>();
     BlueprintCommands = MakeShared<FUnrealMCPBlueprintCommands>();
     BlueprintNodeCommands = MakeShared<FUnrealMCPBlueprintNodeCommands>();
     RenderingCommands = MakeShared<FUnrealMCPRenderingCommands>();
+    RegisterCommands();
+    Scheduler = MakeShared<FMCPCommandScheduler, ESPMode::ThreadSafe>();
 
     // Start the server automatically
     StartServer();
 }
 
+// Build the command table once; connection threads only read it afterwards
+void UUnrealMCPBridge::RegisterCommands()
+{
+    CommandRegistry = MakeShared<FUnrealMCPCommandRegistry>();
+
+    CommandRegistry->Register(TEXT("ping"), [](const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+        return ResultJson;
+    }, EUnrealMCPCommandFlags::ReadOnly | EUnrealMCPCommandFlags::AnyThread);
+    CommandRegistry->Register(TEXT("batch"), this, &UUnrealMCPBridge::HandleBatchCommand, EUnrealMCPCommandFlags::None, EUnrealMCPCommandCost::High);
+
+    ActorCommands->RegisterCommands(*CommandRegistry);
+    EditorCommands->RegisterCommands(*CommandRegistry);
+    BlueprintCommands->RegisterCommands(*CommandRegistry);
+    BlueprintNodeCommands->RegisterCommands(*CommandRegistry);
+    RenderingCommands->RegisterCommands(*CommandRegistry);
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Registered %d commands"), CommandRegistry->Num());
+}
+
 // Clean up resources when subsystem is destroyed
 void UUnrealMCPBridge::Deinitialize()
 {
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Shutting down"));
     StopServer();
+    Scheduler->Shutdown();
+    FUnrealMCPViewportReadback::Get().Shutdown();
+    FUnrealMCPWorldResolver::Get().Shutdown();
+    FUnrealMCPPropertyBindings::Get().Shutdown();
+    FUnrealMCPPropertyAnimator::Get().Shutdown();
+    FUnrealMCPSubscriptions::Get().Shutdown();
+    FUnrealMCPConstructionScripts::Get().Shutdown();
+    FUnrealMCPImageDelivery::ReleaseAllSharedMemory();
 }
 
 // Start the MCP server
@@ -101,58 +171,45 @@ void UUnrealMCPBridge::StartServer()
         return;
     }
 
-    // Create socket subsystem
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
+    TUniquePtr<IMCPListener> TcpListener = MCPTransport::ListenTcp(ServerAddress, Port);
+    if (!TcpListener)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
         return;
     }
 
-    // Create listener socket
-    TSharedPtr<FSocket> NewListenerSocket = MakeShareable(SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false));
-    if (!NewListenerSocket.IsValid())
+    bIsRunning = true;
+    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server started on %s"), *TcpListener->Describe());
+    if (!StartServerThread(MoveTemp(TcpListener), TEXT("UnrealMCPServerThread")))
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
+        StopServer();
         return;
     }
 
-    // Allow address reuse for quick restarts
-    NewListenerSocket->SetReuseAddr(true);
-    NewListenerSocket->SetNonBlocking(true);
-
-    // Bind to address
-    FIPv4Endpoint Endpoint(ServerAddress, Port);
-    if (!NewListenerSocket->Bind(*Endpoint.ToInternetAddr()))
+    // Optional: TCP clients keep working when the socket path can't be used
+    if (!UnixSocketPath.IsEmpty())
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *ServerAddress.ToString(), Port);
-        return;
+        if (TUniquePtr<IMCPListener> UnixListener = MCPTransport::ListenUnix(UnixSocketPath))
+        {
+            UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Also listening on %s"), *UnixListener->Describe());
+            StartServerThread(MoveTemp(UnixListener), TEXT("UnrealMCPUnixServerThread"));
+        }
     }
+}
 
-    // Start listening
-    if (!NewListenerSocket->Listen(5))
+bool UUnrealMCPBridge::StartServerThread(TUniquePtr<IMCPListener> Listener, const TCHAR* ThreadName)
+{
+    FMCPServerRunnable* Server = new FMCPServerRunnable(this, MoveTemp(Listener));
+    FRunnableThread* Thread = FRunnableThread::Create(Server, ThreadName, 0, TPri_Normal);
+    if (!Thread)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
-        return;
+        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create %s"), ThreadName);
+        delete Server;
+        return false;
     }
 
-    ListenerSocket = NewListenerSocket;
-    bIsRunning = true;
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
-
-    // Start server thread
-    ServerThread = FRunnableThread::Create(
-        new FMCPServerRunnable(this, ListenerSocket),
-        TEXT("UnrealMCPServerThread"),
-        0, TPri_Normal
-    );
-
-    if (!ServerThread)
-    {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
-        StopServer();
-        return;
-    }
+    Servers.Add(Server);
+    ServerThreads.Add(Thread);
+    return true;
 }
 
 // Stop the MCP server
@@ -165,196 +222,445 @@ void UUnrealMCPBridge::StopServer()
 
     bIsRunning = false;
 
-    // Clean up thread
-    if (ServerThread)
-    {
-        ServerThread->Kill(true);
-        delete ServerThread;
-        ServerThread = nullptr;
-    }
-
-    // Close sockets
-    if (ConnectionSocket.IsValid())
+    // Stop every listener thread, then free its runnable, which closes the listener
+    for (FRunnableThread* Thread : ServerThreads)
     {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ConnectionSocket.Get());
-        ConnectionSocket.Reset();
+        Thread->Kill(true);
+        delete Thread;
     }
+    ServerThreads.Empty();
 
-    if (ListenerSocket.IsValid())
+    for (FMCPServerRunnable* Server : Servers)
     {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenerSocket.Get());
-        ListenerSocket.Reset();
+        delete Server;
     }
+    Servers.Empty();
 
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server stopped"));
 }
 
-// Execute a command received from a client
+// Execute a command and block until the response is ready. Never call this on the game
+// thread: the command itself needs the game thread to make progress.
 FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
-    
     // Create a promise to wait for the result
     TPromise<FString> Promise;
     TFuture<FString> Future = Promise.GetFuture();
-    
-    // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+
+    // Binary attachments have no place in a plain string response and are dropped
+    ExecuteCommandAsync(CommandType, Params, nullptr, [Promise = MoveTemp(Promise)](TArray<uint8> Response, TArray<FUnrealMCPAttachment> Attachments) mutable
+    {
+        FUTF8ToTCHAR Converted((const ANSICHAR*)Response.GetData(), Response.Num());
+        Promise.SetValue(FString(Converted.Length(), Converted.Get()));
+        FMCPBufferPool::Release(MoveTemp(Response));
+    });
+
+    return Future.Get();
+}
+
+// A "world" parameter pins the world the command (or every sub-command of a batch) runs against
+static bool PinRequestedWorld(const TSharedPtr<FJsonObject>& Params, TOptional<FUnrealMCPWorldResolver::FScopedPin>& OutPin, FString& OutError)
+{
+    FString WorldName;
+    if (!Params.IsValid() || !IsInGameThread() || !Params->TryGetStringField(TEXT("world"), WorldName))
     {
-        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
-        
-        try
+        return true;
+    }
+
+    EUnrealMCPWorldTarget Target;
+    if (!FUnrealMCPWorldResolver::ParseTarget(WorldName, Target))
+    {
+        OutError = FString::Printf(TEXT("Unknown world '%s' (expected auto, editor, pie or game)"), *WorldName);
+        return false;
+    }
+    OutPin.Emplace(Target);
+    return true;
+}
+
+// Length headers keep their top bits for flags, so a response or attachment of more than
+// MCPFraming::MaxFrameLength bytes can't be framed. Such results are answered with an error.
+static bool FitsInFrames(const TArray<uint8>& Response, const TArray<FUnrealMCPAttachment>& Attachments)
+{
+    if ((uint32)Response.Num() > MCPFraming::MaxFrameLength)
+    {
+        return false;
+    }
+    for (const FUnrealMCPAttachment& Attachment : Attachments)
+    {
+        if (Attachment.Data.IsValid() && Attachment.Data->Num() > MCPFraming::MaxFrameLength)
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            
-            if (CommandType == TEXT("ping"))
-            {
-                ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-            }
-            // Actor Commands
-            else if (CommandType == TEXT("get_actors_in_level") || 
-                     CommandType == TEXT("find_actors_by_name") ||
-                     CommandType == TEXT("create_actor") || 
-                     CommandType == TEXT("delete_actor") || 
-                     CommandType == TEXT("set_actor_transform") ||
-                     CommandType == TEXT("get_actor_properties") ||
-                     CommandType == TEXT("get_time_of_day") ||
-                     CommandType == TEXT("set_time_of_day") ||
-                     CommandType == TEXT("get_ultra_dynamic_sky") ||
-                     CommandType == TEXT("get_ultra_dynamic_weather") ||
-					 CommandType == TEXT("set_color_temperature") ||
-                     CommandType == TEXT("set_current_weather_to_rain") ||
-					 CommandType == TEXT("set_cesium_latitude_longitude") ||
-					 CommandType == TEXT("get_cesium_properties") ||
-					 CommandType == TEXT("create_mm_control_light") ||
-					 CommandType == TEXT("get_mm_control_lights") ||
-					 CommandType == TEXT("update_mm_control_light") ||
-					 CommandType == TEXT("delete_mm_control_light") ||
-                     CommandType == TEXT("get_character_actors") ||
-                     CommandType == TEXT("select_visible_actors"))
-            {
-                ResultJson = ActorCommands->HandleCommand(CommandType, Params);
-            }
-            // Editor Commands
-            else if (CommandType == TEXT("focus_viewport") || 
-                     CommandType == TEXT("take_screenshot"))
-            {
-                ResultJson = EditorCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Commands
-            else if (CommandType == TEXT("create_blueprint") || 
-                     CommandType == TEXT("add_component_to_blueprint") || 
-                     CommandType == TEXT("set_component_property") || 
-                     CommandType == TEXT("set_physics_properties") || 
-                     CommandType == TEXT("compile_blueprint") || 
-                     CommandType == TEXT("spawn_blueprint_actor") || 
-                     CommandType == TEXT("set_blueprint_property") || 
-                     CommandType == TEXT("set_static_mesh_properties") ||
-                     CommandType == TEXT("set_pawn_properties"))
-            {
-                ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Node Commands
-            else if (CommandType == TEXT("connect_blueprint_nodes") || 
-                     CommandType == TEXT("create_input_mapping") || 
-                     CommandType == TEXT("add_blueprint_get_self_component_reference") ||
-                     CommandType == TEXT("add_blueprint_self_reference") ||
-                     CommandType == TEXT("find_blueprint_nodes") ||
-                     CommandType == TEXT("add_blueprint_event_node") ||
-                     CommandType == TEXT("add_blueprint_input_action_node") ||
-                     CommandType == TEXT("add_blueprint_function_node") ||
-                     CommandType == TEXT("add_blueprint_get_component_node") ||
-                     CommandType == TEXT("add_blueprint_variable"))
-            {
-                ResultJson = BlueprintNodeCommands->HandleCommand(CommandType, Params);
-            }
-			else if (CommandType == TEXT("take_highresshot"))
-			{
-				ResultJson = RenderingCommands->HandleCommand(CommandType, Params);
-			}
-            else
+            return false;
+        }
+    }
+    return true;
+}
+
+// Error for commands still queued when the bridge shuts down
+static const TCHAR* ShutdownError = TEXT("MCP server is shutting down");
+
+// Queue a command without waiting for it. OnComplete runs on the game thread, inline on
+// the calling thread for commands that don't touch engine state, or wherever an
+// asynchronous command finishes.
+void UUnrealMCPBridge::ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+                                           const TSharedPtr<FJsonValue>& RequestId, TUniqueFunction<void(TArray<uint8>, TArray<FUnrealMCPAttachment>)> OnComplete,
+                                           TFunction<bool(FMCPProgressEncoder, TArray<FUnrealMCPAttachment>)> OnProgress, EMCPEncoding Encoding, int32 ClientId)
+{
+    UE_LOG(LogTemp, Verbose, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+
+    // Commands that never touch UObjects (and unknown ones, which only produce an error)
+    // are answered without a game-thread hop
+    const FUnrealMCPCommandInfo* Command = CommandRegistry->Find(CommandType);
+    if (!Command || !Command->RequiresGameThread())
+    {
+        OnComplete(ExecuteCommandInternal(CommandType, Params, RequestId, Encoding), {});
+        return;
+    }
+
+    // Full lanes answer right away instead of letting work pile up on the game thread
+    const EMCPRequestLane Lane = FMCPCommandScheduler::LaneFor(*Command);
+    int32 RetryAfterMs = 0;
+    if (!Scheduler->TryAdmit(Lane, ClientId, RetryAfterMs))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Rejecting %s, %s queue is full"), *CommandType, FMCPCommandScheduler::LaneToString(Lane));
+        OnComplete(SerializeBusyResponse(RequestId, Encoding, Lane, RetryAfterMs), {});
+        return;
+    }
+
+    if (Command->IsAsync())
+    {
+        // Starts on the game thread; the handler decides when (and on which thread) it finishes
+        Scheduler->Submit(Lane, ClientId, Command->IsReadOnly(), [Command, CommandType, Params, RequestId, Encoding, ClientId, OnComplete = MoveTemp(OnComplete), OnProgress = MoveTemp(OnProgress)](bool bRun) mutable
+        {
+            if (!bRun)
             {
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-                
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                Promise.SetValue(ResultString);
+                OnComplete(SerializeResponse(CommandType, FUnrealMCPCommonUtils::CreateErrorResponse(ShutdownError), RequestId, Encoding), {});
                 return;
             }
-            
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (ResultJson->HasField(TEXT("success")))
+
+            FUnrealMCPCommandCompletion Completion = [CommandType, RequestId, Encoding, OnComplete = MoveTemp(OnComplete)](TSharedPtr<FJsonObject> ResultJson, TArray<FUnrealMCPAttachment> Attachments) mutable
             {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess && ResultJson->HasField(TEXT("error")))
+                TArray<uint8> Response = SerializeResponse(CommandType, ResultJson, RequestId, Encoding, Attachments);
+                if (!FitsInFrames(Response, Attachments))
                 {
-                    ErrorMessage = ResultJson->GetStringField(TEXT("error"));
+                    FMCPBufferPool::Release(MoveTemp(Response));
+                    Attachments.Reset();
+                    Response = SerializeResponse(CommandType, FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Result is too large to send")), RequestId, Encoding);
                 }
+                OnComplete(MoveTemp(Response), MoveTemp(Attachments));
+            };
+
+            // Only cover the synchronous start of the handler
+            FUnrealMCPSubscriptions::FScopedClient ClientScope(ClientId);
+            TOptional<FUnrealMCPWorldResolver::FScopedPin> WorldPin;
+            FString PinError;
+            if (!PinRequestedWorld(Params, WorldPin, PinError))
+            {
+                Completion(FUnrealMCPCommonUtils::CreateErrorResponse(PinError), {});
+                return;
             }
-            
-            if (bSuccess)
+
+            if (!Command->StreamingHandler)
             {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+                Command->AsyncHandler(Params, MoveTemp(Completion));
+                return;
             }
-            else
+
+            FUnrealMCPCommandProgress Progress;
+            if (OnProgress)
             {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+                // Subscriptions outlive the request, so the encoding is the one current when each message is sent
+                Progress = [CommandType, RequestId, OnProgress = MoveTemp(OnProgress)](TSharedPtr<FJsonObject> ResultJson, TArray<FUnrealMCPAttachment> Attachments)
+                {
+                    if (!ResultJson.IsValid())
+                    {
+                        return OnProgress(nullptr, {});
+                    }
+                    FMCPProgressEncoder Encode = [CommandType, RequestId, ResultJson, Listed = Attachments](EMCPEncoding Encoding)
+                    {
+                        return SerializeResponse(CommandType, ResultJson, RequestId, Encoding, Listed, true);
+                    };
+                    return OnProgress(MoveTemp(Encode), MoveTemp(Attachments));
+                };
             }
-        }
-        catch (const std::exception& e)
+            Command->StreamingHandler(Params, MoveTemp(Progress), MoveTemp(Completion));
+        });
+        return;
+    }
+
+    // Queue execution on Game Thread
+    Scheduler->Submit(Lane, ClientId, Command->IsReadOnly(), [this, CommandType, Params, RequestId, Encoding, ClientId, OnComplete = MoveTemp(OnComplete)](bool bRun) mutable
+    {
+        if (!bRun)
         {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+            OnComplete(SerializeResponse(CommandType, FUnrealMCPCommonUtils::CreateErrorResponse(ShutdownError), RequestId, Encoding), {});
+            return;
         }
-        
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
+        FUnrealMCPSubscriptions::FScopedClient ClientScope(ClientId);
+        OnComplete(ExecuteCommandInternal(CommandType, Params, RequestId, Encoding), {});
     });
-    
-    return Future.Get();
 }
 
-// For now, we'll keep the original command handler methods in place
-// They'll be eventually removed once we've fully migrated all functionality to the handlers
+bool UUnrealMCPBridge::IsReadOnlyCommand(const FString& CommandType) const
+{
+    const FUnrealMCPCommandInfo* Command = CommandRegistry->Find(CommandType);
+    return Command && Command->IsReadOnly();
+}
+
+// Handlers report failure as {"success": false, "error": ...}; anything else is a success
+static bool IsSuccessfulResult(const TSharedPtr<FJsonObject>& ResultJson, FString& OutErrorMessage)
+{
+    bool bSuccess = true;
+    if (ResultJson->TryGetBoolField(TEXT("success"), bSuccess) && !bSuccess)
+    {
+        ResultJson->TryGetStringField(TEXT("error"), OutErrorMessage);
+        return false;
+    }
+    return true;
+}
+
+// Run a command and serialize its response. Must run on the game thread unless the
+// command is known not to touch engine state.
+TArray<uint8> UUnrealMCPBridge::ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId,
+                                                       EMCPEncoding Encoding)
+{
+    TSharedPtr<FJsonObject> ResultJson;
+    try
+    {
+        ResultJson = DispatchCommand(CommandType, Params);
+    }
+    catch (const std::exception& e)
+    {
+        ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(UTF8_TO_TCHAR(e.what()));
+    }
+    TArray<uint8> Response = SerializeResponse(CommandType, ResultJson, RequestId, Encoding);
+    if (!FitsInFrames(Response, {}))
+    {
+        FMCPBufferPool::Release(MoveTemp(Response));
+        Response = SerializeResponse(CommandType, FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Result is too large to send")), RequestId, Encoding);
+    }
+    return Response;
+}
 
-// The original handler methods will be kept for the initial build test
-TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleActorCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+// Wrap a handler result in the {"status", "result" | "error"} envelope. Attachments are
+// listed at the top level so clients know how many bytes follow before reading the result.
+// Partial results of streaming commands are always "progress", whatever they contain.
+template <typename WriterType>
+static void WriteResponseEnvelope(WriterType& Writer, const FString& CommandType, const TSharedPtr<FJsonObject>& ResultJson, const TSharedPtr<FJsonValue>& RequestId,
+                                  const TArray<FUnrealMCPAttachment>& Attachments, bool bProgress)
 {
-    // This is a temporary pass-through to the new ActorCommands handler
-    return ActorCommands->HandleCommand(CommandType, Params);
+    Writer.BeginObject();
+
+    // Echo the client's request id so pipelined responses can be matched
+    if (RequestId.IsValid())
+    {
+        Writer.WriteKey(TEXT("id"));
+        Writer.WriteJsonValue(RequestId);
+    }
+
+    FString ErrorMessage;
+    if (bProgress && ResultJson.IsValid())
+    {
+        Writer.WriteField(TEXT("status"), TEXT("progress"));
+        Writer.WriteKey(TEXT("result"));
+        Writer.WriteJsonObject(ResultJson);
+    }
+    else if (!ResultJson.IsValid())
+    {
+        Writer.WriteField(TEXT("status"), TEXT("error"));
+        Writer.WriteField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+    }
+    else if (IsSuccessfulResult(ResultJson, ErrorMessage))
+    {
+        // Set success status and include the result
+        Writer.WriteField(TEXT("status"), TEXT("success"));
+        Writer.WriteKey(TEXT("result"));
+        Writer.WriteJsonObject(ResultJson);
+    }
+    else
+    {
+        // Set error status and include the error message
+        Writer.WriteField(TEXT("status"), TEXT("error"));
+        Writer.WriteField(TEXT("error"), ErrorMessage);
+    }
+
+    if (Attachments.Num() > 0)
+    {
+        Writer.WriteKey(TEXT("attachments"));
+        Writer.BeginArray();
+        for (const FUnrealMCPAttachment& Attachment : Attachments)
+        {
+            Writer.BeginObject();
+            Writer.WriteField(TEXT("name"), Attachment.Name);
+            Writer.WriteField(TEXT("content_type"), Attachment.ContentType);
+            Writer.WriteField(TEXT("size"), (double)Attachment.Data->Num());
+            Writer.EndObject();
+        }
+        Writer.EndArray();
+    }
+
+    Writer.EndObject();
 }
 
-TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleEditorCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+TArray<uint8> UUnrealMCPBridge::SerializeResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& ResultJson, const TSharedPtr<FJsonValue>& RequestId,
+                                                  EMCPEncoding Encoding, const TArray<FUnrealMCPAttachment>& Attachments, bool bProgress)
 {
-    // This is a temporary pass-through to the new EditorCommands handler
-    return EditorCommands->HandleCommand(CommandType, Params);
+    // Written straight from the result tree, splicing pre-serialized listings in as they are.
+    // The pooled buffer itself is the response; whoever sends it hands it back to the pool.
+    TArray<uint8> Buffer = FMCPBufferPool::Acquire();
+    if (Encoding == EMCPEncoding::Cbor)
+    {
+        FUnrealMCPCborWriter Writer(Buffer);
+        WriteResponseEnvelope(Writer, CommandType, ResultJson, RequestId, Attachments, bProgress);
+    }
+    else
+    {
+        FUnrealMCPJsonWriter Writer(Buffer);
+        WriteResponseEnvelope(Writer, CommandType, ResultJson, RequestId, Attachments, bProgress);
+    }
+    return Buffer;
 }
 
-TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBlueprintCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+// {"status": "busy"} for a request its lane had no room for. Clients should retry after retry_after_ms.
+TArray<uint8> UUnrealMCPBridge::SerializeBusyResponse(const TSharedPtr<FJsonValue>& RequestId, EMCPEncoding Encoding, EMCPRequestLane Lane, int32 RetryAfterMs)
 {
-    // This is a temporary pass-through to the new BlueprintCommands handler
-    return BlueprintCommands->HandleCommand(CommandType, Params);
+    TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+    if (RequestId.IsValid())
+    {
+        ResponseJson->SetField(TEXT("id"), RequestId);
+    }
+    ResponseJson->SetStringField(TEXT("status"), TEXT("busy"));
+    ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Server busy: the %s queue is full"), FMCPCommandScheduler::LaneToString(Lane)));
+    ResponseJson->SetStringField(TEXT("lane"), FMCPCommandScheduler::LaneToString(Lane));
+    ResponseJson->SetNumberField(TEXT("retry_after_ms"), RetryAfterMs);
+
+    TArray<uint8> Buffer = FMCPBufferPool::Acquire();
+    if (Encoding == EMCPEncoding::Cbor)
+    {
+        FUnrealMCPCborWriter Writer(Buffer);
+        Writer.WriteJsonObject(ResponseJson);
+    }
+    else
+    {
+        FUnrealMCPJsonWriter Writer(Buffer);
+        Writer.WriteJsonObject(ResponseJson);
+    }
+    return Buffer;
 }
 
-TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBlueprintNodeCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+// Route a command to its handler. Returns nullptr for unknown commands.
+TSharedPtr<FJsonObject> UUnrealMCPBridge::DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    // This is a temporary pass-through to the new BlueprintNodeCommands handler
-    return BlueprintNodeCommands->HandleCommand(CommandType, Params);
+    const FUnrealMCPCommandInfo* Command = CommandRegistry->Find(CommandType);
+    if (!Command)
+    {
+        return nullptr;
+    }
+    if (Command->IsAsync())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'%s' completes asynchronously and can't run inside a batch"), *CommandType));
+    }
+
+    TOptional<FUnrealMCPWorldResolver::FScopedPin> WorldPin;
+    FString PinError;
+    if (!PinRequestedWorld(Params, WorldPin, PinError))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(PinError);
+    }
+    return Command->Handler(Params);
 }
 
-TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleRenderingCommand(const FString &CommandType, const TSharedPtr<FJsonObject> &Params)
+// Run an ordered list of sub-commands inside the current game-thread task.
+// Params: {"commands": [{"type": ..., "params": {...}}, ...], "continue_on_error": false}
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBatchCommand(const TSharedPtr<FJsonObject>& Params)
 {
-	return RenderingCommands->HandleCommand(CommandType, Params);
+    const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+    if (!Params->TryGetArrayField(TEXT("commands"), Commands))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'commands' parameter"));
+    }
+
+    bool bContinueOnError = false;
+    Params->TryGetBoolField(TEXT("continue_on_error"), bContinueOnError);
+
+    // Actor lookups are resolved once and shared by every sub-command
+    FUnrealMCPCommandContext BatchContext;
+    // Property writes rebuild each touched actor once, after the last sub-command
+    FUnrealMCPConstructionScripts::FScope ConstructionScope;
+
+    TArray<TSharedPtr<FJsonValue>> Results;
+    Results.Reserve(Commands->Num());
+    int32 FailedCount = 0;
+    bool bStoppedEarly = false;
+
+    for (int32 Index = 0; Index < Commands->Num(); ++Index)
+    {
+        TSharedPtr<FJsonObject> EntryJson = MakeShared<FJsonObject>();
+        EntryJson->SetNumberField(TEXT("index"), Index);
+
+        const TSharedPtr<FJsonObject>* CommandObject = nullptr;
+        FString SubCommandType;
+        TSharedPtr<FJsonObject> ResultJson;
+        FString ErrorMessage;
+
+        if (!(*Commands)[Index]->TryGetObject(CommandObject) || !(*CommandObject)->TryGetStringField(TEXT("type"), SubCommandType))
+        {
+            ErrorMessage = TEXT("Batch entry must be an object with a 'type' field");
+        }
+        else if (SubCommandType == TEXT("batch"))
+        {
+            ErrorMessage = TEXT("Nested batch commands are not supported");
+        }
+        else
+        {
+            TSharedPtr<FJsonObject> SubParams = MakeShared<FJsonObject>();
+            const TSharedPtr<FJsonObject>* SubParamsObject = nullptr;
+            if ((*CommandObject)->TryGetObjectField(TEXT("params"), SubParamsObject))
+            {
+                SubParams = *SubParamsObject;
+            }
+
+            ResultJson = DispatchCommand(SubCommandType, SubParams);
+            if (!ResultJson.IsValid())
+            {
+                ErrorMessage = FString::Printf(TEXT("Unknown command: %s"), *SubCommandType);
+            }
+            else if (!IsSuccessfulResult(ResultJson, ErrorMessage))
+            {
+                ResultJson.Reset();
+            }
+        }
+
+        EntryJson->SetStringField(TEXT("type"), SubCommandType);
+        if (ResultJson.IsValid())
+        {
+            EntryJson->SetStringField(TEXT("status"), TEXT("success"));
+            EntryJson->SetObjectField(TEXT("result"), ResultJson);
+        }
+        else
+        {
+            EntryJson->SetStringField(TEXT("status"), TEXT("error"));
+            EntryJson->SetStringField(TEXT("error"), ErrorMessage);
+            ++FailedCount;
+        }
+        Results.Add(MakeShared<FJsonValueObject>(EntryJson));
+
+        if (!ResultJson.IsValid() && !bContinueOnError)
+        {
+            bStoppedEarly = Index + 1 < Commands->Num();
+            break;
+        }
+    }
+
+    ConstructionScope.Flush();
+
+    TSharedPtr<FJsonObject> BatchResult = MakeShared<FJsonObject>();
+    BatchResult->SetArrayField(TEXT("results"), Results);
+    BatchResult->SetNumberField(TEXT("total"), Commands->Num());
+    BatchResult->SetNumberField(TEXT("executed"), Results.Num());
+    BatchResult->SetNumberField(TEXT("failed"), FailedCount);
+    BatchResult->SetBoolField(TEXT("all_succeeded"), FailedCount == 0 && Results.Num() == Commands->Num());
+    BatchResult->SetBoolField(TEXT("stopped_early"), bStoppedEarly);
+    BatchResult->SetNumberField(TEXT("construction_script_reruns"), ConstructionScope.GetReruns());
+    BatchResult->SetNumberField(TEXT("construction_script_reruns_saved"), ConstructionScope.GetSaved());
+    return BatchResult;
 }
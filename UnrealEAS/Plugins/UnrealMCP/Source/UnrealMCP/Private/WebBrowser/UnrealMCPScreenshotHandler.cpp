@@ -96,22 +96,28 @@ void UUnrealMCPScreenshotHandler::CaptureScreenshot(const FString& Prompt, float
     Params->SetBoolField(TEXT("include_ui"), false);
     Params->SetStringField(TEXT("filename"), FPaths::GetBaseFilename(LastScreenshotPath));
     
-    // Execute the screenshot command
-    TSharedPtr<FJsonObject> Result = RenderingCommands->HandleCommand(TEXT("take_highresshot"), Params);
-    
-    if (Result.IsValid())
+    // Execute the screenshot command; the callback runs once the file is on disk
+    TWeakObjectPtr<UUnrealMCPScreenshotHandler> WeakThis(this);
+    RenderingCommands->HandleTakeHighResShot(Params, [WeakThis](TSharedPtr<FJsonObject> Result, TArray<FUnrealMCPAttachment> Attachments)
     {
+        UUnrealMCPScreenshotHandler* Handler = WeakThis.Get();
+        if (!Handler || !Result.IsValid())
+        {
+            return;
+        }
+
         bool bSuccess = false;
         Result->TryGetBoolField(TEXT("success"), bSuccess);
         
         if (bSuccess)
         {
-            UE_LOG(LogTemp, Log, TEXT("UUnrealMCPScreenshotHandler: Screenshot captured successfully"));
+            Result->TryGetStringField(TEXT("path"), Handler->LastScreenshotPath);
+            UE_LOG(LogTemp, Log, TEXT("UUnrealMCPScreenshotHandler: Screenshot captured successfully: %s"), *Handler->LastScreenshotPath);
             
             // Notify web bridge about the screenshot
-            if (WebBridge)
+            if (Handler->WebBridge)
             {
-                WebBridge->NotifyScreenshotCaptured(LastScreenshotPath);
+                Handler->WebBridge->NotifyScreenshotCaptured(Handler->LastScreenshotPath);
             }
         }
         else
@@ -120,7 +126,7 @@ void UUnrealMCPScreenshotHandler::CaptureScreenshot(const FString& Prompt, float
             Result->TryGetStringField(TEXT("error"), ErrorMessage);
             UE_LOG(LogTemp, Error, TEXT("UUnrealMCPScreenshotHandler: Screenshot failed: %s"), *ErrorMessage);
         }
-    }
+    });
 }
 
 FString UUnrealMCPScreenshotHandler::GenerateScreenshotFilename()
@@ -2,9 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 
+class FUnrealMCPSpatialIndex;
+
 /**
  * Handler class for Actor-related MCP commands
  */
@@ -12,22 +15,42 @@ class UNREALMCP_API FUnrealMCPActorCommands
 {
 public:
     FUnrealMCPActorCommands();
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Add this handler's commands to the registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     // Specific actor command handlers
     TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params);
+    void HandleStreamActorsInLevel(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete);
     TSharedPtr<FJsonObject> HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleGetSceneDelta(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleCreateActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params);
 
+	// Spatial queries over the actor index's octree
+	TSharedPtr<FJsonObject> HandleSelectVisibleActors(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleGetCharacterActors(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleQueryActorsInRadius(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleQueryActorsInFrustum(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleRaycast(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> QueryActorsInView(const TSharedPtr<FJsonObject>& Params, bool bVisibleOnly);
+	void QuerySpatialIndex(UWorld* World, TFunctionRef<void(const FUnrealMCPSpatialIndex&)> Query);
+
 	// to do : how to get REAL current world in cinev from source code
 	UWorld* GetCurrentWorld();
 	AActor* FindActorByClassName(const FString& ClassName);
-	bool GetDoublePropertyValue(AActor* Actor, const FName& PropertyName, float& OutValue);
-	bool UpdateDoubleProperty(AActor* SkyActor, const FName& PropertyName, float NewValue);
+	// Actor index lookups, falling back to a world walk when the index isn't available
+	AActor* FindActorByName(UWorld* World, const FString& ActorName);
+	void FindActorsWithTag(UWorld* World, const FName& Tag, TArray<AActor*>& OutActors);
+	bool GetDoublePropertyValue(AActor* Actor, const FName& PropertyName, double& OutValue);
+	bool UpdateDoubleProperty(AActor* SkyActor, const FName& PropertyName, double NewValue);
+
+	// Generic reflected property access through the cached bindings
+	AActor* FindPropertyTarget(const TSharedPtr<FJsonObject>& Params, FString& OutError);
+	TSharedPtr<FJsonObject> HandleGetProperties(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleSetProperties(const TSharedPtr<FJsonObject>& Params);
 
     // Ultra Dynamic Sky specific commands
 	AActor* GetUltraDynamicSkyActor();
@@ -43,6 +66,14 @@ private:
     TSharedPtr<FJsonObject> HandleGetCesiumProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetCesiumLatitudeLongitude(const TSharedPtr<FJsonObject>& Params);
 
+	// Server-side sweeps of the sky, georeference or any numeric property
+	void HandleAnimateProperty(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete);
+	TSharedPtr<FJsonObject> HandleStopAnimation(const TSharedPtr<FJsonObject>& Params);
+
+	// Per-frame change notifications for actor transforms and properties
+	void HandleSubscribe(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete);
+	TSharedPtr<FJsonObject> HandleUnsubscribe(const TSharedPtr<FJsonObject>& Params);
+
 	// Add Light Commands Create Read Update Delete
 	TSharedPtr<FJsonObject> HandleCreateMMControlLight(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleGetMMControlLights(const TSharedPtr<FJsonObject>& Params);
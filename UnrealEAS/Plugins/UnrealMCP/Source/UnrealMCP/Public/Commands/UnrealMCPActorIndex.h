@@ -0,0 +1,169 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Commands/UnrealMCPSpatialIndex.h"
+#include "UnrealMCPActorIndex.generated.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+struct FPropertyChangedEvent;
+
+/** An actor and the scene generation it last changed at. */
+struct FUnrealMCPVersionedActor
+{
+	AActor* Actor = nullptr;
+	uint64 Version = 0;
+};
+
+/** What happened in a world after some scene generation. */
+struct FUnrealMCPSceneDelta
+{
+	/** The generation the delta runs up to; pass it as the next query's Since. */
+	uint64 Generation = 0;
+	/** Since was too old to diff against (or 0). Spawned then holds every actor and Deleted is empty. */
+	bool bReset = false;
+	TArray<FUnrealMCPVersionedActor> Spawned;
+	TArray<FUnrealMCPVersionedActor> Changed;
+	TArray<FName> Deleted;
+};
+
+/**
+ * Name, class and tag lookups for the actors of a world without walking it.
+ *
+ * Each world is indexed with one full pass the first time it is queried and kept
+ * up to date from spawn, destroy and level add/remove notifications after that.
+ * Undo/redo and level streaming changes we can't follow precisely mark the index
+ * dirty so the next query rebuilds it. Tags and names are read when an actor is
+ * indexed; call ReindexActor after changing either.
+ *
+ * The spatial index is built separately, on the first spatial query, since it has to
+ * gather every actor's bounds. Editor moves update it automatically; call
+ * UpdateActorBounds after moving an actor from code.
+ *
+ * Every spawn, delete and change also advances a scene generation shared by all
+ * worlds, and each indexed actor is stamped with the generation it was spawned and
+ * last changed at, so clients can sync with GetSceneDelta instead of relisting.
+ *
+ * Game thread only.
+ */
+UCLASS()
+class UNREALMCP_API UUnrealMCPActorIndex : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** nullptr outside the editor. */
+	static UUnrealMCPActorIndex* Get();
+
+	AActor* FindActorByName(UWorld* World, FName Name);
+
+	/** Exact class match on the class name (e.g. "Ultra_Dynamic_Sky_C"), subclasses excluded. */
+	AActor* FindFirstActorOfClass(UWorld* World, FName ClassName);
+	void FindActorsOfClass(UWorld* World, FName ClassName, TArray<AActor*>& OutActors);
+
+	void FindActorsWithTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors);
+
+	void ReindexActor(AActor* Actor);
+
+	/** The world's octree of actor bounds, built on first use. */
+	FUnrealMCPSpatialIndex* GetSpatialIndex(UWorld* World);
+
+	/** Also marks the actor changed. */
+	void UpdateActorBounds(AActor* Actor);
+
+	/** Stamps Actor with a new generation. Editor property edits are picked up without it. */
+	void MarkActorChanged(AActor* Actor);
+
+	/** The current scene generation. Builds World's index first, so the number is one GetSceneDelta can diff against. */
+	uint64 GetGeneration(UWorld* World);
+
+	/**
+	 * Fills OutDelta with the actors of World spawned, changed or deleted after generation
+	 * Since. Transforms and visibility are rechecked first, so moves made from code or
+	 * in a game world are caught without a notification. Returns false without an index.
+	 */
+	bool GetSceneDelta(UWorld* World, uint64 Since, FUnrealMCPSceneDelta& OutDelta);
+
+	/** Forces the next query on World (or every world when null) to rebuild its index. */
+	void Invalidate(UWorld* World = nullptr);
+
+private:
+	/** What an actor was filed under, so it can be removed after its name or tags change. */
+	struct FEntry
+	{
+		FName Name;
+		FName ClassName;
+		TArray<FName> Tags;
+		uint64 SpawnVersion = 0;
+		uint64 Version = 0;
+		/** Transform and visibility when last stamped. */
+		uint32 Fingerprint = 0;
+	};
+
+	struct FTombstone
+	{
+		FName Name;
+		uint64 Generation = 0;
+	};
+
+	/** Deletions remembered per world; older ones force a client reset. */
+	static constexpr int32 MaxTombstones = 8192;
+
+	using FBuckets = TMap<FName, TArray<TWeakObjectPtr<AActor>>>;
+
+	struct FWorldIndex
+	{
+		TWeakObjectPtr<UWorld> World;
+		FBuckets ByName;
+		FBuckets ByClass;
+		FBuckets ByTag;
+		TMap<TObjectKey<AActor>, FEntry> Entries;
+		TUniquePtr<FUnrealMCPSpatialIndex> Spatial;
+		FDelegateHandle SpawnedHandle;
+		FDelegateHandle DestroyedHandle;
+		bool bDirty = true;
+		/** Generation after the first build; nothing earlier can be diffed against. */
+		uint64 BaseGeneration = 0;
+		/** Generation of the newest tombstone dropped to stay under MaxTombstones. */
+		uint64 TombstoneFloor = 0;
+		TArray<FTombstone> Tombstones;
+	};
+
+	FWorldIndex* GetIndex(UWorld* World);
+	void Rebuild(FWorldIndex& Index);
+	void ReleaseIndex(UWorld* World);
+
+	void AddActor(FWorldIndex& Index, AActor* Actor);
+	/** bDeleted records a tombstone; reindexing removes and re-adds without one. */
+	void RemoveActor(FWorldIndex& Index, AActor* Actor, bool bDeleted = true);
+	void AddTombstone(FWorldIndex& Index, FName Name);
+	static uint32 Fingerprint(const AActor* Actor);
+	static AActor* FirstValid(FBuckets& Buckets, FName Key);
+
+	void HandleActorAdded(AActor* Actor);
+	void HandleActorRemoved(AActor* Actor);
+	void HandleActorMoved(AActor* Actor);
+	void HandleLevelAdded(ULevel* Level, UWorld* World);
+	void HandleLevelRemoved(ULevel* Level, UWorld* World);
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void HandleUndoRedo();
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+
+	TMap<TObjectKey<UWorld>, TUniquePtr<FWorldIndex>> Indices;
+	uint64 SceneGeneration = 0;
+
+	FDelegateHandle LevelActorAddedHandle;
+	FDelegateHandle LevelActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle UndoRedoHandle;
+	FDelegateHandle PropertyChangedHandle;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "Containers/Ticker.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "Commands/UnrealMCPJsonWriter.h"
+
+class AActor;
+class UWorld;
+
+/** Per-actor fields a listing can return. */
+enum class EUnrealMCPActorFields : uint16
+{
+	None = 0,
+	Name = 1 << 0,
+	Class = 1 << 1,
+	Location = 1 << 2,
+	Rotation = 1 << 3,
+	Scale = 1 << 4,
+	Tags = 1 << 5,
+	Label = 1 << 6,
+	Level = 1 << 7,
+
+	/** What get_actors_in_level has always returned. */
+	Default = Name | Class | Location | Rotation | Scale,
+};
+ENUM_CLASS_FLAGS(EUnrealMCPActorFields)
+
+/**
+ * Position in a world's actor list: an index into UWorld::GetLevels() and into that
+ * level's Actors array. Both only grow while the level set is unchanged (deleted
+ * actors leave null slots), so a cursor stays valid between pages; streaming a
+ * level in or out mid-listing can skip or repeat actors.
+ */
+struct FUnrealMCPActorCursor
+{
+	int32 Level = 0;
+	int32 Actor = 0;
+
+	FString ToString() const;
+	static bool Parse(const FString& Text, FUnrealMCPActorCursor& OutCursor);
+};
+
+/** Filters, projection and paging for actor listings, parsed from command params. */
+struct UNREALMCP_API FUnrealMCPActorQuery
+{
+	EUnrealMCPActorFields Fields = EUnrealMCPActorFields::Default;
+
+	/** Exact class name, e.g. "StaticMeshActor". Subclasses don't match. */
+	FName ClassName;
+	FName Tag;
+	/** Set when the class or tag names no existing FName, so no actor can match. */
+	bool bMatchesNothing = false;
+	/** Matches actors whose location lies inside the box. */
+	TOptional<FBox> Bounds;
+
+	/** Maximum actors per page; 0 returns every match at once. */
+	int32 Limit = 0;
+	FUnrealMCPActorCursor Cursor;
+
+	/** Reads "fields", "class", "tag", "bounds", "limit" and "cursor". */
+	static bool Parse(const TSharedPtr<FJsonObject>& Params, FUnrealMCPActorQuery& OutQuery, FString& OutError);
+
+	bool Matches(const AActor* Actor) const;
+
+	/** Writes the selected fields of one actor as an object. */
+	void Write(FUnrealMCPJsonWriter& Writer, const AActor* Actor) const;
+
+	/** Writes the selected fields into an object the caller has opened, so it can add its own. */
+	void WriteFields(FUnrealMCPJsonWriter& Writer, const AActor* Actor) const;
+
+	/**
+	 * Writes matches from InOutCursor on as array elements, stopping after MaxActors (0 = no limit).
+	 * Returns true if the walk stopped early, with InOutCursor at the next unvisited actor.
+	 */
+	bool CollectPage(UWorld* World, FUnrealMCPActorCursor& InOutCursor, int32 MaxActors, FUnrealMCPJsonWriter& Writer, int32& OutCount) const;
+};
+
+/**
+ * Lists a world's actors one page per engine tick, sending each page as progress so a
+ * large level never stalls the game thread for more than one page. Without a progress
+ * listener the pages are gathered into the final response instead.
+ */
+class UNREALMCP_API FUnrealMCPActorStream : public TSharedFromThis<FUnrealMCPActorStream>
+{
+public:
+	static constexpr int32 DefaultPageSize = 1000;
+	static constexpr int32 MaxPageSize = 10000;
+
+	static void Start(UWorld* World, const FUnrealMCPActorQuery& Query, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete);
+
+	FUnrealMCPActorStream(UWorld* InWorld, const FUnrealMCPActorQuery& InQuery, FUnrealMCPCommandProgress InOnProgress, FUnrealMCPCommandCompletion InOnComplete);
+
+private:
+	bool Tick(float DeltaTime);
+
+	TWeakObjectPtr<UWorld> World;
+	FUnrealMCPActorQuery Query;
+	FUnrealMCPCommandProgress OnProgress;
+	FUnrealMCPCommandCompletion OnComplete;
+
+	FUnrealMCPActorCursor Cursor;
+	int32 Pages = 0;
+	int32 Total = 0;
+	double GameThreadSeconds = 0.0;
+	double StartTime = 0.0;
+
+	/** Every page as one array, when nobody is listening for progress. */
+	TArray<uint8> Gathered;
+	FUnrealMCPJsonWriter GatheredWriter;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FUnrealMCPCommandRegistry;
+
 /**
  * Handler class for Blueprint-related MCP commands
  */
@@ -11,8 +13,8 @@ class UNREALMCP_API FUnrealMCPBlueprintCommands
 public:
     FUnrealMCPBlueprintCommands();
 
-    // Handle blueprint commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Add this handler's commands to the registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     // Specific blueprint command handlers
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+/**
+ * Appends CBOR (RFC 8949) to a caller-owned buffer, with the same interface as
+ * FUnrealMCPJsonWriter so either can write a response.
+ *
+ * Objects and arrays use indefinite lengths, so nothing has to be counted up front.
+ * Integral numbers are written as integers and doubles that survive a round trip
+ * through float as 4-byte floats, which covers most transforms.
+ */
+class UNREALMCP_API FUnrealMCPCborWriter
+{
+public:
+	explicit FUnrealMCPCborWriter(TArray<uint8>& InBuffer);
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	void WriteKey(FStringView Key);
+
+	void WriteValue(FStringView Value);
+	void WriteValue(const TCHAR* Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(const FString& Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(double Value);
+	void WriteValue(int32 Value) { WriteValue((int64)Value); }
+	void WriteValue(int64 Value);
+	void WriteValue(bool bValue);
+	void WriteNull();
+
+	void WriteVector(double X, double Y, double Z);
+
+	/** Transcodes serialized JSON (e.g. a listing written by FUnrealMCPJsonWriter) as one value. */
+	void WriteRaw(TConstArrayView<uint8> Json);
+
+	/** Encodes a DOM value, including any FUnrealMCPJsonValueRaw inside it. */
+	void WriteJsonValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteJsonObject(const TSharedPtr<FJsonObject>& Object);
+
+	template <typename ValueType>
+	void WriteField(FStringView Key, ValueType&& Value)
+	{
+		WriteKey(Key);
+		WriteValue(Forward<ValueType>(Value));
+	}
+
+private:
+	void WriteHead(uint8 MajorType, uint64 Argument);
+	void WriteUtf8(const uint8* Text, int32 Length);
+
+	TArray<uint8>& Buffer;
+};
+
+/** Decodes CBOR requests into the DOM the command handlers take. */
+class UNREALMCP_API FUnrealMCPCborReader
+{
+public:
+	/** Top-level map to object. Byte strings and non-text map keys are rejected. */
+	static bool ReadObject(TConstArrayView<uint8> Data, TSharedPtr<FJsonObject>& OutObject, FString& OutError);
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Game-thread scope that lets a group of commands share lookups.
+ * While an instance is alive (e.g. for the duration of a batch), actors found
+ * by class name are reused instead of being searched for again by every
+ * command. Only successful lookups are remembered.
+ */
+class UNREALMCP_API FUnrealMCPCommandContext
+{
+public:
+	FUnrealMCPCommandContext();
+	~FUnrealMCPCommandContext();
+
+	FUnrealMCPCommandContext(const FUnrealMCPCommandContext&) = delete;
+	FUnrealMCPCommandContext& operator=(const FUnrealMCPCommandContext&) = delete;
+
+	/** The innermost active context, or nullptr outside of a scope. */
+	static FUnrealMCPCommandContext* Get();
+
+	AActor* GetCachedActorByClass(const FString& ClassName) const;
+	void SetCachedActorByClass(const FString& ClassName, AActor* Actor);
+
+private:
+	FUnrealMCPCommandContext* Outer;
+	TMap<FString, TWeakObjectPtr<AActor>> ActorsByClass;
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+/** Behaviour flags the server uses to schedule a command. */
+enum class EUnrealMCPCommandFlags : uint8
+{
+	None = 0,
+	/** Never modifies editor or world state; may overlap with other read-only requests. */
+	ReadOnly = 1 << 0,
+	/** Does not touch UObjects, so it can be answered on the connection thread. */
+	AnyThread = 1 << 1,
+};
+ENUM_CLASS_FLAGS(EUnrealMCPCommandFlags)
+
+/** Rough game-thread cost of a command. */
+enum class EUnrealMCPCommandCost : uint8
+{
+	Low,		// constant-time lookups and property edits
+	Medium,		// walks the level or a blueprint graph
+	High,		// rendering, compiling or disk I/O
+};
+
+using FUnrealMCPCommandHandler = TFunction<TSharedPtr<FJsonObject>(const TSharedPtr<FJsonObject>&)>;
+
+/**
+ * Binary payload sent on the connection right after the JSON response that lists it,
+ * so large blobs such as encoded images never go through JSON or base64.
+ */
+struct FUnrealMCPAttachment
+{
+	FString Name;
+	FString ContentType;
+	TSharedPtr<const TArray64<uint8>, ESPMode::ThreadSafe> Data;
+};
+
+/** Receives the result of an asynchronous command. Must be called exactly once, from any thread. */
+using FUnrealMCPCommandCompletion = TUniqueFunction<void(TSharedPtr<FJsonObject>, TArray<FUnrealMCPAttachment>)>;
+
+/** Starts on the game thread and completes later, e.g. once a frame has been rendered. */
+using FUnrealMCPAsyncCommandHandler = TFunction<void(const TSharedPtr<FJsonObject>&, FUnrealMCPCommandCompletion)>;
+
+/**
+ * Sends a partial result ahead of the final response. May be called from any thread, any
+ * number of times. Returns false once the requesting client can no longer receive it.
+ * Subscriptions keep calling it after completion to push notifications under the same id.
+ * A null result sends nothing and only checks that the client is still there.
+ */
+using FUnrealMCPCommandProgress = TFunction<bool(TSharedPtr<FJsonObject>, TArray<FUnrealMCPAttachment>)>;
+
+/**
+ * An async handler that can also stream partial results. OnProgress is unset when the
+ * caller has no way to receive them, in which case the final result must stand alone.
+ */
+using FUnrealMCPStreamingCommandHandler = TFunction<void(const TSharedPtr<FJsonObject>&, FUnrealMCPCommandProgress, FUnrealMCPCommandCompletion)>;
+
+struct FUnrealMCPCommandInfo
+{
+	FName Name;
+	FUnrealMCPCommandHandler Handler;
+	FUnrealMCPAsyncCommandHandler AsyncHandler;
+	FUnrealMCPStreamingCommandHandler StreamingHandler;
+	EUnrealMCPCommandFlags Flags = EUnrealMCPCommandFlags::None;
+	EUnrealMCPCommandCost Cost = EUnrealMCPCommandCost::Low;
+
+	bool IsReadOnly() const { return EnumHasAnyFlags(Flags, EUnrealMCPCommandFlags::ReadOnly); }
+	bool RequiresGameThread() const { return !EnumHasAnyFlags(Flags, EUnrealMCPCommandFlags::AnyThread); }
+	bool IsAsync() const { return (bool)AsyncHandler || (bool)StreamingHandler; }
+};
+
+/**
+ * Maps command names to their handlers and scheduling metadata with a single
+ * FName lookup. Filled once while the bridge initializes and read-only after
+ * that, so it can be queried from connection threads without locking.
+ */
+class UNREALMCP_API FUnrealMCPCommandRegistry
+{
+public:
+	void Register(FName Name, FUnrealMCPCommandHandler Handler,
+	              EUnrealMCPCommandFlags Flags = EUnrealMCPCommandFlags::None,
+	              EUnrealMCPCommandCost Cost = EUnrealMCPCommandCost::Low);
+
+	/** Registers a member function of a handler object that outlives the registry. */
+	template <typename HandlerType>
+	void Register(FName Name, HandlerType* Owner, TSharedPtr<FJsonObject> (HandlerType::*Method)(const TSharedPtr<FJsonObject>&),
+	              EUnrealMCPCommandFlags Flags = EUnrealMCPCommandFlags::None,
+	              EUnrealMCPCommandCost Cost = EUnrealMCPCommandCost::Low)
+	{
+		Register(Name, [Owner, Method](const TSharedPtr<FJsonObject>& Params) { return (Owner->*Method)(Params); }, Flags, Cost);
+	}
+
+	void RegisterAsync(FName Name, FUnrealMCPAsyncCommandHandler Handler,
+	                   EUnrealMCPCommandFlags Flags = EUnrealMCPCommandFlags::None,
+	                   EUnrealMCPCommandCost Cost = EUnrealMCPCommandCost::Low);
+
+	template <typename HandlerType>
+	void RegisterAsync(FName Name, HandlerType* Owner, void (HandlerType::*Method)(const TSharedPtr<FJsonObject>&, FUnrealMCPCommandCompletion),
+	                   EUnrealMCPCommandFlags Flags = EUnrealMCPCommandFlags::None,
+	                   EUnrealMCPCommandCost Cost = EUnrealMCPCommandCost::Low)
+	{
+		RegisterAsync(Name, [Owner, Method](const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandCompletion OnComplete)
+		{
+			(Owner->*Method)(Params, MoveTemp(OnComplete));
+		}, Flags, Cost);
+	}
+
+	void RegisterStreaming(FName Name, FUnrealMCPStreamingCommandHandler Handler,
+	                       EUnrealMCPCommandFlags Flags = EUnrealMCPCommandFlags::None,
+	                       EUnrealMCPCommandCost Cost = EUnrealMCPCommandCost::Low);
+
+	template <typename HandlerType>
+	void RegisterStreaming(FName Name, HandlerType* Owner,
+	                       void (HandlerType::*Method)(const TSharedPtr<FJsonObject>&, FUnrealMCPCommandProgress, FUnrealMCPCommandCompletion),
+	                       EUnrealMCPCommandFlags Flags = EUnrealMCPCommandFlags::None,
+	                       EUnrealMCPCommandCost Cost = EUnrealMCPCommandCost::Low)
+	{
+		RegisterStreaming(Name, [Owner, Method](const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete)
+		{
+			(Owner->*Method)(Params, MoveTemp(OnProgress), MoveTemp(OnComplete));
+		}, Flags, Cost);
+	}
+
+	/** Returns nullptr for unknown commands. Names compare case-insensitively, like FString. */
+	const FUnrealMCPCommandInfo* Find(const FString& CommandType) const;
+	const FUnrealMCPCommandInfo* Find(FName Name) const { return Commands.Find(Name); }
+
+	int32 Num() const { return Commands.Num(); }
+
+private:
+	FUnrealMCPCommandInfo& Add(FName Name, EUnrealMCPCommandFlags Flags, EUnrealMCPCommandCost Cost);
+
+	TMap<FName, FUnrealMCPCommandInfo> Commands;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+
+/**
+ * Coalesces RerunConstructionScripts calls made after property writes.
+ *
+ * Writers mark their actor dirty instead of rebuilding it on the spot. Dirty actors are
+ * rebuilt once when the outermost FScope ends (a batch opens one), or on the next engine
+ * tick for writes made outside a scope, so every write that lands on an actor in the
+ * same batch or frame shares a single rebuild.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPConstructionScripts
+{
+public:
+	static FUnrealMCPConstructionScripts& Get();
+
+	/** Schedules a rebuild of Actor. Returns false when one was already pending. */
+	bool Request(AActor* Actor);
+
+	/** Rebuilds every pending actor now and returns how many were rerun. */
+	int32 Flush();
+
+	int32 NumPending() const { return Pending.Num(); }
+
+	/** Drops pending rebuilds and removes the tick. */
+	void Shutdown();
+
+	/** Holds rebuilds back until the outermost scope ends, and counts the work saved inside it. */
+	class UNREALMCP_API FScope
+	{
+	public:
+		FScope();
+		~FScope();
+
+		UE_NONCOPYABLE(FScope);
+
+		/** Rebuilds now if this is the outermost scope; later requests still wait for the end. */
+		void Flush();
+
+		int32 GetRequests() const;
+		int32 GetReruns() const;
+		int32 GetSaved() const { return FMath::Max(0, GetRequests() - GetReruns()); }
+
+	private:
+		int32 StartRequests;
+		int32 StartReruns;
+	};
+
+private:
+	bool Tick(float DeltaTime);
+
+	TMap<TObjectKey<AActor>, TWeakObjectPtr<AActor>> Pending;
+	FTSTicker::FDelegateHandle TickerHandle;
+	int32 ScopeDepth = 0;
+	int32 TotalRequests = 0;
+	int32 TotalReruns = 0;
+};
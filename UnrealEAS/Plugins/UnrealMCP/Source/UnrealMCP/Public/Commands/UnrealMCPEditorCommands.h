@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 
 /**
  * Handler class for Editor-related MCP commands
@@ -11,11 +12,11 @@ class UNREALMCP_API FUnrealMCPEditorCommands
 public:
     FUnrealMCPEditorCommands();
 
-    // Handle editor commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Add this handler's commands to the registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     // Specific editor command handlers
     TSharedPtr<FJsonObject> HandleFocusViewport(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params);
+    void HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandCompletion OnComplete);
 }; 
\ No newline at end of file
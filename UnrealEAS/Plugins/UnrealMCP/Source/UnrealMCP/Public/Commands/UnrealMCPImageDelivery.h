@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+
+/** How an encoded image reaches the client. */
+enum class EUnrealMCPImageDelivery : uint8
+{
+	/** Written to disk; the response carries the path (default). */
+	File,
+	/** Sent as a binary attachment right after the JSON response. */
+	Inline,
+	/** Copied into a named shared-memory region the client maps. */
+	SharedMemory
+};
+
+/**
+ * Hands encoded images to clients without assuming a disk round-trip.
+ * Shared-memory regions stay mapped until the client releases them with
+ * release_shared_memory, or until enough newer regions push them out.
+ */
+class UNREALMCP_API FUnrealMCPImageDelivery
+{
+public:
+	/** Reads the optional "delivery" parameter: "file", "inline" or "shared_memory". */
+	static bool ParseDelivery(const TSharedPtr<FJsonObject>& Params, EUnrealMCPImageDelivery& OutDelivery, FString& OutError);
+
+	/**
+	 * Delivers Encoded and describes where it went in Result. Path is only used for File delivery.
+	 * Safe to call from worker threads.
+	 */
+	static bool Deliver(EUnrealMCPImageDelivery Delivery, const FString& Path, const FString& ContentType, TArray64<uint8>&& Encoded,
+	                    const TSharedPtr<FJsonObject>& Result, TArray<FUnrealMCPAttachment>& OutAttachments, FString& OutError);
+
+	/** 'release_shared_memory' command: {"name": ...} */
+	static TSharedPtr<FJsonObject> HandleReleaseSharedMemory(const TSharedPtr<FJsonObject>& Params);
+
+	static bool ReleaseSharedMemory(const FString& Name);
+	static void ReleaseAllSharedMemory();
+
+	/** Oldest regions are unmapped once more than this many are alive. */
+	static constexpr int32 MaxSharedMemoryRegions = 8;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+enum class EUnrealMCPImageFormat : uint8
+{
+	Png,
+	Jpeg,
+	WebP
+};
+
+struct FUnrealMCPImageEncodeSettings
+{
+	EUnrealMCPImageFormat Format = EUnrealMCPImageFormat::Png;
+
+	/** PNG: zlib level 0-9. JPEG/WebP: 1-100. -1 uses the format's default. */
+	int32 Quality = -1;
+
+	/** WebP only; PNG is always lossless and JPEG never is. */
+	bool bLossless = true;
+};
+
+/**
+ * Encodes viewport readbacks through the engine's ImageWrapper module.
+ * Load() must have run on the game thread; after that Encode() is safe to
+ * call from worker threads.
+ */
+class UNREALMCP_API FUnrealMCPImageEncoder
+{
+public:
+	/** Reads the optional "format" ("png", "jpeg", "webp"), "quality" and "lossless" parameters. */
+	static bool ParseSettings(const TSharedPtr<FJsonObject>& Params, FUnrealMCPImageEncodeSettings& OutSettings, FString& OutError);
+
+	static const TCHAR* GetExtension(EUnrealMCPImageFormat Format);
+	static const TCHAR* GetContentType(EUnrealMCPImageFormat Format);
+
+	/** Loads ImageWrapper. Game thread only. */
+	static void Load();
+
+	/** Encodes 8-bit BGRA pixels. Alpha is forced opaque since viewport readbacks leave it undefined. */
+	static bool Encode(const FUnrealMCPImageEncodeSettings& Settings, int32 Width, int32 Height, TArray<FColor>& Pixels,
+	                   TArray64<uint8>& OutEncoded, FString& OutError);
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+/**
+ * Appends compact JSON as UTF-8 to a caller-owned buffer.
+ *
+ * Nothing is allocated per value beyond buffer growth, so listings can be written
+ * directly from engine data instead of building an FJsonObject tree first. Commas
+ * and key separators are inserted automatically; the caller is responsible for
+ * balancing Begin/End calls. Output matches TCondensedJsonPrintPolicy byte for byte
+ * for the same values.
+ */
+class UNREALMCP_API FUnrealMCPJsonWriter
+{
+public:
+	explicit FUnrealMCPJsonWriter(TArray<uint8>& InBuffer);
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	void WriteKey(FStringView Key);
+
+	void WriteValue(FStringView Value);
+	void WriteValue(const TCHAR* Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(const FString& Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(double Value);
+	void WriteValue(int32 Value) { WriteValue((int64)Value); }
+	void WriteValue(int64 Value);
+	void WriteValue(bool bValue);
+	void WriteNull();
+
+	/** [X, Y, Z], the layout ActorToJson uses for vectors and rotators. */
+	void WriteVector(double X, double Y, double Z);
+
+	/** Splices already-serialized JSON in as one value. */
+	void WriteRaw(TConstArrayView<uint8> Json);
+
+	/** Serializes a DOM value, including any FUnrealMCPJsonValueRaw inside it. */
+	void WriteJsonValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteJsonObject(const TSharedPtr<FJsonObject>& Object);
+
+	template <typename ValueType>
+	void WriteField(FStringView Key, ValueType&& Value)
+	{
+		WriteKey(Key);
+		WriteValue(Forward<ValueType>(Value));
+	}
+
+private:
+	void BeforeValue();
+	void Append(const ANSICHAR* Text, int32 Length);
+	void AppendEscaped(FStringView Text);
+
+	TArray<uint8>& Buffer;
+	bool bNeedComma = false;
+};
+
+/**
+ * Serialized JSON carried inside an FJsonObject result so bulk listings can be
+ * written once, with FUnrealMCPJsonWriter, and still travel through handlers,
+ * batches and streaming progress as ordinary results. Only FUnrealMCPJsonWriter
+ * understands it; it is opaque to FJsonObject accessors and FJsonSerializer.
+ */
+class UNREALMCP_API FUnrealMCPJsonValueRaw : public FJsonValue
+{
+public:
+	explicit FUnrealMCPJsonValueRaw(TArray<uint8>&& InJson);
+
+	const TArray<uint8>& GetJson() const { return Json; }
+
+	/** Standard values never use EJson::None, so the type alone identifies raw values. */
+	static const FUnrealMCPJsonValueRaw* Cast(const TSharedPtr<FJsonValue>& Value);
+
+protected:
+	virtual FString GetType() const override { return TEXT("RawJson"); }
+
+private:
+	TArray<uint8> Json;
+};
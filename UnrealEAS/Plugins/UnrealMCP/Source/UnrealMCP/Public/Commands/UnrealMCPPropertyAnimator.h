@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "Containers/Ticker.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+
+class AActor;
+
+enum class EUnrealMCPEasing : uint8
+{
+	Linear,
+	EaseIn,
+	EaseOut,
+	EaseInOut,
+};
+
+struct FUnrealMCPPropertyAnimation
+{
+	TWeakObjectPtr<AActor> Actor;
+	/** Any numeric property of Actor. */
+	FName Property;
+	/** Unset starts from the property's current value. */
+	TOptional<double> From;
+	double To = 0.0;
+	/** Seconds of wall-clock time; 0 jumps to To on the next tick. */
+	double Duration = 1.0;
+	EUnrealMCPEasing Easing = EUnrealMCPEasing::EaseInOut;
+	/** Minimum seconds between progress messages; 0 sends one every frame. */
+	double ProgressInterval = 0.1;
+};
+
+/**
+ * Sweeps numeric actor properties towards a target over time, so a time-of-day or
+ * georeference transition is one command instead of one round trip per step.
+ *
+ * Every running animation is advanced once per engine tick, after which each actor that
+ * changed reruns its construction script once. Starting an animation on a property that
+ * is already animating replaces the old one.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPPropertyAnimator
+{
+public:
+	static FUnrealMCPPropertyAnimator& Get();
+
+	static bool ParseEasing(const FString& Name, EUnrealMCPEasing& OutEasing);
+	static const TCHAR* EasingToString(EUnrealMCPEasing Easing);
+
+	/** Maps linear progress in [0, 1] onto the curve. */
+	static double Ease(EUnrealMCPEasing Easing, double Alpha);
+
+	/**
+	 * Returns the new animation's id, or INDEX_NONE with OutError set and the callbacks
+	 * left untouched. OnProgress and OnComplete may both be unset; OnComplete is called
+	 * once the animation finishes, is stopped or replaced, or fails because its actor
+	 * went away.
+	 */
+	int32 Start(FUnrealMCPPropertyAnimation&& Animation, FUnrealMCPCommandProgress&& OnProgress, FUnrealMCPCommandCompletion&& OnComplete, FString& OutError);
+
+	/** Stops one animation, or all of them for INDEX_NONE, leaving values where they are. Returns how many stopped. */
+	int32 Stop(int32 Id);
+
+	/** Current state of a running animation, or nullptr. */
+	TSharedPtr<FJsonObject> Describe(int32 Id) const;
+
+	int32 Num() const { return Animations.Num(); }
+
+	/** Stops every animation and removes the tick. */
+	void Shutdown();
+
+private:
+	struct FRunning
+	{
+		int32 Id = INDEX_NONE;
+		FUnrealMCPPropertyAnimation Animation;
+		FString ActorName;
+		double From = 0.0;
+		double Value = 0.0;
+		double Alpha = 0.0;
+		double StartTime = 0.0;
+		double LastProgressTime = 0.0;
+		int32 Frames = 0;
+		const TCHAR* State = TEXT("running");
+		FString Error;
+		FUnrealMCPCommandProgress OnProgress;
+		FUnrealMCPCommandCompletion OnComplete;
+	};
+
+	bool Tick(float DeltaTime);
+	TSharedPtr<FJsonObject> MakeState(const FRunning& Running) const;
+
+	/** Reports each finished animation to its caller. Run after they have left Animations. */
+	void Complete(TArray<FRunning>& Finished) const;
+
+	TArray<FRunning> Animations;
+	int32 NextId = 1;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Resolves reflected properties and singleton actors once and reuses the answers.
+ *
+ * Each (class, property name) is looked up on the class the first time it is used;
+ * later reads and writes go straight to the cached FProperty. The actor found for a
+ * class name is remembered weakly per world. Blueprint compiles and hot reload
+ * rebuild class layouts in place, so either one drops every cached property.
+ *
+ * Successful writes mark the actor changed in the actor index's scene generation.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPPropertyBindings
+{
+public:
+	static FUnrealMCPPropertyBindings& Get();
+
+	/** Name on Class, or nullptr. Hits are remembered until the next invalidation. */
+	FProperty* FindProperty(UClass* Class, FName Name);
+
+	/** First actor in World whose class is exactly ClassName (e.g. "Ultra_Dynamic_Sky_C"). */
+	AActor* FindActorOfClass(UWorld* World, FName ClassName);
+
+	/** Any numeric property, read or written as a double. */
+	bool GetDouble(AActor* Actor, FName PropertyName, double& OutValue, FString& OutError);
+	bool SetDouble(AActor* Actor, FName PropertyName, double Value, FString& OutError);
+
+	/**
+	 * Numbers, bools, strings, names, text and enums (by name) map to JSON directly;
+	 * anything else is read and written as Unreal's exported text form.
+	 */
+	TSharedPtr<FJsonValue> GetValue(AActor* Actor, FName PropertyName, FString& OutError);
+	bool SetValue(AActor* Actor, FName PropertyName, const TSharedPtr<FJsonValue>& Value, FString& OutError);
+
+	void Invalidate();
+
+	/** Unbinds the editor and reload delegates. */
+	void Shutdown();
+
+private:
+	void BindDelegates();
+	FProperty* FindPropertyChecked(AActor* Actor, FName PropertyName, FString& OutError);
+	bool WriteValue(AActor* Actor, FName PropertyName, const TSharedPtr<FJsonValue>& Value, FString& OutError);
+	static void MarkChanged(AActor* Actor);
+
+	void HandleBlueprintCompiled();
+	void HandleReloadComplete(EReloadCompleteReason Reason);
+
+	TMap<TPair<TObjectKey<UClass>, FName>, FProperty*> Properties;
+	TMap<TPair<TObjectKey<UWorld>, FName>, TWeakObjectPtr<AActor>> Actors;
+
+	bool bBound = false;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle ReloadCompleteHandle;
+};
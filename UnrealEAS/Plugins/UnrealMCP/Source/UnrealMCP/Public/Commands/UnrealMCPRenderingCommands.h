@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 
 /**
  * Handler class for Rendering-related MCP commands
@@ -10,10 +11,16 @@ class UNREALMCP_API FUnrealMCPRenderingCommands
 {
 public:
     FUnrealMCPRenderingCommands();
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Add this handler's commands to the registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
+
+    // Screenshot command handlers; OnComplete runs on the game thread once the file is written
+    void HandleTakeHighResShot(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandCompletion OnComplete);
 
 private:
-    // Screenshot command handlers
-    TSharedPtr<FJsonObject> HandleTakeHighResShot(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleQuickScreenshot(const TSharedPtr<FJsonObject>& Params);
+    // Steps camera and time of day through a list of frames, streaming each capture
+    void HandleCaptureSequence(const TSharedPtr<FJsonObject>& Params, FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete);
+
+    // Used to reach set_time_of_day; null until RegisterCommands runs
+    const FUnrealMCPCommandRegistry* CommandRegistry = nullptr;
 };
\ No newline at end of file
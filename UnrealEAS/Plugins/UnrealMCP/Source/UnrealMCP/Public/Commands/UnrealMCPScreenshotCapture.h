@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "Commands/UnrealMCPImageDelivery.h"
+#include "Commands/UnrealMCPImageEncoder.h"
+
+struct FUnrealMCPScreenshotRequest
+{
+	double ResolutionMultiplier = 1.0;
+	bool bIncludeUI = false;
+	EUnrealMCPImageDelivery Delivery = EUnrealMCPImageDelivery::File;
+	FUnrealMCPImageEncodeSettings Encoding;
+
+	/** Base file name without extension; a timestamped name is generated when empty. */
+	FString Filename;
+};
+
+/**
+ * Completes high-resolution screenshots from the engine's screenshot-captured
+ * delegate instead of letting the engine write the file on its own.
+ *
+ * The pixels are encoded (PNG, JPEG or WebP) and delivered (file, inline attachment or shared
+ * memory) on a worker thread, and the request completes (on the game thread)
+ * only once the image is available, reporting where it went, the dimensions
+ * and per-stage timings. Captures are global engine
+ * state, so requests are queued and run one at a time. The delegates are only
+ * bound while a capture is in flight, so manual screenshots behave as usual.
+ */
+class UNREALMCP_API FUnrealMCPScreenshotCapture
+{
+public:
+	static FUnrealMCPScreenshotCapture& Get();
+
+	void Capture(const FUnrealMCPScreenshotRequest& Request, FUnrealMCPCommandCompletion OnComplete);
+
+	/** How long to wait for the viewport to deliver the frame before failing the request. */
+	static constexpr double CaptureTimeoutSeconds = 25.0;
+
+private:
+	struct FPendingCapture
+	{
+		FUnrealMCPScreenshotRequest Request;
+		FUnrealMCPCommandCompletion OnComplete;
+		FString Path;
+		double QueuedTime = 0.0;
+		double StartTime = 0.0;
+	};
+
+	void StartNext();
+	void HandleScreenshotCaptured(int32 Width, int32 Height, const TArray<FColor>& Bitmap);
+	bool TickTimeout(float DeltaTime);
+
+	void SetUIVisible(bool bVisible) const;
+	void BindDelegates();
+	void UnbindDelegates();
+
+	/** Fails the active capture and moves on to the next one. */
+	void FailActive(const FString& ErrorMessage);
+
+	TArray<TUniquePtr<FPendingCapture>> Queue;
+	TUniquePtr<FPendingCapture> Active;
+
+	FDelegateHandle ScreenshotRequestHandle;
+	FDelegateHandle GameViewportHandle;
+	FTSTicker::FDelegateHandle TimeoutTickerHandle;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "Containers/Ticker.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "Commands/UnrealMCPImageDelivery.h"
+#include "Commands/UnrealMCPImageEncoder.h"
+
+struct FUnrealMCPViewportPixels;
+
+/** One step of a sequence. Anything left unset keeps its value from the previous step. */
+struct FUnrealMCPSequenceFrame
+{
+	TOptional<FVector> Location;
+	TOptional<FRotator> Rotation;
+	TOptional<double> TimeOfDay;
+};
+
+struct FUnrealMCPSequenceRequest
+{
+	TArray<FUnrealMCPSequenceFrame> Frames;
+
+	/** Engine frames to let the viewport (and sky) render the new state before reading it back. */
+	int32 SettleFrames = 2;
+
+	EUnrealMCPImageDelivery Delivery = EUnrealMCPImageDelivery::File;
+	FUnrealMCPImageEncodeSettings Encoding;
+
+	/** File delivery writes ScreenShotDir/<prefix>_<index>.<ext>. */
+	FString FilenamePrefix;
+
+	bool bRestoreCamera = true;
+};
+
+/**
+ * Runs a capture_sequence: steps the editor camera and Ultra Dynamic Sky time through
+ * a list of frames on the game thread and captures each one through the async viewport
+ * readback. Frame N is read back and encoded while frame N+1 renders; each frame is
+ * reported through OnProgress as soon as it is delivered, and the final response
+ * summarizes every frame with its timings.
+ *
+ * Only one sequence runs at a time since the camera is shared editor state.
+ */
+class UNREALMCP_API FUnrealMCPSequenceCapture : public TSharedFromThis<FUnrealMCPSequenceCapture>
+{
+public:
+	static constexpr int32 MaxFrames = 512;
+
+	static bool ParseRequest(const TSharedPtr<FJsonObject>& Params, FUnrealMCPSequenceRequest& OutRequest, FString& OutError);
+
+	/** SetTimeOfDay is the set_time_of_day command handler. Game thread only. */
+	static void Start(FUnrealMCPSequenceRequest&& Request, FUnrealMCPCommandHandler SetTimeOfDay,
+	                  FUnrealMCPCommandProgress OnProgress, FUnrealMCPCommandCompletion OnComplete);
+
+	FUnrealMCPSequenceCapture(FUnrealMCPSequenceRequest&& InRequest, FUnrealMCPCommandHandler InSetTimeOfDay,
+	                          FUnrealMCPCommandProgress InOnProgress, FUnrealMCPCommandCompletion InOnComplete);
+
+private:
+	enum class EStep : uint8
+	{
+		Apply,
+		Settle,
+		Capture,
+		/** Every frame has been captured; waiting for encodes to finish. */
+		Draining
+	};
+
+	struct FFrameTimes
+	{
+		double Applied = 0.0;
+		double CaptureStarted = 0.0;
+		double ReadbackDone = 0.0;
+		uint64 AppliedFrameCounter = 0;
+	};
+
+	bool Tick(float DeltaTime);
+	bool ApplyFrame(int32 Index, FString& OutError);
+	void OnReadback(int32 Index, FUnrealMCPViewportPixels&& Pixels);
+	void OnFrameDone(int32 Index, TSharedPtr<FJsonObject> FrameJson, TArray<FUnrealMCPAttachment> Attachments);
+	void RestoreCamera();
+	void Finish();
+
+	/** Stops applying frames, restores the camera and fails the request. Late readbacks and encodes are ignored. */
+	void Abort(const FString& ErrorMessage);
+
+	FUnrealMCPSequenceRequest Request;
+	FUnrealMCPCommandHandler SetTimeOfDay;
+	FUnrealMCPCommandProgress OnProgress;
+	FUnrealMCPCommandCompletion OnComplete;
+
+	EStep Step = EStep::Apply;
+	int32 CurrentFrame = 0;
+	int32 FramesDone = 0;
+	int32 FramesFailed = 0;
+	double StartTime = 0.0;
+	bool bFinished = false;
+
+	TArray<FFrameTimes> Times;
+	TArray<TSharedPtr<FJsonValue>> FrameResults;
+
+	/** Held for the final response when nobody is listening for progress. */
+	TArray<FUnrealMCPAttachment> HeldAttachments;
+
+	bool bHaveSavedCamera = false;
+	FVector SavedLocation = FVector::ZeroVector;
+	FRotator SavedRotation = FRotator::ZeroRotator;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
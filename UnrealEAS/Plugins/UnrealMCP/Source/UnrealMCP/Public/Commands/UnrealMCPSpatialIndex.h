@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/GenericOctree.h"
+#include "ConvexVolume.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UWorld;
+
+/** Actor hit by a spatial query, with its distance from the query origin. */
+struct FUnrealMCPSpatialHit
+{
+	AActor* Actor = nullptr;
+	double Distance = 0.0;
+};
+
+/**
+ * Octree over the bounds of one world's actors, so radius, frustum and ray queries only
+ * visit the nodes they overlap instead of every actor in the world.
+ *
+ * Owned and kept current by UUnrealMCPActorIndex. Bounds are captured when an actor is
+ * added or updated. In game worlds, actors with a movable root change position every
+ * frame without any notification, so they are kept out of the tree and tested against
+ * their live bounds on each query instead.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPSpatialIndex
+{
+public:
+	/** Builds the tree from every actor currently in World. */
+	explicit FUnrealMCPSpatialIndex(UWorld* World);
+
+	// Elements point back at ElementIds
+	UE_NONCOPYABLE(FUnrealMCPSpatialIndex);
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+	void UpdateActor(AActor* Actor);
+
+	/** True when enough actors lie outside the root node that a rebuild would pay off. */
+	bool NeedsRebuild() const;
+
+	int32 Num() const { return ElementIds.Num() + Dynamic.Num(); }
+
+	/** Actors whose bounds overlap the sphere, nearest location first. */
+	void FindInSphere(const FVector& Center, double Radius, TArray<FUnrealMCPSpatialHit>& OutHits) const;
+
+	/** Actors whose bounds overlap the volume; Distance is measured from Origin. */
+	void FindInFrustum(const FConvexVolume& Frustum, const FVector& Origin, TArray<FUnrealMCPSpatialHit>& OutHits) const;
+
+	/** Actors whose bounds the segment crosses, ordered by where it enters them. */
+	void FindAlongRay(const FVector& Start, const FVector& End, TArray<FUnrealMCPSpatialHit>& OutHits) const;
+
+	/** Bounds of every primitive component, or the actor's location when it has none. */
+	static FBox GetActorBounds(const AActor* Actor);
+
+private:
+	struct FElement
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TObjectKey<AActor> Key;
+		FBoxCenterAndExtent Bounds;
+		/** Where SetElementId records the element's current slot. */
+		TMap<TObjectKey<AActor>, FOctreeElementId2>* Ids = nullptr;
+	};
+
+	struct FSemantics
+	{
+		enum { MaxElementsPerLeaf = 16 };
+		enum { MinInclusiveElementsPerNode = 7 };
+		enum { MaxNodeDepth = 12 };
+
+		typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+		static FBoxCenterAndExtent GetBoundingBox(const FElement& Element) { return Element.Bounds; }
+		static bool AreElementsEqual(const FElement& A, const FElement& B) { return A.Key == B.Key; }
+		static void SetElementId(const FElement& Element, FOctreeElementId2 Id) { Element.Ids->Add(Element.Key, Id); }
+	};
+
+	using FOctree = TOctree2<FElement, FSemantics>;
+
+	bool IsDynamic(const AActor* Actor) const;
+
+	template <typename OverlapFunc>
+	static void TestElement(const FElement& Element, const OverlapFunc& Overlaps, TArray<FUnrealMCPSpatialHit>& OutHits);
+
+	/** Tests each dynamic actor's live bounds with Overlaps and reports the hits. */
+	template <typename OverlapFunc>
+	void ForEachDynamic(const OverlapFunc& Overlaps, TArray<FUnrealMCPSpatialHit>& OutHits) const;
+
+	TUniquePtr<FOctree> Octree;
+	FBox RootBounds;
+	TMap<TObjectKey<AActor>, FOctreeElementId2> ElementIds;
+	TMap<TObjectKey<AActor>, TWeakObjectPtr<AActor>> Dynamic;
+	int32 OutsideRoot = 0;
+	bool bGameWorld = false;
+};
+
+/** A camera's position and view volume, for frustum queries. */
+struct UNREALMCP_API FUnrealMCPSpatialView
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	/** Horizontal field of view in degrees. */
+	float FOV = 90.0f;
+	float AspectRatio = 16.0f / 9.0f;
+	/** Far plane distance; 0 leaves the volume open-ended. */
+	double MaxDistance = 0.0;
+
+	FConvexVolume Frustum;
+
+	/** The player camera in game worlds, otherwise the level viewport showing World. */
+	static bool FromWorld(UWorld* World, FUnrealMCPSpatialView& OutView, FString& OutError);
+
+	/** Recomputes Frustum from the fields above. */
+	void BuildFrustum();
+};
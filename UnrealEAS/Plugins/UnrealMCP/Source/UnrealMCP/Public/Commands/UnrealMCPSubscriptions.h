@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+#include "Containers/Ticker.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+
+class AActor;
+
+/**
+ * Change feeds for actor transforms and reflected properties, so clients stop polling
+ * get_ultra_dynamic_sky or get_mm_control_lights to notice an edit.
+ *
+ * Each subscription remembers the last state it reported. Once per engine tick (and no
+ * more often than its minimum interval) it compares that against the live actors and
+ * sends everything that changed in a single notification through the subscribing
+ * request's progress channel. A subscription ends when it is unsubscribed, when all of
+ * its actors are gone, or when the client disconnects. Each belongs to the client that
+ * made it (see FScopedClient) and only that client can unsubscribe it.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPSubscriptions
+{
+public:
+	static constexpr int32 MaxActors = 1024;
+
+	static FUnrealMCPSubscriptions& Get();
+
+	/**
+	 * Watches the transforms of Actors (when bTransform) and their Properties. Returns the
+	 * subscription id; OutSnapshot receives the current state every later notification is
+	 * relative to.
+	 */
+	int32 Subscribe(const TArray<AActor*>& Actors, bool bTransform, const TArray<FName>& Properties, double MinInterval,
+	                FUnrealMCPCommandProgress&& OnNotify, TSharedPtr<FJsonObject>& OutSnapshot);
+
+	/** Removes subscription Id if it belongs to the client in scope. */
+	bool Unsubscribe(int32 Id);
+
+	int32 Num() const { return Subscriptions.Num(); }
+
+	/** Drops every subscription and removes the tick. */
+	void Shutdown();
+
+	/** Names the client whose command runs in this scope; the bridge sets it around handlers. */
+	class UNREALMCP_API FScopedClient
+	{
+	public:
+		explicit FScopedClient(int32 ClientId);
+		~FScopedClient();
+
+		FScopedClient(const FScopedClient&) = delete;
+		FScopedClient& operator=(const FScopedClient&) = delete;
+
+	private:
+		int32 Previous;
+	};
+
+private:
+	struct FWatchedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FString Name;
+		FTransform Transform;
+		/** Last reported value of each subscribed property; null when it can't be read. */
+		TArray<TSharedPtr<FJsonValue>> Values;
+	};
+
+	struct FSubscription
+	{
+		int32 Id = INDEX_NONE;
+		int32 ClientId = INDEX_NONE;
+		bool bTransform = true;
+		TArray<FName> Properties;
+		double MinInterval = 0.0;
+		double LastSent = 0.0;
+		TArray<FWatchedActor> Actors;
+		FUnrealMCPCommandProgress OnNotify;
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** The change since the last report, or nullptr when nothing changed. Records the new state. */
+	static TSharedPtr<FJsonObject> Diff(const FSubscription& Subscription, FWatchedActor& Watched);
+
+	static void WriteTransform(const FTransform& Transform, const TSharedPtr<FJsonObject>& OutJson);
+
+	TArray<FSubscription> Subscriptions;
+	int32 NextId = 1;
+	int32 CurrentClientId = INDEX_NONE;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeBool.h"
+#include "PixelFormat.h"
+
+class FViewport;
+class FRHIGPUTextureReadback;
+
+struct FUnrealMCPViewportPixels
+{
+	bool bSuccess = false;
+	FString Error;
+
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<FColor> Pixels;
+
+	/** True if the pixels came through the GPU readback ring rather than ReadPixels. */
+	bool bAsync = false;
+
+	/** Engine frames between the request and the pixels becoming available. */
+	uint64 Frames = 0;
+};
+
+using FUnrealMCPReadbackCompletion = TUniqueFunction<void(FUnrealMCPViewportPixels&&)>;
+
+/**
+ * Reads viewport pixels without stalling the game thread.
+ *
+ * Each capture copies the viewport's render target into one of a small ring of
+ * staging textures and completes a few frames later, once the GPU fence has
+ * passed, so the viewport keeps rendering at full rate. When every slot is busy
+ * further requests wait for a free one. Under NullRHI, or when asked to, the
+ * synchronous FViewport::ReadPixels path is used instead and the request
+ * completes immediately.
+ *
+ * Game thread only; completions also run on the game thread.
+ */
+class UNREALMCP_API FUnrealMCPViewportReadback
+{
+public:
+	static FUnrealMCPViewportReadback& Get();
+
+	void Capture(FViewport* Viewport, bool bAllowAsync, FUnrealMCPReadbackCompletion OnComplete);
+
+	/** Fails outstanding captures and releases the staging textures. Call before the RHI shuts down. */
+	void Shutdown();
+
+	/**
+	 * True if a capture started now would copy the current frame right away instead of
+	 * waiting for a slot. Callers that change the scene between captures check this first.
+	 */
+	bool HasFreeSlot() const;
+
+	/** Whether the async path can work at all in this process. */
+	static bool IsAsyncSupported();
+
+	static constexpr int32 NumSlots = 3;
+
+	/** A copy that has not landed after this long is abandoned and retried synchronously. */
+	static constexpr double ReadbackTimeoutSeconds = 2.0;
+
+private:
+	struct FRequest
+	{
+		FViewport* Viewport = nullptr;
+		FIntPoint Size = FIntPoint::ZeroValue;
+		FUnrealMCPReadbackCompletion OnComplete;
+		uint64 StartFrame = 0;
+	};
+
+	enum class ESlotState : uint8
+	{
+		Free,
+		/** Copy enqueued; waiting on the GPU. */
+		Copying,
+		/** Fence passed; the render thread is mapping the staging texture. */
+		Resolving
+	};
+
+	/** Filled in on the render thread when the copy is recorded. A fresh one is made per copy. */
+	struct FCopyState
+	{
+		/** Until this is set the readback has no fence and IsReady() is meaningless. */
+		FThreadSafeBool bEnqueued;
+		bool bHasSource = false;
+		EPixelFormat Format = PF_Unknown;
+	};
+
+	struct FSlot
+	{
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+		ESlotState State = ESlotState::Free;
+		FRequest Request;
+		TSharedPtr<FCopyState, ESPMode::ThreadSafe> Copy;
+		double StartTime = 0.0;
+	};
+
+	void StartPending();
+	void StartCopy(int32 SlotIndex);
+	void Resolve(int32 SlotIndex);
+	void Complete(int32 SlotIndex, const TSharedPtr<FCopyState, ESPMode::ThreadSafe>& Copy, FUnrealMCPViewportPixels&& Result);
+	bool Tick(float DeltaTime);
+
+	/** Fails, rather than touching it, if Viewport has been closed since the request was made. */
+	static FUnrealMCPViewportPixels ReadSynchronously(FViewport* Viewport);
+
+	FSlot Slots[NumSlots];
+	TArray<FRequest> Pending;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
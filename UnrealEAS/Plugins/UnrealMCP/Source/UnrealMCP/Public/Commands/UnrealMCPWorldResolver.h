@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+enum class EUnrealMCPWorldTarget : uint8
+{
+	/** The PIE world while a session runs, then a standalone game world, then the editor world. */
+	Auto,
+	Editor,
+	PIE,
+	Game,
+
+	Count
+};
+
+/**
+ * Decides which world commands operate on.
+ *
+ * The answer for each target is cached and only recomputed after PIE starts or
+ * stops, a map is opened, or the cached world is cleaned up, so resolving is
+ * constant-time no matter how many world contexts exist. A request can pin a
+ * target with a "world" parameter; the bridge turns that into an FScopedPin
+ * around the handler.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPWorldResolver
+{
+public:
+	static FUnrealMCPWorldResolver& Get();
+
+	static bool ParseTarget(const FString& Name, EUnrealMCPWorldTarget& OutTarget);
+	static const TCHAR* TargetToString(EUnrealMCPWorldTarget Target);
+
+	/** The world for the innermost pin, or Auto when nothing is pinned. */
+	UWorld* Resolve();
+	UWorld* Resolve(EUnrealMCPWorldTarget Target);
+
+	void Invalidate();
+
+	/** Unbinds the editor and world delegates. */
+	void Shutdown();
+
+	class UNREALMCP_API FScopedPin
+	{
+	public:
+		explicit FScopedPin(EUnrealMCPWorldTarget Target);
+		~FScopedPin();
+
+		FScopedPin(const FScopedPin&) = delete;
+		FScopedPin& operator=(const FScopedPin&) = delete;
+
+	private:
+		EUnrealMCPWorldTarget Previous;
+	};
+
+private:
+	void BindDelegates();
+	static UWorld* FindWorld(EUnrealMCPWorldTarget Target);
+
+	void HandlePIEEvent(bool bIsSimulating);
+	void HandleMapOpened(const FString& Filename, bool bAsTemplate);
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	TWeakObjectPtr<UWorld> Cached[(int32)EUnrealMCPWorldTarget::Count];
+	EUnrealMCPWorldTarget Pinned = EUnrealMCPWorldTarget::Auto;
+
+	bool bBound = false;
+	FDelegateHandle PostPIEStartedHandle;
+	FDelegateHandle EndPIEHandle;
+	FDelegateHandle MapOpenedHandle;
+	FDelegateHandle WorldCleanupHandle;
+};
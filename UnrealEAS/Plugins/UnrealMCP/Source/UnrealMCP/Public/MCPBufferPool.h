@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Free list of byte buffers that responses are serialized into. A buffer travels
+ * from the serializer through the outbox to the socket by move and comes back here
+ * once its bytes are sent, so a response is never copied between those steps and
+ * steady traffic stops allocating. Thread safe.
+ */
+class UNREALMCP_API FMCPBufferPool
+{
+public:
+	static constexpr int32 MaxPooledBuffers = 16;
+
+	/** Buffers grown past this are freed instead of pooled, so one huge listing doesn't pin its memory. */
+	static constexpr int64 MaxRetainedSize = 4 * 1024 * 1024;
+
+	/** Returns an empty buffer, reusing a released one's allocation when there is one. */
+	static TArray<uint8> Acquire();
+
+	/** Hands a buffer back once its contents are no longer needed. */
+	static void Release(TArray<uint8>&& Buffer);
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "MCPMessageFraming.h"
+#include "MCPFrameCompressor.h"
+#include "MCPSharedRing.h"
+
+class IMCPStream;
+class FEvent;
+class FJsonObject;
+class FJsonValue;
+class FRunnableThread;
+class UUnrealMCPBridge;
+struct FUnrealMCPAttachment;
+
+/** Socket write totals for one connection, reported by get_connection_stats. */
+struct FMCPSendStats
+{
+	int64 Writes = 0;
+	/** Writes that took only part of what was offered. */
+	int64 PartialWrites = 0;
+	/** Times the socket was full and the sender waited for it to drain. */
+	int64 WouldBlockWaits = 0;
+	int64 BytesSent = 0;
+};
+
+/**
+ * Write side of a client connection. Shared with every in-flight request so
+ * responses can be sent from whichever thread completes them, in completion
+ * order. Once closed, late responses are dropped.
+ */
+class FMCPResponseChannel
+{
+public:
+	explicit FMCPResponseChannel(IMCPStream* InStream);
+	~FMCPResponseChannel();
+
+	/** Response is an encoded message: UTF-8 JSON or CBOR. */
+	bool Send(TConstArrayView<uint8> Response);
+
+	/** Sends the response followed by each attachment's bytes, framed for the current mode. */
+	bool Send(TConstArrayView<uint8> Response, const TArray<FUnrealMCPAttachment>& Attachments);
+
+	/**
+	 * Encodes the response with the channel's current encoding right before sending it, so
+	 * messages produced before a set_framing still reach the client in the new encoding.
+	 */
+	bool Send(TFunctionRef<TArray<uint8>(EMCPEncoding)> Encode, const TArray<FUnrealMCPAttachment>& Attachments);
+
+	/** Stops sending for good. A sender waiting on a full socket is woken and gives up. */
+	void Close();
+
+	/** False once the connection has closed or a write failed; safe to poll from any thread. */
+	bool IsOpen() const { return bOpen; }
+
+	/** Framing and message encoding change together, between two sends. */
+	void SetMode(EMCPFramingMode NewMode, EMCPEncoding NewEncoding);
+
+	/** Responses of at least Threshold bytes are compressed; attachments never are. */
+	void SetCompression(EMCPCompression NewCompression, int32 Threshold);
+	void GetCompression(EMCPCompression& OutCompression, int32& OutThreshold, FMCPCompressionStats& OutStats);
+
+	FMCPSendStats GetSendStats();
+
+	/** Payloads of at least Threshold bytes go through the ring while it has room. Pass nullptr to stop. */
+	void SetSharedRing(TUniquePtr<FMCPSharedRing> NewRing, int32 Threshold);
+
+	/** Runs Visitor with the current ring (or nullptr) under the send lock. */
+	void VisitSharedRing(TFunctionRef<void(const FMCPSharedRing*, int32)> Visitor);
+
+	/** In-flight request accounting used for pipelining limits and ordering barriers. */
+	void BeginRequest();
+	void EndRequest();
+	int32 GetInFlight() const { return InFlight.GetValue(); }
+
+	/** Blocks until a request completes or the timeout elapses. */
+	void WaitForCompletion(const FTimespan& Timeout);
+
+private:
+	/** Frames and writes the response and its attachments. Caller holds SendLock. */
+	bool SendLocked(TConstArrayView<uint8> Response, const TArray<FUnrealMCPAttachment>& Attachments);
+
+	/**
+	 * Writes Parts back to back with gather writes, looping over short writes and waiting
+	 * while the socket is full. Gives up, closing the channel, when the socket fails or the
+	 * client stops reading for too long. Caller holds SendLock.
+	 */
+	bool SendParts(TArrayView<TConstArrayView64<uint8>> Parts);
+
+	/**
+	 * Puts Data in the shared ring and sends its descriptor frame. Returns false if the ring
+	 * isn't used for it, otherwise bOutSent tells whether the descriptor went out. Caller holds SendLock.
+	 */
+	bool TrySendThroughRing(const uint8* Data, int64 Num, bool& bOutSent);
+
+	FCriticalSection SendLock;
+	IMCPStream* Stream;
+	EMCPFramingMode Mode;
+	EMCPEncoding Encoding;
+	FMCPFrameCompressor Compressor;
+	TUniquePtr<FMCPSharedRing> Ring;
+	int32 RingThreshold;
+	FMCPSendStats SendStats;
+	FThreadSafeBool bOpen;
+
+	FThreadSafeCounter InFlight;
+	FEvent* CompletionEvent;
+};
+
+/**
+ * One accepted MCP client. Each connection runs on its own thread and blocks
+ * on socket readiness instead of sleeping, so a slow client never holds up
+ * the listener or the other connections.
+ *
+ * Requests carrying an "id" are pipelined: the connection keeps reading while
+ * they execute and each response echoes its id. Read-only commands may complete
+ * out of order; a mutating command waits for everything before it to finish.
+ * Requests without an id keep the original one-request-one-response behaviour.
+ */
+class FMCPClientConnection : public FRunnable
+{
+public:
+	FMCPClientConnection(UUnrealMCPBridge* InBridge, TUniquePtr<IMCPStream> InStream, int32 InClientId);
+	virtual ~FMCPClientConnection();
+
+	/** Spawns the connection thread. Returns false if the thread could not be created. */
+	bool Start();
+
+	/** True once the client disconnected or the connection was stopped. */
+	bool IsFinished() const { return bFinished; }
+
+	int32 GetClientId() const { return ClientId; }
+
+	// FRunnable interface
+	virtual bool Init() override;
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	virtual void Exit() override;
+
+protected:
+	void ProcessMessage(TConstArrayView<uint8> Message);
+	bool SendError(const FString& ErrorMessage, const TSharedPtr<FJsonValue>& RequestId = nullptr);
+
+	/** Sends a connection-level reply in the connection's encoding. */
+	bool SendObject(const TSharedPtr<FJsonObject>& ResponseJson);
+	bool SendResult(const TSharedPtr<FJsonObject>& ResultJson, const TSharedPtr<FJsonValue>& RequestId);
+
+	/**
+	 * Connection-level 'set_framing' command, which also picks the message encoding and
+	 * response compression. The reply is sent the old way, then everything switches.
+	 */
+	void HandleSetFraming(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId);
+
+	/** Connection-level 'get_connection_stats' command: negotiated settings and transfer totals. */
+	void HandleGetConnectionStats(const TSharedPtr<FJsonValue>& RequestId);
+
+	/** Connection-level 'open_shared_ring' / 'close_shared_ring' commands (see FMCPSharedRing). */
+	void HandleOpenSharedRing(const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId);
+	void HandleCloseSharedRing(const TSharedPtr<FJsonValue>& RequestId);
+
+	/** Waits until no more than MaxInFlight requests are outstanding (or the connection stops). */
+	void WaitForInFlight(int32 MaxInFlight);
+
+private:
+	UUnrealMCPBridge* Bridge;
+	TUniquePtr<IMCPStream> Stream;
+	FRunnableThread* Thread;
+	int32 ClientId;
+	FMCPMessageDecoder Decoder;
+	TSharedPtr<FMCPResponseChannel, ESPMode::ThreadSafe> Channel;
+	/** Requests are decoded and responses encoded with this; only the connection thread changes it. */
+	EMCPEncoding Encoding;
+	int32 RingCount;
+	FThreadSafeBool bRunning;
+	FThreadSafeBool bFinished;
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+
+/**
+ * Priority classes for game-thread commands, highest first.
+ *  - Interactive: read-only lookups a client is usually waiting on
+ *  - Mutation:    edits to the level, actors or assets
+ *  - Heavy:       rendering, compiling and batches (EUnrealMCPCommandCost::High)
+ */
+enum class EMCPRequestLane : uint8
+{
+	Interactive,
+	Mutation,
+	Heavy
+};
+
+/** Queue depth and wait times of one lane, reported by get_connection_stats. */
+struct FMCPSchedulerLaneStats
+{
+	int32 Depth = 0;
+	int32 MaxDepth = 0;
+	int32 Capacity = 0;
+	int32 PerClientLimit = 0;
+	int64 Admitted = 0;
+	/** Requests answered "busy" because the lane or the client's share of it was full. */
+	int64 Rejected = 0;
+	int64 Dispatched = 0;
+	/** Over the last WaitSampleCount dispatches, except MaxWaitMs which covers all of them. */
+	double AverageWaitMs = 0.0;
+	double P50WaitMs = 0.0;
+	double P95WaitMs = 0.0;
+	double MaxWaitMs = 0.0;
+};
+
+/**
+ * Bounded admission in front of the game thread. Commands are queued per lane and per
+ * client instead of being posted straight to the game thread, and a single pump runs them:
+ * every lane with work gets one command per pump, so heavy ones are never starved, then
+ * interactive and mutation commands fill the rest of a short time budget. Within a lane
+ * clients take turns. Once the budget is spent the pump yields until the next frame.
+ *
+ * A client's read-only commands never overtake its own earlier mutations; everything else
+ * about per-client ordering is already enforced by the connection's in-flight barriers.
+ *
+ * Admission is two-phase so a rejected caller still owns its completion: TryAdmit reserves
+ * a slot (or says how long to back off) and Submit fills it.
+ */
+class UNREALMCP_API FMCPCommandScheduler : public TSharedFromThis<FMCPCommandScheduler, ESPMode::ThreadSafe>
+{
+public:
+	static constexpr int32 NumLanes = 3;
+	static constexpr int32 WaitSampleCount = 256;
+
+	/** Game-thread time a pump may spend before yielding to the editor, beyond the first turn of each lane. */
+	static constexpr double PumpBudgetSeconds = 0.008;
+
+	/**
+	 * Called exactly once: with true on the game thread to run the command, or with false,
+	 * on any thread, when the scheduler shuts down first. A dropped task must still answer
+	 * its request.
+	 */
+	using FTask = TUniqueFunction<void(bool bRun)>;
+
+	FMCPCommandScheduler();
+
+	static EMCPRequestLane LaneFor(const FUnrealMCPCommandInfo& Command);
+	static const TCHAR* LaneToString(EMCPRequestLane Lane);
+
+	/**
+	 * Reserves a slot for ClientId in Lane. Returns false when the lane or the client's share
+	 * of it is full, with a suggested retry delay based on the lane's recent waits.
+	 */
+	bool TryAdmit(EMCPRequestLane Lane, int32 ClientId, int32& OutRetryAfterMs);
+
+	/** Queues Task in the slot TryAdmit reserved. Must follow every successful TryAdmit. */
+	void Submit(EMCPRequestLane Lane, int32 ClientId, bool bReadOnly, FTask Task);
+
+	/** Drops everything still queued, and later submissions, calling each task with false. */
+	void Shutdown();
+
+	FMCPSchedulerLaneStats GetLaneStats(EMCPRequestLane Lane) const;
+
+	/** Commands ClientId has reserved or queued in Lane. */
+	int32 GetClientDepth(EMCPRequestLane Lane, int32 ClientId) const;
+
+private:
+	struct FEntry
+	{
+		FTask Task;
+		uint64 Sequence = 0;
+		double EnqueueTime = 0.0;
+		bool bReadOnly = true;
+	};
+
+	struct FClientQueue
+	{
+		int32 ClientId = INDEX_NONE;
+		uint64 NextSequence = 0;
+		/** Reserved plus queued, per lane. */
+		int32 Depth[NumLanes] = {};
+		TArray<FEntry> Entries[NumLanes];
+	};
+
+	struct FLane
+	{
+		int32 Capacity = 0;
+		int32 PerClientLimit = 0;
+		int32 Depth = 0;
+		int32 MaxDepth = 0;
+		int64 Admitted = 0;
+		int64 Rejected = 0;
+		int64 Dispatched = 0;
+		double MaxWaitSeconds = 0.0;
+		TArray<float> WaitSamples;
+		int32 NextWaitSample = 0;
+		/** Client index the next pick starts from. */
+		int32 Cursor = 0;
+	};
+
+	/** Runs on the game thread until the budget is spent or nothing is runnable. */
+	void Pump();
+
+	/** Posts a pump to the game thread if none is pending. Caller holds Lock. */
+	void SchedulePump(bool bNextFrame);
+
+	/** Takes the next runnable entry of Lane, in client round-robin order. Caller holds Lock. */
+	bool PopNext(EMCPRequestLane Lane, FEntry& OutEntry);
+
+	/** Frees the slot of an entry that was just taken off its queue. Caller holds Lock. */
+	void ReleaseSlot(int32 ClientIndex, EMCPRequestLane Lane);
+
+	int32 FindClient(int32 ClientId) const;
+	double GetAverageWaitSeconds(const FLane& LaneState) const;
+
+	mutable FCriticalSection Lock;
+	FLane Lanes[NumLanes];
+	TArray<FClientQueue> Clients;
+	/** Submitted entries not yet popped, across lanes and clients. */
+	int32 QueuedEntries;
+	bool bPumpScheduled;
+	bool bShutdown;
+};
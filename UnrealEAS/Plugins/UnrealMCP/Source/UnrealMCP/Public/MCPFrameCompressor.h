@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPMessageFraming.h"
+
+/** Running totals for one connection's responses, reported by get_connection_stats. */
+struct FMCPCompressionStats
+{
+	int64 MessagesCompressed = 0;
+	int64 MessagesBelowThreshold = 0;
+	int64 BlocksStored = 0;
+	int64 BytesIn = 0;
+	int64 BytesOut = 0;
+	double CompressSeconds = 0.0;
+};
+
+/**
+ * Compresses a response in fixed-size blocks, handing each finished frame to the
+ * caller before starting the next, so only one compressed block is ever held.
+ *
+ * A compressed response is a run of LengthPrefixed frames whose length header
+ * carries two flags: CompressedFlag marks a compressed block and MoreFlag says
+ * another block of the same message follows. Each block body is the original
+ * block size (4 bytes, big-endian) followed by the compressed bytes, or by the
+ * original bytes unchanged when compression didn't make them smaller (then the
+ * body is exactly 4 bytes longer than the original size).
+ *
+ * Not thread safe; FMCPResponseChannel only uses it under its send lock.
+ */
+class UNREALMCP_API FMCPFrameCompressor
+{
+public:
+	/** Matches the socket send buffer, so each block goes out in one write. */
+	static constexpr int32 BlockSize = 64 * 1024;
+	static constexpr int32 DefaultThreshold = 16 * 1024;
+
+	static constexpr uint32 CompressedFlag = 0x80000000u;
+	static constexpr uint32 MoreFlag = 0x40000000u;
+
+	void Configure(EMCPCompression InCompression, int32 InThreshold);
+	EMCPCompression GetCompression() const { return Compression; }
+	int32 GetThreshold() const { return Threshold; }
+
+	/** True when a payload of this size is compressed. Counts the ones left below the threshold. */
+	bool ShouldCompress(int32 PayloadSize);
+
+	/** Passes each frame of the compressed payload to Emit; stops when Emit returns false. */
+	bool Compress(TConstArrayView<uint8> Payload, TFunctionRef<bool(TConstArrayView<uint8>)> Emit);
+
+	const FMCPCompressionStats& GetStats() const { return Stats; }
+
+private:
+	EMCPCompression Compression = EMCPCompression::None;
+	int32 Threshold = DefaultThreshold;
+
+	/** One frame: header, original size and the block's compressed bytes. Reused. */
+	TArray<uint8> Scratch;
+	FMCPCompressionStats Stats;
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * How MCP messages are delimited on a connection.
+ *  - Json:           bare JSON documents back to back (the original protocol, default)
+ *  - Newline:        one JSON document per line, responses end with '\n'
+ *  - LengthPrefixed: 4-byte big-endian payload length followed by the payload; compressed
+ *                    responses flag the top bits of the length (see FMCPFrameCompressor)
+ *
+ * Responses may be followed by binary attachments they announce in "attachments".
+ */
+enum class EMCPFramingMode : uint8
+{
+	Json,
+	Newline,
+	LengthPrefixed
+};
+
+/**
+ * How messages themselves are encoded.
+ *  - Json: UTF-8 JSON text (default)
+ *  - Cbor: RFC 8949 CBOR with the same structure; binary, so LengthPrefixed framing only
+ */
+enum class EMCPEncoding : uint8
+{
+	Json,
+	Cbor
+};
+
+/**
+ * Compression of large responses (see FMCPFrameCompressor), LengthPrefixed framing only.
+ *  - None: default
+ *  - LZ4:  fast, moderate ratio
+ *  - Zlib: slower, smaller
+ */
+enum class EMCPCompression : uint8
+{
+	None,
+	LZ4,
+	Zlib
+};
+
+namespace MCPFraming
+{
+	/** Largest single message accepted from a client (256 MB). */
+	static constexpr int32 DefaultMaxMessageSize = 256 * 1024 * 1024;
+
+	UNREALMCP_API bool ParseMode(const FString& ModeName, EMCPFramingMode& OutMode);
+	UNREALMCP_API const TCHAR* ModeToString(EMCPFramingMode Mode);
+
+	UNREALMCP_API bool ParseEncoding(const FString& EncodingName, EMCPEncoding& OutEncoding);
+	UNREALMCP_API const TCHAR* EncodingToString(EMCPEncoding Encoding);
+
+	UNREALMCP_API bool ParseCompression(const FString& CompressionName, EMCPCompression& OutCompression);
+	UNREALMCP_API const TCHAR* CompressionToString(EMCPCompression Compression);
+
+	static constexpr int32 LengthHeaderSize = 4;
+
+	/**
+	 * Largest payload a single LengthPrefixed frame can carry. The top three bits of the
+	 * header are flags (FMCPFrameCompressor::CompressedFlag and MoreFlag, FMCPSharedRing::FrameFlag).
+	 */
+	static constexpr uint32 MaxFrameLength = 0x1FFFFFFFu;
+
+	/** Writes the LengthPrefixed header for a payload of Length bytes to OutHeader[0..3]. Length must not exceed MaxFrameLength. */
+	UNREALMCP_API void WriteLengthHeader(uint32 Length, uint8* OutHeader);
+}
+
+/**
+ * Incremental decoder for MCP messages.
+ *
+ * Received bytes are written straight into the decoder's buffer (GetWriteBuffer /
+ * CommitWrite) and every byte is scanned exactly once, so large payloads decode in
+ * O(n) no matter how they are split across reads. Consumed bytes are compacted away
+ * lazily, keeping the amortized copy cost linear as well.
+ */
+class UNREALMCP_API FMCPMessageDecoder
+{
+public:
+	explicit FMCPMessageDecoder(EMCPFramingMode InMode = EMCPFramingMode::Json, int32 InMaxMessageSize = MCPFraming::DefaultMaxMessageSize);
+
+	/** Switches framing. Bytes already buffered but not yet returned are decoded in the new mode. */
+	void SetMode(EMCPFramingMode NewMode);
+	EMCPFramingMode GetMode() const { return Mode; }
+
+	/** Returns a pointer with at least MinFree writable bytes at the end of the buffered data. */
+	uint8* GetWriteBuffer(int32 MinFree);
+
+	/** Marks BytesWritten bytes at the pointer returned by GetWriteBuffer as received. */
+	void CommitWrite(int32 BytesWritten);
+
+	/** Copies Num bytes into the buffer. Prefer GetWriteBuffer/CommitWrite when reading from a socket. */
+	void Append(const uint8* Data, int32 Num);
+
+	/**
+	 * Extracts the next complete message, returning its payload bytes in place. The view is
+	 * valid until the next write.
+	 * @return false when more data is needed or the stream is in an error state.
+	 */
+	bool NextMessageView(TConstArrayView<uint8>& OutMessage);
+
+	bool HasError() const { return !Error.IsEmpty(); }
+	const FString& GetError() const { return Error; }
+
+	/** Number of received bytes not yet returned as messages. */
+	int32 GetBufferedBytes() const { return DataEnd - ReadOffset; }
+
+private:
+	bool NextJsonMessage(int32& OutStart, int32& OutLength);
+	bool NextNewlineMessage(int32& OutStart, int32& OutLength);
+	bool NextLengthPrefixedMessage(int32& OutStart, int32& OutLength);
+
+	void ResetScanState();
+	void Compact();
+
+	EMCPFramingMode Mode;
+	int32 MaxMessageSize;
+
+	/** Buffer.Num() is the capacity; valid data is [ReadOffset, DataEnd). */
+	TArray<uint8> Buffer;
+	int32 ReadOffset;
+	int32 DataEnd;
+
+	/** Scan position and state carried across reads so no byte is scanned twice. */
+	int32 ScanOffset;
+	int32 MessageStart;
+	int32 Depth;
+	bool bInString;
+	bool bEscape;
+
+	FString Error;
+};
@@ -2,18 +2,22 @@
 
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
-#include "Sockets.h"
-#include "Interfaces/IPv4/IPv4Address.h"
+#include "HAL/ThreadSafeBool.h"
+#include "MCPTransport.h"
 
 class UUnrealMCPBridge;
+class FMCPClientConnection;
 
 /**
- * Runnable class for the MCP server thread
+ * Runnable class for an MCP server thread, one per listener (TCP, Unix domain socket).
+ * Blocks on the listener until a connection is pending and hands every
+ * accepted stream to its own FMCPClientConnection, so clients are served
+ * concurrently.
  */
 class FMCPServerRunnable : public FRunnable
 {
 public:
-	FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket);
+	FMCPServerRunnable(UUnrealMCPBridge* InBridge, TUniquePtr<IMCPListener> InListener);
 	virtual ~FMCPServerRunnable();
 
 	// FRunnable interface
@@ -23,12 +27,13 @@ public:
 	virtual void Exit() override;
 
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
+	void AcceptPendingConnections();
+	void ReapFinishedConnections();
+	void CloseAllConnections();
 
 private:
 	UUnrealMCPBridge* Bridge;
-	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
-	bool bRunning;
-}; 
\ No newline at end of file
+	TUniquePtr<IMCPListener> Listener;
+	TArray<TUniquePtr<FMCPClientConnection>> Clients;
+	FThreadSafeBool bRunning;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+
+/**
+ * Single-producer ring buffer in a named shared-memory region, used by one connection
+ * to hand bulk payloads to a client on the same machine without going through the socket.
+ *
+ * Layout, little-endian:
+ *   0   uint32 magic 'UMRB'     4   uint32 header size
+ *   8   uint64 capacity         64  uint64 head: bytes ever written (server)
+ *   128 uint64 tail: bytes ever released (client)
+ *   HeaderSize..                the data, capacity bytes, written with wrap-around
+ *
+ * A payload at position P occupies [P % capacity, ...) and may wrap. The client copies
+ * it out and then stores P + size as the new tail, which frees the space.
+ *
+ * In LengthPrefixed framing, a frame whose length header has FrameFlag set holds a
+ * 16-byte descriptor (big-endian position, then size) instead of the payload.
+ */
+class UNREALMCP_API FMCPSharedRing
+{
+public:
+	static constexpr uint32 Magic = 0x42524D55;
+	static constexpr int32 HeaderSize = 256;
+	static constexpr int32 HeadOffset = 64;
+	static constexpr int32 TailOffset = 128;
+	static constexpr uint32 FrameFlag = 0x20000000u;
+	static constexpr int32 DescriptorSize = 16;
+	static constexpr int32 DefaultThreshold = 64 * 1024;
+
+	static constexpr int64 MinCapacity = 1024 * 1024;
+	static constexpr int64 MaxCapacity = 1024ll * 1024 * 1024;
+
+	/** Maps a new region holding Capacity data bytes; nullptr and OutError on failure. */
+	static TUniquePtr<FMCPSharedRing> Create(const FString& Name, int64 Capacity, FString& OutError);
+	~FMCPSharedRing();
+
+	/**
+	 * Copies Data into the ring if the client has released enough space.
+	 * @return false when it doesn't fit; the caller sends it over the socket instead.
+	 */
+	bool TryWrite(const uint8* Payload, int64 Num, uint64& OutPosition);
+
+	const FString& GetName() const { return Name; }
+	int64 GetCapacity() const { return Capacity; }
+	int64 GetRegionSize() const { return HeaderSize + Capacity; }
+
+	int64 GetWrites() const { return Writes; }
+	int64 GetBytesWritten() const { return (int64)Head; }
+	/** Payloads that found the ring full and went over the socket. */
+	int64 GetFallbacks() const { return Fallbacks; }
+
+private:
+	FMCPSharedRing(const FString& InName, FPlatformMemory::FSharedMemoryRegion* InRegion, int64 InCapacity);
+
+	uint64* HeadPtr() const;
+	uint64* TailPtr() const;
+
+	FString Name;
+	FPlatformMemory::FSharedMemoryRegion* Region;
+	uint8* Data;
+	int64 Capacity;
+	uint64 Head;
+	int64 Writes;
+	int64 Fallbacks;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+
+enum class EMCPStreamResult : uint8
+{
+	Ok,
+	/** Nothing moved this time (interrupted or would block); wait and try again. */
+	Retry,
+	/** The peer closed the connection. */
+	Closed,
+	Error
+};
+
+/**
+ * Byte stream to one client, so FMCPClientConnection serves TCP and Unix domain
+ * socket clients with the same code. Streams are non-blocking: Recv is only called
+ * once WaitForRead reports data, and writes come back short or with Retry when the
+ * client's buffer is full, so callers loop, wait with WaitForWrite and give up on a
+ * client that stops reading.
+ */
+class IMCPStream
+{
+public:
+	virtual ~IMCPStream() = default;
+
+	/** Blocks until data is readable or Timeout elapses. */
+	virtual bool WaitForRead(const FTimespan& Timeout) = 0;
+	virtual bool IsConnected() = 0;
+
+	/** Bytes readable without blocking, or 0 when unknown. */
+	virtual uint32 GetPendingBytes() = 0;
+
+	virtual EMCPStreamResult Recv(uint8* Data, int32 Size, int32& OutBytesRead) = 0;
+
+	/** Blocks until the stream can take more data or Timeout elapses. Sends never block; a full stream returns Retry. */
+	virtual bool WaitForWrite(const FTimespan& Timeout) = 0;
+	virtual EMCPStreamResult Send(const uint8* Data, int32 Size, int32& OutBytesSent) = 0;
+
+	/**
+	 * Writes Buffers in order, like writev, and may stop partway through any of them.
+	 * Streams without a native gather write coalesce small leading buffers into one
+	 * send of at most GatherStagingSize bytes, so a frame header never goes out as its
+	 * own packet, and send large buffers in place.
+	 */
+	virtual EMCPStreamResult SendGather(TConstArrayView<TConstArrayView64<uint8>> Buffers, int32& OutBytesSent);
+
+	static constexpr int32 GatherStagingSize = 64 * 1024;
+
+	/** Platform error code of the last failed call, for logs. */
+	virtual int32 GetLastErrorCode() = 0;
+
+	/**
+	 * Shuts the connection down so a thread waiting on it returns at once and later calls
+	 * fail. Unlike Close it may run while another thread is using the stream.
+	 */
+	virtual void Interrupt() = 0;
+
+	virtual void Close() = 0;
+};
+
+/** Accepts clients on one endpoint for FMCPServerRunnable. */
+class IMCPListener
+{
+public:
+	virtual ~IMCPListener() = default;
+
+	/** Blocks until a client is waiting or Timeout elapses. */
+	virtual bool WaitForPendingConnection(const FTimespan& Timeout) = 0;
+
+	/** Accepts one waiting client; nullptr once none are left. */
+	virtual TUniquePtr<IMCPStream> Accept() = 0;
+
+	/** "127.0.0.1:55557" or the socket path, for logs. */
+	virtual FString Describe() const = 0;
+};
+
+namespace MCPTransport
+{
+	UNREALMCP_API TUniquePtr<IMCPListener> ListenTcp(const FIPv4Address& Address, uint16 Port);
+
+	/**
+	 * Listens on a Unix domain socket only the editor's user can connect to. The socket's
+	 * directory must belong to that user and be closed to everyone else; a missing one is
+	 * created that way. A stale socket file left by a crashed editor is replaced. Returns
+	 * nullptr on platforms without Unix domain sockets (Windows here) or if the path can't
+	 * be bound.
+	 */
+	UNREALMCP_API TUniquePtr<IMCPListener> ListenUnix(const FString& Path);
+
+	/**
+	 * unreal-mcp-<Port>.sock in $XDG_RUNTIME_DIR, or else in an unreal-mcp-<uid> directory
+	 * under the temp directory. Empty on platforms without Unix domain sockets.
+	 */
+	UNREALMCP_API FString DefaultUnixSocketPath(uint16 Port);
+}
@@ -8,9 +8,16 @@
 #include "Json.h"
 #include "Interfaces/IPv4/IPv4Address.h"
 #include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "MCPMessageFraming.h"
+#include "MCPCommandScheduler.h"
 #include "UnrealMCPBridge.generated.h"
 
+/** Serializes one progress message in whichever encoding the connection uses when it is sent. */
+using FMCPProgressEncoder = TUniqueFunction<TArray<uint8>(EMCPEncoding)>;
+
 class FMCPServerRunnable;
+class IMCPListener;
 class FUnrealMCPActorCommands;
 class FUnrealMCPEditorCommands;
 class FUnrealMCPBlueprintCommands;
@@ -51,9 +58,38 @@ public:
 	// Command execution
 	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+	/**
+	 * Queue a command without blocking the caller. OnComplete receives the response encoded as
+	 * Encoding (with RequestId echoed as "id" when valid) and any binary attachments, on the game thread,
+	 * inline for commands that don't need it, or on whichever thread an asynchronous command
+	 * completes. Game-thread commands go through the scheduler's priority lanes, fairly across
+	 * ClientIds; when their lane is full OnComplete gets a "busy" response right away.
+	 * Streaming commands send partial results to OnProgress ("status": "progress") first,
+	 * when one is given, and subscriptions keep sending them until it returns false. Partial
+	 * results arrive unencoded: the caller runs the encoder with its encoding at send time. A
+	 * null encoder is a liveness probe that sends nothing.
+	 */
+	void ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params,
+	                         const TSharedPtr<FJsonValue>& RequestId, TUniqueFunction<void(TArray<uint8>, TArray<FUnrealMCPAttachment>)> OnComplete,
+	                         TFunction<bool(FMCPProgressEncoder, TArray<FUnrealMCPAttachment>)> OnProgress = nullptr,
+	                         EMCPEncoding Encoding = EMCPEncoding::Json, int32 ClientId = INDEX_NONE);
+
+	// Admission and queue metrics for game-thread commands
+	const FMCPCommandScheduler& GetScheduler() const { return *Scheduler; }
+
+	// Commands that never modify editor or world state. Safe to call from any thread.
+	bool IsReadOnlyCommand(const FString& CommandType) const;
+
 protected:
-	// Handle actor-related commands
-	TSharedPtr<FJsonObject> HandleActorCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	TArray<uint8> ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId,
+	                                     EMCPEncoding Encoding);
+	static TArray<uint8> SerializeResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& ResultJson, const TSharedPtr<FJsonValue>& RequestId,
+	                                       EMCPEncoding Encoding, const TArray<FUnrealMCPAttachment>& Attachments = TArray<FUnrealMCPAttachment>(), bool bProgress = false);
+	static TArray<uint8> SerializeBusyResponse(const TSharedPtr<FJsonValue>& RequestId, EMCPEncoding Encoding, EMCPRequestLane Lane, int32 RetryAfterMs);
+	TSharedPtr<FJsonObject> DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	// Run several commands in one game-thread task
+	TSharedPtr<FJsonObject> HandleBatchCommand(const TSharedPtr<FJsonObject>& Params);
 
 	// Convert an actor to a JSON value
 	TSharedPtr<FJsonValue> ActorToJson(AActor* Actor);
@@ -62,15 +98,16 @@ protected:
 	TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, bool bDetailed = false);
 
 private:
-	// Server state
+	// Server state: one thread per listener, TCP plus a Unix domain socket where supported
 	bool bIsRunning;
-	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ConnectionSocket;
-	FRunnableThread* ServerThread;
+	TArray<FMCPServerRunnable*> Servers;
+	TArray<FRunnableThread*> ServerThreads;
+	bool StartServerThread(TUniquePtr<IMCPListener> Listener, const TCHAR* ThreadName);
 
-	// Server configuration
+	// Server configuration; an empty UnixSocketPath disables that listener
 	FIPv4Address ServerAddress;
 	uint16 Port;
+	FString UnixSocketPath;
 
 	// Command handler instances
 	TSharedPtr<FUnrealMCPActorCommands> ActorCommands;
@@ -79,15 +116,16 @@ private:
 	TSharedPtr<FUnrealMCPBlueprintNodeCommands> BlueprintNodeCommands;
 	TSharedPtr<FUnrealMCPRenderingCommands> RenderingCommands;
 
+	// Bounded priority queues in front of the game thread
+	TSharedPtr<FMCPCommandScheduler, ESPMode::ThreadSafe> Scheduler;
+
+	// Every command the server understands, filled by RegisterCommands()
+	TSharedPtr<FUnrealMCPCommandRegistry> CommandRegistry;
+	void RegisterCommands();
+
 	// Command handlers
 	TSharedPtr<FJsonObject> HandleLevelCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleAssetCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
-	TSharedPtr<FJsonObject> HandleEditorCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
-	TSharedPtr<FJsonObject> HandleBlueprintCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleRenderingCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
-
-    // Blueprint node command handler
-    TSharedPtr<FJsonObject> HandleBlueprintNodeCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
     
     // New command handlers for blueprint property and self reference
     TSharedPtr<FJsonObject> HandleSetBlueprintProperty(const TSharedPtr<FJsonObject>& RequestObj);
@@ -63,7 +63,10 @@ public class UnrealMCP : ModuleRules
 				"EditorStyle",
 				"ToolMenus",
 				"LevelEditor",
-				"HTTP"
+				"HTTP",
+				"ImageWrapper",
+				"RHI",
+				"RenderCore"
 				// ... add private dependencies that you statically link with here ...	
 			}
 		);